@@ -0,0 +1,124 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Physics/Collision/FF_SpatialHash.hxx"
+
+/**
+ * @brief [Micro-benchmark of cloth self-collision broad phase]
+ * @details [Particles are placed on a crumpled SIDE x SIDE grid like in FF::Cloth, the spatial hash is rebuilt
+ *           and queried every step. Time per particle must stay roughly constant while the brute force
+ *           loop grows linearly with particle count]
+ */
+namespace {
+    constexpr float SPACE_BETWEEN_PARTICLES = 0.1f;
+    constexpr float PARTICLE_RADIUS         = 0.045f;
+
+    struct Sheet {
+        std::size_t        m_Side;
+        std::vector<float> m_X;
+        std::vector<float> m_Y;
+        std::vector<float> m_Z;
+    };
+
+    Sheet MakeSheet(std::size_t side){
+        std::mt19937 generator(0x1234u);
+        std::uniform_real_distribution<float> jitter(-SPACE_BETWEEN_PARTICLES, SPACE_BETWEEN_PARTICLES);
+
+        Sheet sheet{ side, {}, {}, {} };
+        for (std::size_t i = 0x0; i < side; i++) {
+            for (std::size_t j = 0x0; j < side; j++) {
+                sheet.m_X.push_back(static_cast<float>(j) * SPACE_BETWEEN_PARTICLES + jitter(generator));
+                sheet.m_Y.push_back(-static_cast<float>(i) * SPACE_BETWEEN_PARTICLES + jitter(generator));
+                sheet.m_Z.push_back(jitter(generator));
+            }
+        }
+
+        return sheet;
+    }
+
+    bool isGridNeighbour(std::size_t side, std::size_t first, std::size_t second){
+        std::size_t rowDifference    = (first / side > second / side) ? (first / side - second / side) : (second / side - first / side);
+        std::size_t columnDifference = (first % side > second % side) ? (first % side - second % side) : (second % side - first % side);
+
+        return (rowDifference <= 0x1 && columnDifference <= 0x1);
+    }
+
+    std::size_t SpatialHashStep(const Sheet& sheet, FF::SpatialHash<float>& hash, std::vector<FF::CollisionPair>& pairs){
+        hash.Clear();
+        for (std::size_t i = 0x0; i < sheet.m_X.size(); i++) {
+            hash.Insert(FF::Vector3<float>(sheet.m_X[i], sheet.m_Y[i], sheet.m_Z[i]), PARTICLE_RADIUS);
+        }
+        hash.Build();
+
+        pairs.clear();
+        hash.QueryPairs(pairs, [&sheet](std::size_t first, std::size_t second) {
+            return isGridNeighbour(sheet.m_Side, first, second);
+        });
+
+        return pairs.size();
+    }
+
+    std::size_t BruteForceStep(const Sheet& sheet){
+        const float minDistanceSquared = FF::sqr(2.0f * PARTICLE_RADIUS);
+        std::size_t totalPairs = 0x0;
+
+        for (std::size_t i = 0x0; i < sheet.m_X.size(); i++) {
+            for (std::size_t j = i + 0x1; j < sheet.m_X.size(); j++) {
+                float distanceSquared = FF::sqr(sheet.m_X[i] - sheet.m_X[j]) +
+                                        FF::sqr(sheet.m_Y[i] - sheet.m_Y[j]) +
+                                        FF::sqr(sheet.m_Z[i] - sheet.m_Z[j]);
+
+                if (distanceSquared < minDistanceSquared && !isGridNeighbour(sheet.m_Side, i, j)) {
+                    totalPairs++;
+                }
+            }
+        }
+
+        return totalPairs;
+    }
+
+    template<typename Step>
+    double MeasureMicroseconds(std::size_t iterations, Step step, std::size_t& result){
+        auto begin = std::chrono::steady_clock::now();
+        for (std::size_t i = 0x0; i < iterations; i++) {
+            result = step();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::micro>(end - begin).count() / static_cast<double>(iterations);
+    }
+};
+
+int main(void){
+    const std::size_t sides[] = { 25, 50, 100, 200, 400 };
+
+    std::printf("%10s %12s %14s %14s %12s %14s\n", "particles", "pairs", "hash us/step", "hash ns/part", "brute pairs", "brute us/step");
+
+    for (std::size_t side : sides) {
+        Sheet sheet = MakeSheet(side);
+        const std::size_t particles = side * side;
+        const std::size_t iterations = (particles < 10000) ? 200 : 20;
+
+        FF::SpatialHash<float> hash(2.0f * PARTICLE_RADIUS, particles);
+        std::vector<FF::CollisionPair> pairs;
+
+        std::size_t hashPairs = 0x0;
+        double hashTime = MeasureMicroseconds(iterations, [&]() { return SpatialHashStep(sheet, hash, pairs); }, hashPairs);
+
+        if (side <= 100) {
+            std::size_t brutePairs = 0x0;
+            double bruteTime = MeasureMicroseconds(side <= 50 ? 20 : 2, [&]() { return BruteForceStep(sheet); }, brutePairs);
+
+            std::printf("%10zu %12zu %14.1f %14.2f %12zu %14.1f\n", particles, hashPairs, hashTime,
+                        1000.0 * hashTime / static_cast<double>(particles), brutePairs, bruteTime);
+        } else {
+            std::printf("%10zu %12zu %14.1f %14.2f %12s %14s\n", particles, hashPairs, hashTime,
+                        1000.0 * hashTime / static_cast<double>(particles), "-", "-");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Core/FF_Profiler.hxx"
+#include "../src/Physics/FF_Cloth.hxx"
+
+/**
+ * @brief [Benchmark of Cloth::Update]
+ * @details [Cloth hangs by two corners and swings under gravity, time of Update() is measured for several
+ *           grid sizes. In the second table gravity is off and particles are a bit larger than half of space
+ *           between every second particle, so contacts push the cloth apart and every particle has about two
+ *           contacts each step. Time per particle must stay roughly constant in both tables. With
+ *           __FF_PROFILE (FF_ENABLE_PROFILING in CMake) every phase of the step is recorded, table shows time
+ *           of each phase and counters per step, and records of each run are written to
+ *           cloth_SCENARIO_SIDE.json (chrome://tracing, Perfetto) and cloth_SCENARIO_SIDE.csv]
+ */
+namespace {
+    constexpr float       PARTICLE_MASS           = 0.1f;
+    constexpr float       PARTICLE_RADIUS         = 0.045f;
+    constexpr float       CONTACT_PARTICLE_RADIUS = 0.105f;
+    constexpr float       SPACE_BETWEEN_PARTICLES = 0.1f;
+    constexpr float       CLOTH_STIFFNESS         = 2000.0f;
+    constexpr float       CLOTH_DAMPENING         = 0.5f;
+    constexpr float       LINEAR_DAMPENING        = 0.001f;
+    constexpr float       GRAVITY                 = 9.81f;
+    constexpr float       STEP                    = 0.001f;
+    constexpr std::size_t WARM_UP_STEP_COUNT      = 10;
+    constexpr std::size_t STEP_COUNT              = 100;
+
+    struct Scenario {
+        const char* m_Name;
+        float       m_ParticleRadius;
+        float       m_Gravity;
+    };
+
+    void PrintProfile(const Scenario& scenario, std::size_t side){
+#ifdef __FF_PROFILE
+        FF::Profiler& profiler = FF::Profiler::Get();
+
+        double updateTime = 0.0;
+        for (const FF::ProfileSummary& entry : profiler.GetSummary()) {
+            if (std::strcmp(entry.m_Name, "Cloth::Update") == 0x0) {
+                updateTime = entry.m_Total;
+            }
+        }
+
+        std::printf("%-26s %10s %12s %10s\n", "phase", "calls/step", "us/step", "% update");
+        for (const FF::ProfileSummary& entry : profiler.GetSummary()) {
+            if (!entry.m_isCounter) {
+                std::printf("%-26s %10.1f %12.2f %9.1f%%\n", entry.m_Name, static_cast<double>(entry.m_Count) / STEP_COUNT,
+                            entry.m_Total / STEP_COUNT, 100.0 * entry.m_Total / updateTime);
+            }
+        }
+
+        std::printf("%-26s %10s %12s %10s\n", "counter", "", "per step", "max");
+        for (const FF::ProfileSummary& entry : profiler.GetSummary()) {
+            if (entry.m_isCounter) {
+                std::printf("%-26s %10s %12.1f %10.0f\n", entry.m_Name, "", entry.m_Total / STEP_COUNT, entry.m_Max);
+            }
+        }
+
+        const std::string name = std::string("cloth_") + scenario.m_Name + "_" + std::to_string(side);
+
+        std::ofstream trace(name + ".json");
+        profiler.WriteChromeTrace(trace);
+
+        std::ofstream csv(name + ".csv");
+        profiler.WriteCSV(csv);
+
+        std::printf("records written to %s.json and %s.csv\n\n", name.c_str(), name.c_str());
+#else
+        (void)scenario;
+        (void)side;
+#endif
+    }
+
+    void Run(const Scenario& scenario, std::size_t side){
+        FF::Cloth<float> cloth( side, side, PARTICLE_MASS, scenario.m_ParticleRadius, 0.2f, SPACE_BETWEEN_PARTICLES,
+                                CLOTH_STIFFNESS, CLOTH_DAMPENING, LINEAR_DAMPENING, FF::Vector3<float>(0.0f, 0.0f, 0.0f) );
+
+        cloth.SetParticleStaticFlag(0x0, 0x0, true);
+        cloth.SetParticleStaticFlag(0x0, side - 0x1, true);
+        for (std::size_t i = 0x0; i < side; i++) {
+            for (std::size_t j = 0x0; j < side; j++) {
+                cloth.SetParticleConstantForce(i, j, FF::Vector3<float>(0.0f, -scenario.m_Gravity * PARTICLE_MASS, 0.0f));
+            }
+        }
+
+        for (std::size_t i = 0x0; i < WARM_UP_STEP_COUNT; i++) {
+            cloth.Update(STEP);
+        }
+
+#ifdef __FF_PROFILE
+        FF::Profiler::Get().Clear();
+#endif
+
+        std::size_t pairs = 0x0;
+
+        auto begin = std::chrono::steady_clock::now();
+        for (std::size_t i = 0x0; i < STEP_COUNT; i++) {
+            cloth.Update(STEP);
+            pairs += cloth.GetCollisionPairs().size();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        const double time      = std::chrono::duration<double, std::micro>(end - begin).count() / STEP_COUNT;
+        const double particles = static_cast<double>(side * side);
+
+        std::printf("%5zux%-5zu %10.0f %10zu %12.1f %12.1f %14.1f\n", side, side, particles, cloth.GetSprings().GetSpringCount(),
+                    static_cast<double>(pairs) / STEP_COUNT, time, 1e3 * time / particles);
+
+        PrintProfile(scenario, side);
+    }
+};
+
+int main(void){
+    const std::size_t sides[] = { 16, 32, 64, 128 };
+
+    const Scenario scenarios[] = { { "free", PARTICLE_RADIUS, GRAVITY }, { "contact", CONTACT_PARTICLE_RADIUS, 0.0f } };
+
+    for (const Scenario& scenario : scenarios) {
+        std::printf("%s: particle radius %.3f, space between particles %.3f\n", scenario.m_Name, scenario.m_ParticleRadius, SPACE_BETWEEN_PARTICLES);
+        for (std::size_t side : sides) {
+            std::printf("%-11s %10s %10s %12s %12s %14s\n", "cloth", "particles", "springs", "pairs/step", "us/step", "ns/particle");
+            Run(scenario, side);
+        }
+        std::printf("\n");
+    }
+
+    return 0;
+}
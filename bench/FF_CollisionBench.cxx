@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Physics/Collision/FF_AABB.hxx"
+#include "../src/Physics/Collision/FF_BoundedSphere.hxx"
+#include "../src/Physics/Collision/FF_Collision.hxx"
+
+/**
+ * @brief [Micro-benchmark of collision tests]
+ * @details [Every test of FF::Collision runs on pairs of random shapes scattered over the world, so like in
+ *           narrow phase after coarse culling most of them miss. Count of hits is printed to check that
+ *           results don't change between runs and to keep the loops alive]
+ */
+namespace {
+    constexpr std::size_t SHAPE_COUNT  = 100000;
+    constexpr std::size_t REPEAT_COUNT = 50;
+    constexpr float       WORLD_SIZE   = 10.0f;
+    constexpr float       MAX_SIZE     = 1.0f;
+
+    using Clock = std::chrono::steady_clock;
+
+    template<typename Function>
+    void Run(const char* name, Function test){
+        std::size_t hits = 0x0;
+
+        auto begin = Clock::now();
+        for (std::size_t r = 0x0; r < REPEAT_COUNT; r++) {
+            hits = 0x0;
+            for (std::size_t i = 0x0; i < SHAPE_COUNT; i++) {
+                hits += test(i) ? 0x1 : 0x0;
+            }
+        }
+        auto end = Clock::now();
+
+        const double time = std::chrono::duration<double, std::nano>(end - begin).count() / (REPEAT_COUNT * SHAPE_COUNT);
+        std::printf("%-24s %10.3f %10zu\n", name, time, hits);
+    }
+};
+
+int main(void){
+    std::mt19937 generator(0x1234u);
+    std::uniform_real_distribution<float> coordinate(0.0f, WORLD_SIZE);
+    std::uniform_real_distribution<float> size(0.1f * MAX_SIZE, MAX_SIZE);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+
+    std::vector<FF::AABB<float>>          boxes;
+    std::vector<FF::BoundedSphere<float>> spheres;
+    std::vector<FF::Vector3<float>>       origins;
+    std::vector<FF::Vector3<float>>       directions;
+    std::vector<FF::Vector3<float>>       invertDirections;
+
+    boxes.reserve(SHAPE_COUNT + 0x1);
+    spheres.reserve(SHAPE_COUNT + 0x1);
+    for (std::size_t i = 0x0; i <= SHAPE_COUNT; i++) {
+        const FF::Vector3<float> corner(coordinate(generator), coordinate(generator), coordinate(generator));
+        const FF::Vector3<float> extent(size(generator), size(generator), size(generator));
+
+        boxes.push_back(FF::AABB<float>(corner, corner + extent));
+        spheres.push_back(FF::BoundedSphere<float>(FF::Vector3<float>(coordinate(generator), coordinate(generator), coordinate(generator)), size(generator)));
+
+        const FF::Vector3<float> direction = FF::Vector3<float>(component(generator), component(generator), component(generator)).Normalize();
+        origins.push_back(FF::Vector3<float>(coordinate(generator), coordinate(generator), coordinate(generator)));
+        directions.push_back(direction);
+        invertDirections.push_back(FF::Vector3<float>( 1.0f / direction.GetXComponent(),
+                                                       1.0f / direction.GetYComponent(),
+                                                       1.0f / direction.GetZComponent() ));
+    }
+
+    const FF::Collision<float> collision;
+
+    std::printf("%zu tests, ns per test\n", SHAPE_COUNT);
+    std::printf("%-24s %10s %10s\n", "test", "ns", "hits");
+
+    Run("AABB - AABB", [&](std::size_t i) {
+        return collision.AABBIntersectAABB(boxes[i], boxes[i + 0x1]);
+    });
+    Run("sphere - sphere", [&](std::size_t i) {
+        return collision.BSphereIntersectBSphere(spheres[i], spheres[i + 0x1]);
+    });
+    Run("sphere - AABB", [&](std::size_t i) {
+        return collision.BSphereIntersectAABB(spheres[i], boxes[i]);
+    });
+    Run("ray - AABB", [&](std::size_t i) {
+        return collision.RayIntersectAABB(origins[i], invertDirections[i], WORLD_SIZE, boxes[i]);
+    });
+    Run("ray - sphere", [&](std::size_t i) {
+        float distance;
+        return collision.RayIntersectBSphere(origins[i], directions[i], spheres[i], distance);
+    });
+
+    return 0;
+}
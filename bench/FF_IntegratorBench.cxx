@@ -0,0 +1,143 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Physics/FF_Cloth.hxx"
+
+/**
+ * @brief [Benchmark of cloth integrators]
+ * @details [Stiff undamped cloth hangs by two corners and swings under gravity for one simulated second.
+ *           Each integrator runs with the base step and with 5x and 10x larger steps. Energy drift is
+ *           the change of kinetic + spring + gravity energy relative to the initial potential energy,
+ *           explicit integrators blow up when step exceeds their stability limit. Second table compares
+ *           100x stiffer cloth solved by symplectic Euler at the step it needs and by XPBD at large steps,
+ *           max strain shows how inextensible cloth is]
+ */
+namespace {
+    constexpr std::size_t SIDE                    = 32;
+    constexpr float       PARTICLE_MASS           = 0.1f;
+    constexpr float       PARTICLE_RADIUS         = 0.02f;
+    constexpr float       SPACE_BETWEEN_PARTICLES = 0.1f;
+    constexpr float       CLOTH_STIFFNESS         = 2000.0f;
+    constexpr float       GRAVITY                 = 9.81f;
+    constexpr float       BASE_STEP               = 0.001f;
+    constexpr float       SIMULATED_TIME          = 1.0f;
+
+    template<typename Integrator>
+    double Energy(FF::Cloth<float, Integrator>& cloth){
+        const FF::ClothState<float>&   state   = cloth.GetState();
+        const FF::ClothSprings<float>& springs = cloth.GetSprings();
+
+        double energy = 0.0;
+        for (std::size_t i = 0x0; i < state.GetParticleCount(); i++) {
+            const double mass = 1.0 / state.m_InvertMass[i];
+
+            energy += 0.5 * mass * (FF::sqr<double>(state.m_VelocityX[i]) + FF::sqr<double>(state.m_VelocityY[i]) + FF::sqr<double>(state.m_VelocityZ[i]));
+            energy -= static_cast<double>(state.m_ConstantForceY[i]) * state.m_LocationY[i];
+        }
+
+        for (std::size_t s = 0x0; s < springs.GetSpringCount(); s++) {
+            const std::uint32_t a = springs.m_First[s];
+            const std::uint32_t b = springs.m_Second[s];
+
+            const double length = std::sqrt(FF::sqr<double>(state.m_LocationX[a] - state.m_LocationX[b]) +
+                                            FF::sqr<double>(state.m_LocationY[a] - state.m_LocationY[b]) +
+                                            FF::sqr<double>(state.m_LocationZ[a] - state.m_LocationZ[b]));
+
+            energy += 0.5 * springs.m_Stiffness[s] * FF::sqr<double>(length - springs.m_RestLength[s]);
+        }
+
+        return energy;
+    }
+
+    template<typename Integrator>
+    double MaxStrain(FF::Cloth<float, Integrator>& cloth){
+        const FF::ClothState<float>&   state   = cloth.GetState();
+        const FF::ClothSprings<float>& springs = cloth.GetSprings();
+
+        double strain = 0.0;
+        for (std::size_t s = 0x0; s < springs.GetSpringCount(); s++) {
+            const std::uint32_t a = springs.m_First[s];
+            const std::uint32_t b = springs.m_Second[s];
+
+            const double length = std::sqrt(FF::sqr<double>(state.m_LocationX[a] - state.m_LocationX[b]) +
+                                            FF::sqr<double>(state.m_LocationY[a] - state.m_LocationY[b]) +
+                                            FF::sqr<double>(state.m_LocationZ[a] - state.m_LocationZ[b]));
+
+            strain = FF::max(strain, std::fabs(length - springs.m_RestLength[s]) / springs.m_RestLength[s]);
+        }
+
+        return strain;
+    }
+
+    template<typename Integrator>
+    void Configure(Integrator&, std::size_t){}
+
+    void Configure(FF::XPBD<float>& integrator, std::size_t iterations){
+        integrator.SetIterationCount(iterations);
+    }
+
+    template<typename Integrator>
+    void Run(const char* name, float changeInTime, float stiffness = CLOTH_STIFFNESS, std::size_t iterations = 0x8){
+        FF::Cloth<float, Integrator> cloth( SIDE, SIDE, PARTICLE_MASS, PARTICLE_RADIUS, 0.2f, SPACE_BETWEEN_PARTICLES,
+                                            stiffness, 0.0f, 0.0f, FF::Vector3<float>(0.0f, 0.0f, 0.0f) );
+        Configure(cloth.GetIntegrator(), iterations);
+
+        cloth.SetParticleStaticFlag(0x0, 0x0, true);
+        cloth.SetParticleStaticFlag(0x0, SIDE - 0x1, true);
+        for (std::size_t i = 0x0; i < SIDE; i++) {
+            for (std::size_t j = 0x0; j < SIDE; j++) {
+                cloth.SetParticleConstantForce(i, j, FF::Vector3<float>(0.0f, -GRAVITY * PARTICLE_MASS, 0.0f));
+            }
+        }
+
+        const double      startEnergy = Energy(cloth);
+        const std::size_t steps       = static_cast<std::size_t>(SIMULATED_TIME / changeInTime + 0.5f);
+
+        auto begin = std::chrono::steady_clock::now();
+        for (std::size_t i = 0x0; i < steps; i++) {
+            cloth.Update(changeInTime);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        const double time   = std::chrono::duration<double, std::milli>(end - begin).count() / SIMULATED_TIME;
+        const double energy = Energy(cloth);
+        const double drift  = (energy - startEnergy) / std::fabs(startEnergy);
+
+        if (std::isfinite(energy)) {
+            std::printf("%-16s %10.4f %8zu %16.2f %+14.2e %12.2e\n", name, changeInTime, steps, time, drift, MaxStrain(cloth));
+        } else {
+            std::printf("%-16s %10.4f %8zu %16.2f %14s %12s\n", name, changeInTime, steps, time, "unstable", "-");
+        }
+    }
+};
+
+int main(void){
+    const float multipliers[] = { 1.0f, 5.0f, 10.0f };
+
+    std::printf("%zux%zu cloth, stiffness %.0f, %.1f s simulated\n", SIDE, SIDE, CLOTH_STIFFNESS, SIMULATED_TIME);
+    std::printf("%-16s %10s %8s %16s %14s %12s\n", "integrator", "step", "steps", "ms/simulated s", "energy drift", "max strain");
+
+    for (float multiplier : multipliers) {
+        const float changeInTime = BASE_STEP * multiplier;
+
+        Run<FF::SymplecticEuler<float>>("symplectic euler", changeInTime);
+        Run<FF::PositionVerlet<float>>("position verlet", changeInTime);
+        Run<FF::RungeKutta4<float>>("runge-kutta 4", changeInTime);
+        Run<FF::BackwardEuler<float>>("backward euler", changeInTime);
+        Run<FF::XPBD<float>>("xpbd", changeInTime);
+    }
+
+    const float stiffness = 100.0f * CLOTH_STIFFNESS;
+
+    std::printf("\n%zux%zu cloth, stiffness %.0f, %.1f s simulated\n", SIDE, SIDE, stiffness, SIMULATED_TIME);
+    std::printf("%-16s %10s %8s %16s %14s %12s\n", "solver", "step", "steps", "ms/simulated s", "energy drift", "max strain");
+
+    Run<FF::SymplecticEuler<float>>("symplectic euler", BASE_STEP / 10.0f, stiffness);
+    Run<FF::XPBD<float>>("xpbd 8 iter", BASE_STEP * 5.0f, stiffness, 0x8);
+    Run<FF::XPBD<float>>("xpbd 32 iter", BASE_STEP * 5.0f, stiffness, 0x20);
+    Run<FF::XPBD<float>>("xpbd 32 iter", BASE_STEP * 10.0f, stiffness, 0x20);
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Core/FF_Vector4.hxx"
+#include "../src/Core/FF_Matrix3x3.hxx"
+#include "../src/Core/FF_Matrix4x4.hxx"
+#include "../src/Core/FF_AlignedAllocator.hxx"
+#include "../src/Core/FF_VectorBatch.hxx"
+
+/**
+ * @brief [Micro-benchmark of vector and matrix operations]
+ * @details [Vector3 operators and functions are timed on arrays of objects, the same operations of
+ *           VectorBatch on arrays of components. Matrix products are timed per object. Checksum of
+ *           every result is printed, so the compiler can't drop the loops]
+ */
+namespace {
+    constexpr std::size_t VECTOR_COUNT = 100000;
+    constexpr std::size_t MATRIX_COUNT = 10000;
+    constexpr std::size_t REPEAT_COUNT = 100;
+
+    using Clock = std::chrono::steady_clock;
+
+    template<typename Function>
+    double Measure(Function function){
+        auto begin = Clock::now();
+        for (std::size_t i = 0x0; i < REPEAT_COUNT; i++) {
+            function();
+        }
+        auto end = Clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - begin).count() / REPEAT_COUNT;
+    }
+
+    template<typename Container>
+    double Checksum(const Container& values, std::size_t count){
+        double sum = 0.0;
+        for (std::size_t i = 0x0; i < count; i++) {
+            sum += values[i];
+        }
+
+        return sum;
+    }
+
+    void Report(const char* name, double time, std::size_t count, double baseline, double checksum){
+        std::printf("%-28s %12.3f %10.2fx %16.6e\n", name, time / count, baseline / time, checksum);
+    }
+
+    void RunVectors(void){
+        std::mt19937 generator(0x1234u);
+        std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+
+        std::vector<FF::Vector3<float>> a, b, out;
+        a.reserve(VECTOR_COUNT);
+        b.reserve(VECTOR_COUNT);
+        out.reserve(VECTOR_COUNT);
+
+        FF::AlignedVector<float> ax(VECTOR_COUNT), ay(VECTOR_COUNT), az(VECTOR_COUNT);
+        FF::AlignedVector<float> bx(VECTOR_COUNT), by(VECTOR_COUNT), bz(VECTOR_COUNT);
+        FF::AlignedVector<float> ox(VECTOR_COUNT), oy(VECTOR_COUNT), oz(VECTOR_COUNT);
+        std::vector<float>       scalar(VECTOR_COUNT);
+
+        for (std::size_t i = 0x0; i < VECTOR_COUNT; i++) {
+            ax[i] = coordinate(generator); ay[i] = coordinate(generator); az[i] = coordinate(generator);
+            bx[i] = coordinate(generator); by[i] = coordinate(generator); bz[i] = coordinate(generator);
+
+            a.push_back(FF::Vector3<float>(ax[i], ay[i], az[i]));
+            b.push_back(FF::Vector3<float>(bx[i], by[i], bz[i]));
+            out.push_back(FF::Vector3<float>(0.0f, 0.0f, 0.0f));
+        }
+
+        auto sumX = [&out]() {
+            double sum = 0.0;
+            for (const FF::Vector3<float>& vec : out) {
+                sum += vec.GetXComponent();
+            }
+
+            return sum;
+        };
+
+        std::printf("%zu vectors, ns per vector\n", VECTOR_COUNT);
+        std::printf("%-28s %12s %11s %16s\n", "operation", "ns", "speedup", "checksum");
+
+        const double subtract = Measure([&]() {
+            for (std::size_t i = 0x0; i < VECTOR_COUNT; i++) {
+                out[i] = a[i] - b[i];
+            }
+        });
+        Report("Vector3 a - b", subtract, VECTOR_COUNT, subtract, sumX());
+
+        const double batchSubtract = Measure([&]() {
+            FF::VectorBatch<float>::Subtract(ax.data(), ay.data(), az.data(), bx.data(), by.data(), bz.data(), ox.data(), oy.data(), oz.data(), VECTOR_COUNT);
+        });
+        Report("VectorBatch::Subtract", batchSubtract, VECTOR_COUNT, subtract, Checksum(ox, VECTOR_COUNT));
+
+        const double dot = Measure([&]() {
+            for (std::size_t i = 0x0; i < VECTOR_COUNT; i++) {
+                scalar[i] = FF::DotProduct(a[i], b[i]);
+            }
+        });
+        Report("DotProduct(a, b)", dot, VECTOR_COUNT, dot, Checksum(scalar, VECTOR_COUNT));
+
+        const double batchDot = Measure([&]() {
+            FF::VectorBatch<float>::DotProduct(ax.data(), ay.data(), az.data(), bx.data(), by.data(), bz.data(), scalar.data(), VECTOR_COUNT);
+        });
+        Report("VectorBatch::DotProduct", batchDot, VECTOR_COUNT, dot, Checksum(scalar, VECTOR_COUNT));
+
+        const double magnitude = Measure([&]() {
+            for (std::size_t i = 0x0; i < VECTOR_COUNT; i++) {
+                scalar[i] = a[i].Magnitude();
+            }
+        });
+        Report("Vector3::Magnitude", magnitude, VECTOR_COUNT, magnitude, Checksum(scalar, VECTOR_COUNT));
+
+        const double batchMagnitude = Measure([&]() {
+            FF::VectorBatch<float>::Magnitude(ax.data(), ay.data(), az.data(), scalar.data(), VECTOR_COUNT);
+        });
+        Report("VectorBatch::Magnitude", batchMagnitude, VECTOR_COUNT, magnitude, Checksum(scalar, VECTOR_COUNT));
+
+        const double normalize = Measure([&]() {
+            for (std::size_t i = 0x0; i < VECTOR_COUNT; i++) {
+                out[i] = a[i].Normalize();
+            }
+        });
+        Report("Vector3::Normalize", normalize, VECTOR_COUNT, normalize, sumX());
+
+        const double batchNormalize = Measure([&]() {
+            FF::VectorBatch<float>::Normalize(ax.data(), ay.data(), az.data(), ox.data(), oy.data(), oz.data(), VECTOR_COUNT);
+        });
+        Report("VectorBatch::Normalize", batchNormalize, VECTOR_COUNT, normalize, Checksum(ox, VECTOR_COUNT));
+
+        const double cross = Measure([&]() {
+            for (std::size_t i = 0x0; i < VECTOR_COUNT; i++) {
+                out[i] = FF::CrossProduct(a[i], b[i]);
+            }
+        });
+        Report("CrossProduct(a, b)", cross, VECTOR_COUNT, cross, sumX());
+    }
+
+    void RunMatrices(void){
+        std::mt19937 generator(0x4321u);
+        std::uniform_real_distribution<float> element(-1.0f, 1.0f);
+
+        std::vector<FF::Matrix3x3<float>> matrices3x3;
+        std::vector<FF::Matrix4x4<float>> matrices4x4;
+        std::vector<FF::Vector3<float>>   vectors;
+        matrices3x3.reserve(MATRIX_COUNT);
+        matrices4x4.reserve(MATRIX_COUNT);
+        vectors.reserve(MATRIX_COUNT);
+
+        for (std::size_t i = 0x0; i < MATRIX_COUNT; i++) {
+            matrices3x3.push_back(FF::Matrix3x3<float>( element(generator), element(generator), element(generator),
+                                                        element(generator), element(generator), element(generator),
+                                                        element(generator), element(generator), element(generator) ));
+            matrices4x4.push_back(FF::Matrix4x4<float>( element(generator), element(generator), element(generator), element(generator),
+                                                        element(generator), element(generator), element(generator), element(generator),
+                                                        element(generator), element(generator), element(generator), element(generator),
+                                                        0.0f,               0.0f,               0.0f,               1.0f ));
+            vectors.push_back(FF::Vector3<float>(element(generator), element(generator), element(generator)));
+        }
+
+        std::vector<float> result(MATRIX_COUNT);
+
+        std::printf("\n%zu matrices, ns per product\n", MATRIX_COUNT);
+        std::printf("%-28s %12s %11s %16s\n", "operation", "ns", "speedup", "checksum");
+
+        const double matrix3Vector = Measure([&]() {
+            for (std::size_t i = 0x0; i < MATRIX_COUNT; i++) {
+                const FF::Vector3<float> product = matrices3x3[i] * vectors[i];
+                result[i] = product.GetXComponent();
+            }
+        });
+        Report("Matrix3x3 * Vector3", matrix3Vector, MATRIX_COUNT, matrix3Vector, Checksum(result, MATRIX_COUNT));
+
+        const double matrix3Matrix = Measure([&]() {
+            for (std::size_t i = 0x0; i + 0x1 < MATRIX_COUNT; i++) {
+                const FF::Matrix3x3<float> product = matrices3x3[i] * matrices3x3[i + 0x1];
+                result[i] = product(0x0, 0x0);
+            }
+        });
+        Report("Matrix3x3 * Matrix3x3", matrix3Matrix, MATRIX_COUNT, matrix3Vector, Checksum(result, MATRIX_COUNT - 0x1));
+
+        const double matrix4Vector = Measure([&]() {
+            for (std::size_t i = 0x0; i < MATRIX_COUNT; i++) {
+                const FF::Vector4<float> product = matrices4x4[i] * FF::Vector4<float>(vectors[i].GetXComponent(), vectors[i].GetYComponent(), vectors[i].GetZComponent(), 1.0f);
+                result[i] = product.GetXComponent();
+            }
+        });
+        Report("Matrix4x4 * Vector4", matrix4Vector, MATRIX_COUNT, matrix3Vector, Checksum(result, MATRIX_COUNT));
+
+        const double matrix4Matrix = Measure([&]() {
+            for (std::size_t i = 0x0; i + 0x1 < MATRIX_COUNT; i++) {
+                const FF::Matrix4x4<float> product = matrices4x4[i] * matrices4x4[i + 0x1];
+                result[i] = product(0x0, 0x3);
+            }
+        });
+        Report("Matrix4x4 * Matrix4x4", matrix4Matrix, MATRIX_COUNT, matrix3Vector, Checksum(result, MATRIX_COUNT - 0x1));
+    }
+};
+
+int main(void){
+    RunVectors();
+    RunMatrices();
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Physics/FF_PhysicsWorld.hxx"
+
+/**
+ * @brief [Benchmark of rigid body world broad phase]
+ * @details [About 50k bodies are placed on a jittered grid without touching and only a part of them moves. Resting bodies fall
+ *           asleep during warm up, then time of Step() must follow the count of moving bodies, not the count
+ *           of all bodies. Ray casts and sphere queries are compared with linear loops over all bodies]
+ */
+namespace {
+    constexpr std::size_t SIDE           = 37;
+    constexpr float       SPACING        = 1.0f;
+    constexpr float       RADIUS         = 0.4f;
+    constexpr float       MAX_SPEED      = 2.0f;
+    constexpr float       STEP           = 0.01f;
+    constexpr std::size_t STEP_COUNT     = 100;
+    constexpr std::size_t QUERY_COUNT    = 1000;
+    constexpr float       QUERY_RADIUS   = 2.0f;
+
+    using World = FF::PhysicsWorld<float>;
+
+    void Fill(World& world, std::vector<World::BodyHandle>& bodies, float movingFraction){
+        std::mt19937 generator(0x1234u);
+        std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+        std::uniform_real_distribution<float> speed(-MAX_SPEED, MAX_SPEED);
+        std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+        for (std::size_t i = 0x0; i < SIDE; i++) {
+            for (std::size_t j = 0x0; j < SIDE; j++) {
+                for (std::size_t k = 0x0; k < SIDE; k++) {
+                    const FF::Vector3<float> location( static_cast<float>(i) * SPACING + jitter(generator),
+                                                       static_cast<float>(j) * SPACING + jitter(generator),
+                                                       static_cast<float>(k) * SPACING + jitter(generator) );
+
+                    const World::BodyHandle body = world.CreateBody(1.0f, location, RADIUS);
+                    if (chance(generator) < movingFraction) {
+                        world.GetBody(body).SetLinearVelocity(FF::Vector3<float>(speed(generator), speed(generator), speed(generator)));
+                    }
+
+                    bodies.push_back(body);
+                }
+            }
+        }
+    }
+
+    void RunSteps(float movingFraction, float sleepVelocity){
+        World                          world;
+        std::vector<World::BodyHandle> bodies;
+        world.SetSleepVelocity(sleepVelocity);
+        Fill(world, bodies, movingFraction);
+
+        for (std::size_t i = 0x0; i <= world.GetSleepStepCount(); i++) {
+            world.Step(STEP);
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        for (std::size_t i = 0x0; i < STEP_COUNT; i++) {
+            world.Step(STEP);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        std::printf("%8zu %9.1f%% %8s %8zu %12.3f %10zu %8d\n", world.GetBodyCount(), movingFraction * 100.0f,
+                    (sleepVelocity > 0.0f) ? "on" : "off", world.GetAwakeBodyCount(),
+                    std::chrono::duration<double, std::milli>(end - begin).count() / STEP_COUNT,
+                    world.GetContactPairs().size(), world.GetBroadPhase().GetHeight());
+    }
+
+    void RunQueries(void){
+        World                          world;
+        std::vector<World::BodyHandle> bodies;
+        Fill(world, bodies, 0.0f);
+
+        std::mt19937 generator(0x4321u);
+        std::uniform_real_distribution<float> coordinate(0.0f, static_cast<float>(SIDE) * SPACING);
+        std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+
+        std::vector<FF::Vector3<float>> origins;
+        std::vector<FF::Vector3<float>> directions;
+        for (std::size_t i = 0x0; i < QUERY_COUNT; i++) {
+            origins.push_back(FF::Vector3<float>(coordinate(generator), coordinate(generator), coordinate(generator)));
+
+            const FF::Vector3<float> direction(component(generator), component(generator), component(generator));
+            directions.push_back(direction.Normalize());
+        }
+
+        const FF::Collision<float> collision;
+        const float                maxDistance = static_cast<float>(SIDE) * SPACING;
+
+        // Closest ray hit
+        std::size_t treeHits = 0x0;
+        auto begin = std::chrono::steady_clock::now();
+        for (std::size_t q = 0x0; q < QUERY_COUNT; q++) {
+            World::RayCastHit hit{ 0x0, 0.0f };
+            treeHits += world.RayCast(origins[q], directions[q], maxDistance, hit) ? 0x1 : 0x0;
+        }
+        auto end = std::chrono::steady_clock::now();
+        const double treeRay = std::chrono::duration<double, std::micro>(end - begin).count() / QUERY_COUNT;
+
+        std::size_t linearHits = 0x0;
+        begin = std::chrono::steady_clock::now();
+        for (std::size_t q = 0x0; q < QUERY_COUNT; q++) {
+            float closest = maxDistance;
+            bool  isHit   = false;
+            for (World::BodyHandle body : bodies) {
+                float distance;
+                if (collision.RayIntersectBSphere(origins[q], directions[q], FF::BoundedSphere<float>(world.GetBody(body).GetLocation(), RADIUS), distance) &&
+                        distance <= closest) {
+                    closest = distance;
+                    isHit   = true;
+                }
+            }
+            linearHits += isHit ? 0x1 : 0x0;
+        }
+        end = std::chrono::steady_clock::now();
+        const double linearRay = std::chrono::duration<double, std::micro>(end - begin).count() / QUERY_COUNT;
+
+        // Sphere overlap
+        std::size_t treeFound = 0x0;
+        begin = std::chrono::steady_clock::now();
+        for (std::size_t q = 0x0; q < QUERY_COUNT; q++) {
+            world.QuerySphere(FF::BoundedSphere<float>(origins[q], QUERY_RADIUS), [&treeFound](World::BodyHandle) {
+                treeFound++;
+                return true;
+            });
+        }
+        end = std::chrono::steady_clock::now();
+        const double treeSphere = std::chrono::duration<double, std::micro>(end - begin).count() / QUERY_COUNT;
+
+        std::size_t linearFound = 0x0;
+        begin = std::chrono::steady_clock::now();
+        for (std::size_t q = 0x0; q < QUERY_COUNT; q++) {
+            const FF::BoundedSphere<float> sphere(origins[q], QUERY_RADIUS);
+            for (World::BodyHandle body : bodies) {
+                if (collision.BSphereIntersectBSphere(FF::BoundedSphere<float>(world.GetBody(body).GetLocation(), RADIUS), sphere)) {
+                    linearFound++;
+                }
+            }
+        }
+        end = std::chrono::steady_clock::now();
+        const double linearSphere = std::chrono::duration<double, std::micro>(end - begin).count() / QUERY_COUNT;
+
+        std::printf("%-14s %14.2f %14.2f %8zu %8zu\n", "ray cast", treeRay, linearRay, treeHits, linearHits);
+        std::printf("%-14s %14.2f %14.2f %8zu %8zu\n", "sphere query", treeSphere, linearSphere, treeFound, linearFound);
+    }
+};
+
+int main(void){
+    const float fractions[] = { 0.001f, 0.01f, 0.1f, 1.0f };
+
+    std::printf("%8s %10s %8s %8s %12s %10s %8s\n", "bodies", "moving", "sleep", "awake", "ms/step", "pairs", "height");
+    for (float fraction : fractions) {
+        RunSteps(fraction, 0.0f);
+        RunSteps(fraction, 0.01f);
+    }
+
+    std::printf("\n%-14s %14s %14s %8s %8s\n", "query", "tree us/query", "linear us/q", "tree", "linear");
+    RunQueries();
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Core/FF_AlignedAllocator.hxx"
+#include "../src/Physics/FF_MaterialPointBase.hxx"
+#include "../src/Physics/FF_Spring.hxx"
+#include "../src/Physics/FF_SpringBatch.hxx"
+#include "../src/Physics/FF_Cloth.hxx"
+
+/**
+ * @brief [Micro-benchmark of spring forces]
+ * @details [Springs of SIDE x SIDE cloth are evaluated by Spring::CalculateReactions on material points,
+ *           by scalar and SIMD SpringBatch kernels without scatter and by ClothSprings::CalculateReactions,
+ *           which scatter forces to particles as FF::Cloth does. Cloth is stretched by 10%, so every spring
+ *           is displaced. Spring uses its own force model, so only times are compared]
+ */
+namespace {
+    constexpr float       PARTICLE_MASS           = 0.1f;
+    constexpr float       PARTICLE_RADIUS         = 0.02f;
+    constexpr float       SPACE_BETWEEN_PARTICLES = 0.1f;
+    constexpr float       CLOTH_STIFFNESS         = 2000.0f;
+    constexpr float       CLOTH_DAMPENING         = 0.5f;
+    constexpr float       STRETCH                 = 1.1f;
+    constexpr float       STEP                    = 0.001f;
+    constexpr std::size_t SPRING_EVALUATIONS      = 20000000;
+
+    using Clock = std::chrono::steady_clock;
+
+    template<typename Function>
+    double Measure(std::size_t springCount, Function function){
+        const std::size_t repeatCount = FF::max<std::size_t>(SPRING_EVALUATIONS / springCount, 0x1);
+
+        auto begin = Clock::now();
+        for (std::size_t i = 0x0; i < repeatCount; i++) {
+            function();
+        }
+        auto end = Clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - begin).count() / (repeatCount * springCount);
+    }
+
+    void Run(std::size_t side){
+        FF::Cloth<float> cloth( side, side, PARTICLE_MASS, PARTICLE_RADIUS, 0.2f, SPACE_BETWEEN_PARTICLES,
+                                CLOTH_STIFFNESS, CLOTH_DAMPENING, 0.0f, FF::Vector3<float>(0.0f, 0.0f, 0.0f) );
+
+        FF::ClothState<float>          state   = cloth.GetState();
+        const FF::ClothSprings<float>& springs = cloth.GetSprings();
+        const std::size_t              count   = springs.GetSpringCount();
+
+        for (std::size_t i = 0x0; i < state.GetParticleCount(); i++) {
+            state.m_LocationX[i] *= STRETCH;
+            state.m_LocationY[i] *= STRETCH;
+            state.m_LocationZ[i] *= STRETCH;
+        }
+
+        // Material points and springs between them, one object per particle and per spring
+        std::deque<FF::MaterialPointBase<float>> points;
+        for (std::size_t i = 0x0; i < state.GetParticleCount(); i++) {
+            points.emplace_back(PARTICLE_MASS, 0.2f, PARTICLE_RADIUS, state.GetLocation(i));
+        }
+
+        std::vector<FF::Spring<float>> objectSprings;
+        objectSprings.reserve(count);
+        for (std::size_t s = 0x0; s < count; s++) {
+            objectSprings.emplace_back( springs.m_RestLength[s], springs.m_Stiffness[s], springs.m_Dampening[s],
+                                        points[springs.m_First[s]], points[springs.m_Second[s]] );
+        }
+
+        const double objectTime = Measure(count, [&]() {
+            for (FF::Spring<float>& spring : objectSprings) {
+                spring.CalculateReactions(STEP);
+            }
+        });
+
+        FF::AlignedVector<float> fx(count), fy(count), fz(count);
+
+        const double scalarTime = Measure(count, [&]() {
+            FF::ScalarSpringBatch<float>::CalculateForces( state.m_LocationX.data(), state.m_LocationY.data(), state.m_LocationZ.data(),
+                                                           state.m_VelocityX.data(), state.m_VelocityY.data(), state.m_VelocityZ.data(),
+                                                           springs.m_First.data(), springs.m_Second.data(),
+                                                           springs.m_RestLength.data(), springs.m_Stiffness.data(), springs.m_Dampening.data(),
+                                                           fx.data(), fy.data(), fz.data(),
+                                                           count );
+        });
+
+        const double batchTime = Measure(count, [&]() {
+            FF::SpringBatch<float>::CalculateForces( state.m_LocationX.data(), state.m_LocationY.data(), state.m_LocationZ.data(),
+                                                     state.m_VelocityX.data(), state.m_VelocityY.data(), state.m_VelocityZ.data(),
+                                                     springs.m_First.data(), springs.m_Second.data(),
+                                                     springs.m_RestLength.data(), springs.m_Stiffness.data(), springs.m_Dampening.data(),
+                                                     fx.data(), fy.data(), fz.data(),
+                                                     count );
+        });
+
+        const double clothTime = Measure(count, [&]() {
+            springs.CalculateReactions(state, 0x0, count);
+        });
+
+        std::printf("%5zux%-5zu %9zu %14.3f %14.3f %14.3f %14.3f\n", side, side, count, objectTime, scalarTime, batchTime, clothTime);
+    }
+};
+
+int main(void){
+    const std::size_t sides[] = { 16, 32, 64, 128, 256 };
+
+    std::printf("ns per spring\n");
+    std::printf("%-11s %9s %14s %14s %14s %14s\n", "cloth", "springs", "Spring", "scalar batch", "simd batch", "ClothSprings");
+    for (std::size_t side : sides) {
+        Run(side);
+    }
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Core/FF_Vector4.hxx"
+#include "../src/Core/FF_Matrix3x3.hxx"
+#include "../src/Core/FF_Matrix4x4.hxx"
+#include "../src/Core/FF_Quaternion.hxx"
+#include "../src/Core/FF_AlignedAllocator.hxx"
+#include "../src/Core/FF_TransformBatch.hxx"
+#include "../src/Physics/FF_RigidBody.hxx"
+
+/**
+ * @brief [Benchmark of batched transforms]
+ * @details [World matrices of rigid bodies are built per object through Quaternion::GetRotationMatrix() and
+ *           Matrix4x4 constructor, and by TransformBatch from arrays of locations and quaternions. Points are
+ *           transformed per object as Matrix4x4 * Vector4 and by TransformBatch. Results are compared with
+ *           the per-object path, SIMD and scalar kernels must match bit to bit]
+ */
+namespace {
+    constexpr std::size_t BODY_COUNT   = 50000;
+    constexpr std::size_t POINT_COUNT  = 100000;
+    constexpr std::size_t REPEAT_COUNT = 100;
+
+    using Body = FF::RigidBody<float>;
+    using Clock = std::chrono::steady_clock;
+
+    template<typename Function>
+    double Measure(Function function){
+        auto begin = Clock::now();
+        for (std::size_t i = 0x0; i < REPEAT_COUNT; i++) {
+            function();
+        }
+        auto end = Clock::now();
+
+        return std::chrono::duration<double, std::micro>(end - begin).count() / REPEAT_COUNT;
+    }
+
+    float MaxDifference(const float* a, const float* b, std::size_t count){
+        float difference = 0.0f;
+        for (std::size_t i = 0x0; i < count; i++) {
+            difference = FF::max(difference, std::fabs(a[i] - b[i]));
+        }
+
+        return difference;
+    }
+
+    void Report(const char* name, double time, double baseline, float difference){
+        std::printf("%-28s %12.1f %10.2fx %14.3e\n", name, time, baseline / time, difference);
+    }
+
+    std::vector<Body> MakeBodies(void){
+        std::mt19937 generator(0x1234u);
+        std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+        std::normal_distribution<float>       component(0.0f, 1.0f);
+
+        std::vector<Body> bodies;
+        bodies.reserve(BODY_COUNT);
+        for (std::size_t i = 0x0; i < BODY_COUNT; i++) {
+            const float x = component(generator);
+            const float y = component(generator);
+            const float z = component(generator);
+            const float w = component(generator);
+            const float invertLength = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+
+            bodies.emplace_back(1.0f, FF::Vector3<float>(coordinate(generator), coordinate(generator), coordinate(generator)));
+            bodies.back().SetOrientation(FF::Quaternion<float>(x * invertLength, y * invertLength, z * invertLength, w * invertLength));
+        }
+
+        return bodies;
+    }
+
+    void RunMatrices(const std::vector<Body>& bodies){
+        // Per object: MAT3 of quaternion, then MAT4 with location
+        std::vector<FF::Matrix4x4<float>> objectMatrices;
+        objectMatrices.reserve(BODY_COUNT);
+
+        const double objectTime = Measure([&]() {
+            objectMatrices.clear();
+            for (std::size_t i = 0x0; i < BODY_COUNT; i++) {
+                FF::Matrix3x3<float>     rotation = bodies[i].GetOrientation().GetRotationMatrix();
+                const FF::Vector3<float> location = bodies[i].GetLocation();
+
+                objectMatrices.push_back(FF::Matrix4x4<float>( rotation(0x0, 0x0), rotation(0x0, 0x1), rotation(0x0, 0x2), location.GetXComponent(),
+                                                               rotation(0x1, 0x0), rotation(0x1, 0x1), rotation(0x1, 0x2), location.GetYComponent(),
+                                                               rotation(0x2, 0x0), rotation(0x2, 0x1), rotation(0x2, 0x2), location.GetZComponent(),
+                                                               0.0f,               0.0f,               0.0f,               1.0f ));
+            }
+        });
+
+        std::vector<float> expected(BODY_COUNT * 0x10);
+        for (std::size_t i = 0x0; i < BODY_COUNT; i++) {
+            for (std::size_t k = 0x0; k < 0x10; k++) {
+                expected[i * 0x10 + k] = objectMatrices[i](k / 0x4, k % 0x4);
+            }
+        }
+
+        FF::AlignedVector<float> qx(BODY_COUNT), qy(BODY_COUNT), qz(BODY_COUNT), qw(BODY_COUNT);
+        FF::AlignedVector<float> px(BODY_COUNT), py(BODY_COUNT), pz(BODY_COUNT);
+        FF::AlignedVector<float> matrices4x4(BODY_COUNT * 0x10);
+        FF::AlignedVector<float> matrices3x4(BODY_COUNT * 0xC);
+
+        auto gather = [&]() {
+            for (std::size_t i = 0x0; i < BODY_COUNT; i++) {
+                const FF::Quaternion<float> orientation = bodies[i].GetOrientation();
+                const FF::Vector3<float>    location    = bodies[i].GetLocation();
+
+                qx[i] = orientation.GetXComponent(); qy[i] = orientation.GetYComponent();
+                qz[i] = orientation.GetZComponent(); qw[i] = orientation.GetWComponent();
+                px[i] = location.GetXComponent();    py[i] = location.GetYComponent();    pz[i] = location.GetZComponent();
+            }
+        };
+
+        const double gatherTime = Measure(gather);
+
+        const double scalarTime = Measure([&]() {
+            FF::ScalarTransformBatch<float>::BuildMatrices4x4(qx.data(), qy.data(), qz.data(), qw.data(), px.data(), py.data(), pz.data(), matrices4x4.data(), BODY_COUNT);
+        });
+        const float scalarDifference = MaxDifference(matrices4x4.data(), expected.data(), expected.size());
+
+        const double batchTime = Measure([&]() {
+            FF::TransformBatch<float>::BuildMatrices4x4(qx.data(), qy.data(), qz.data(), qw.data(), px.data(), py.data(), pz.data(), matrices4x4.data(), BODY_COUNT);
+        });
+        const float batchDifference = MaxDifference(matrices4x4.data(), expected.data(), expected.size());
+
+        const double batch3x4Time = Measure([&]() {
+            FF::TransformBatch<float>::BuildMatrices3x4(qx.data(), qy.data(), qz.data(), qw.data(), px.data(), py.data(), pz.data(), matrices3x4.data(), BODY_COUNT);
+        });
+        float batch3x4Difference = 0.0f;
+        for (std::size_t i = 0x0; i < BODY_COUNT; i++) {
+            batch3x4Difference = FF::max(batch3x4Difference, MaxDifference(matrices3x4.data() + i * 0xC, expected.data() + i * 0x10, 0xC));
+        }
+
+        std::printf("%zu world matrices, us per frame\n", BODY_COUNT);
+        std::printf("%-28s %12s %11s %14s\n", "path", "us", "speedup", "max diff");
+        Report("per object Matrix4x4", objectTime, objectTime, 0.0f);
+        Report("gather from bodies", gatherTime, objectTime, 0.0f);
+        Report("scalar batch 4x4", scalarTime, objectTime, scalarDifference);
+        Report("simd batch 4x4", batchTime, objectTime, batchDifference);
+        Report("simd batch 3x4", batch3x4Time, objectTime, batch3x4Difference);
+        Report("gather + simd batch 4x4", gatherTime + batchTime, objectTime, batchDifference);
+    }
+
+    void RunPoints(void){
+        std::mt19937 generator(0x4321u);
+        std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+
+        FF::AlignedVector<float> x(POINT_COUNT), y(POINT_COUNT), z(POINT_COUNT), w(POINT_COUNT);
+        for (std::size_t i = 0x0; i < POINT_COUNT; i++) {
+            x[i] = coordinate(generator);
+            y[i] = coordinate(generator);
+            z[i] = coordinate(generator);
+            w[i] = 1.0f;
+        }
+
+        float matrix[0x10];
+        FF::ScalarTransformBatch<float>::RigidTransform(0.2f, -0.4f, 0.1f, std::sqrt(1.0f - 0.21f), 1.0f, 2.0f, 3.0f, matrix, 0x4);
+
+        const FF::Matrix4x4<float> objectMatrix( matrix[0x0], matrix[0x1], matrix[0x2], matrix[0x3],
+                                                 matrix[0x4], matrix[0x5], matrix[0x6], matrix[0x7],
+                                                 matrix[0x8], matrix[0x9], matrix[0xA], matrix[0xB],
+                                                 matrix[0xC], matrix[0xD], matrix[0xE], matrix[0xF] );
+
+        FF::AlignedVector<float> ex(POINT_COUNT), ey(POINT_COUNT), ez(POINT_COUNT), ew(POINT_COUNT);
+        const double objectTime = Measure([&]() {
+            for (std::size_t i = 0x0; i < POINT_COUNT; i++) {
+                const FF::Vector4<float> point = objectMatrix * FF::Vector4<float>(x[i], y[i], z[i], w[i]);
+
+                ex[i] = point.GetXComponent();
+                ey[i] = point.GetYComponent();
+                ez[i] = point.GetZComponent();
+                ew[i] = point.GetWComponent();
+            }
+        });
+
+        FF::AlignedVector<float> ox(POINT_COUNT), oy(POINT_COUNT), oz(POINT_COUNT), ow(POINT_COUNT);
+        const double pointsTime = Measure([&]() {
+            FF::TransformBatch<float>::TransformPoints(matrix, x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), POINT_COUNT);
+        });
+        const float pointsDifference = FF::max(MaxDifference(ox.data(), ex.data(), POINT_COUNT),
+                                               FF::max(MaxDifference(oy.data(), ey.data(), POINT_COUNT), MaxDifference(oz.data(), ez.data(), POINT_COUNT)));
+
+        const double vectorsTime = Measure([&]() {
+            FF::TransformBatch<float>::TransformVectors(matrix, x.data(), y.data(), z.data(), w.data(), ox.data(), oy.data(), oz.data(), ow.data(), POINT_COUNT);
+        });
+        const float vectorsDifference = FF::max(FF::max(MaxDifference(ox.data(), ex.data(), POINT_COUNT), MaxDifference(oy.data(), ey.data(), POINT_COUNT)),
+                                                FF::max(MaxDifference(oz.data(), ez.data(), POINT_COUNT), MaxDifference(ow.data(), ew.data(), POINT_COUNT)));
+
+        std::printf("\n%zu transformed points, us per frame\n", POINT_COUNT);
+        std::printf("%-28s %12s %11s %14s\n", "path", "us", "speedup", "max diff");
+        Report("per object Matrix4x4*Vector4", objectTime, objectTime, 0.0f);
+        Report("simd batch points (w = 1)", pointsTime, objectTime, pointsDifference);
+        Report("simd batch vectors", vectorsTime, objectTime, vectorsDifference);
+    }
+};
+
+int main(void){
+    const std::vector<Body> bodies = MakeBodies();
+
+    RunMatrices(bodies);
+    RunPoints();
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "FF_Macros.hxx"
+
+#ifndef FF_ALIGNEDALLOCATOR_HXX_
+#define FF_ALIGNEDALLOCATOR_HXX_
+
+namespace FF {
+    /**
+     * @brief   [Allocator of memory aligned to ALIGNMENT bytes]
+     * @details [Default alignment is width of AVX register, so SIMD batches start on register boundary and
+     *           arrays of 4x4 float matrices never split a cache line]
+     *
+     * @tparam T [Generic type]
+     * @tparam ALIGNMENT [Alignment in bytes, power of two]
+     */
+    template<typename T, std::size_t ALIGNMENT = 0x20>
+    class AlignedAllocator {
+    public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind {
+            using other = FF::AlignedAllocator<U, ALIGNMENT>;
+        };
+
+        AlignedAllocator(void) noexcept = default;
+
+        template<typename U>
+        AlignedAllocator(const FF::AlignedAllocator<U, ALIGNMENT>& __FF_IN) noexcept {}
+
+        inline T*   allocate(const std::size_t __FF_IN count);
+        inline void deallocate(T* __FF_IN pointer, const std::size_t __FF_IN count) noexcept;
+
+        ~AlignedAllocator(void) = default;
+    };
+
+    /**
+     * @brief [Vector which data is aligned to ALIGNMENT bytes]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T, std::size_t ALIGNMENT = 0x20>
+    using AlignedVector = std::vector<T, FF::AlignedAllocator<T, ALIGNMENT>>;
+
+    template<typename T, std::size_t ALIGNMENT>
+    inline T* FF::AlignedAllocator<T, ALIGNMENT>::allocate(const std::size_t __FF_IN count){
+        static_assert((ALIGNMENT & (ALIGNMENT - 0x1)) == 0x0, "Alignment must be power of two!");
+
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(ALIGNMENT)));
+    }
+
+    template<typename T, std::size_t ALIGNMENT>
+    inline void FF::AlignedAllocator<T, ALIGNMENT>::deallocate(T* __FF_IN pointer, const std::size_t __FF_IN) noexcept {
+        ::operator delete(pointer, std::align_val_t(ALIGNMENT));
+    }
+
+    template<typename T, typename U, std::size_t ALIGNMENT>
+    inline bool operator==(const FF::AlignedAllocator<T, ALIGNMENT>&, const FF::AlignedAllocator<U, ALIGNMENT>&) noexcept {
+        return true;
+    }
+
+    template<typename T, typename U, std::size_t ALIGNMENT>
+    inline bool operator!=(const FF::AlignedAllocator<T, ALIGNMENT>&, const FF::AlignedAllocator<U, ALIGNMENT>&) noexcept {
+        return false;
+    }
+};
+
+#endif // FF_ALIGNEDALLOCATOR_HXX_
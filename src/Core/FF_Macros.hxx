@@ -71,6 +71,57 @@ namespace FF {
         */
         #define FF_STATIC_ASSERT_MESSAGE(CONDITION, ERROR_MESSAGE) 
     #endif
+
+
+
+    /**
+     * @brief [Profile macro]
+     * @details [Profile macro define the PROFILE macros that record timings of scopes and values of counters to FF::Profiler.
+     *           Without __FF_PROFILE they expanding to nothing, so instrumented code has no cost in release]
+     */
+    #ifdef __FF_PROFILE
+        #define FF_PROFILE_CONCAT_IMPL(A, B)                       A##B
+        #define FF_PROFILE_CONCAT(A, B)                            FF_PROFILE_CONCAT_IMPL(A, B)
+
+        /**
+        * @brief [Profile scope macro]
+        * @details [In profile expanding to object which record time from its line to the end of enclosing scope]
+        */
+        #define FF_PROFILE_SCOPE(NAME)                             const FF::ProfileScope FF_PROFILE_CONCAT(ffProfileScope, __LINE__)(NAME)
+
+        /**
+        * @brief [Profile counter macro]
+        * @details [In profile expanding to record of counter value at current time]
+        */
+        #define FF_PROFILE_COUNTER(NAME, VALUE)                    FF::Profiler::Get().AddCounter(NAME, static_cast<double>(VALUE))
+    #else
+        /**
+        * @brief [Profile scope macro]
+        * @details [In release expanding to nothing]
+        */
+        #define FF_PROFILE_SCOPE(NAME)
+
+        /**
+        * @brief [Profile counter macro]
+        * @details [In release expanding to nothing, VALUE isn't evaluated]
+        */
+        #define FF_PROFILE_COUNTER(NAME, VALUE)
+    #endif
+
+
+
+    /**
+     * @brief [SIMD macro]
+     * @details [Define __FF_SIMD_AVX2 or __FF_SIMD_SSE2 according to instruction set enabled for compiler.
+     *           Batch kernels are specialized only if one of them defined. Define __FF_NO_SIMD to use scalar kernels]
+     */
+    #ifndef __FF_NO_SIMD
+        #if defined(__AVX2__)
+            #define __FF_SIMD_AVX2
+        #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+            #define __FF_SIMD_SSE2
+        #endif
+    #endif
 };
 
 #endif // FF_MACROS_HXX_
\ No newline at end of file
@@ -292,7 +292,7 @@ namespace FF {
 		 * @tparam T [Generic type]
 		 * @return   [Return element]
 		 */
-		inline const T&        operator()(const std::size_t& __FF_IN i, const std::size_t& __FF_IN j);
+		inline const T&        operator()(const std::size_t& __FF_IN i, const std::size_t& __FF_IN j) const;
 
 		
 
@@ -420,9 +420,9 @@ namespace FF {
 
 	template<typename T>
 	inline FF::Vector3<T>   operator*(const FF::Matrix3x3<T>& __FF_IN mat,  const FF::Vector3<T>& __FF_IN vec){
-		return FF::Vector3<T>( mat.m_mat[0x0][0x0] * getXComponent(vec) + mat.m_mat[0x0][0x1] * getYComponent(vec) + mat.m_mat[0x0][0x2] * getZComponent(vec),
-						  	   mat.m_mat[0x1][0x0] * getXComponent(vec) + mat.m_mat[0x1][0x1] * getYComponent(vec) + mat.m_mat[0x1][0x2] * getZComponent(vec),
-						  	   mat.m_mat[0x2][0x0] * getXComponent(vec) + mat.m_mat[0x2][0x1] * getYComponent(vec) + mat.m_mat[0x2][0x2] * getZComponent(vec) );
+		return FF::Vector3<T>( mat.m_mat[0x0][0x0] * vec.GetXComponent() + mat.m_mat[0x0][0x1] * vec.GetYComponent() + mat.m_mat[0x0][0x2] * vec.GetZComponent(),
+						  	   mat.m_mat[0x1][0x0] * vec.GetXComponent() + mat.m_mat[0x1][0x1] * vec.GetYComponent() + mat.m_mat[0x1][0x2] * vec.GetZComponent(),
+						  	   mat.m_mat[0x2][0x0] * vec.GetXComponent() + mat.m_mat[0x2][0x1] * vec.GetYComponent() + mat.m_mat[0x2][0x2] * vec.GetZComponent() );
 	}
 
 	template<typename T>
@@ -472,14 +472,14 @@ namespace FF {
 
 	template<typename T>
 	inline FF::Vector3<T> FF::Matrix3x3<T>::operator[](const std::size_t& __FF_IN rowNumber){
-		FF_STATIC_ASSERT_MESSAGE(rowNumber < 0x3uL, "Going beyond the vector!");
+		FF_ASSERT_MESSAGE(rowNumber < 0x3uL, "Going beyond the vector!");
 
 		return FF::Vector3<T>(this->m_mat[rowNumber][0x0], this->m_mat[rowNumber][0x1], this->m_mat[rowNumber][0x2]);
 	}
 
 	template<typename T>
-	inline const T& FF::Matrix3x3<T>::operator()(const std::size_t& i, const std::size_t& j){
-		FF_STATIC_ASSERT_MESSAGE(i < 0x3uL && j < 0x3uL, "I or J index greater 0x2. Going beyond array bound!");
+	inline const T& FF::Matrix3x3<T>::operator()(const std::size_t& i, const std::size_t& j) const {
+		FF_ASSERT_MESSAGE(i < 0x3uL && j < 0x3uL, "I or J index greater 0x2. Going beyond array bound!");
 
 		return this->m_mat[i][j];
 	}
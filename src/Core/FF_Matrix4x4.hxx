@@ -47,10 +47,10 @@ namespace FF {
 		 * 
 		 * @tparam T  [Generic type]
 		 */
-		explicit Matrix4x4(	const T __FF_IN v11 = static_cast<T>(0.0f), const T __FF_IN v12 = static_cast<T>(0.0f), const T __FF_IN v13 = static_cast<T>(0.0f), const T __FF_IN v14 = static_cast<T>(0.0f),
-							const T __FF_IN v21 = static_cast<T>(0.0f), const T __FF_IN v22 = static_cast<T>(0.0f), const T __FF_IN v23 = static_cast<T>(0.0f), const T __FF_IN v24 = static_cast<T>(0.0f),
-							const T __FF_IN v31 = static_cast<T>(0.0f), const T __FF_IN v32 = static_cast<T>(0.0f), const T __FF_IN v33 = static_cast<T>(0.0f), const T __FF_IN v34 = static_cast<T>(0.0f),
-							const T __FF_IN v41 = static_cast<T>(0.0f), const T __FF_IN v42 = static_cast<T>(0.0f), const T __FF_IN v43 = static_cast<T>(0.0f), const T __FF_IN v44 = static_cast<T>(0.0f) )
+		explicit constexpr Matrix4x4( const T __FF_IN v11 = static_cast<T>(0.0f), const T __FF_IN v12 = static_cast<T>(0.0f), const T __FF_IN v13 = static_cast<T>(0.0f), const T __FF_IN v14 = static_cast<T>(0.0f),
+									  const T __FF_IN v21 = static_cast<T>(0.0f), const T __FF_IN v22 = static_cast<T>(0.0f), const T __FF_IN v23 = static_cast<T>(0.0f), const T __FF_IN v24 = static_cast<T>(0.0f),
+									  const T __FF_IN v31 = static_cast<T>(0.0f), const T __FF_IN v32 = static_cast<T>(0.0f), const T __FF_IN v33 = static_cast<T>(0.0f), const T __FF_IN v34 = static_cast<T>(0.0f),
+									  const T __FF_IN v41 = static_cast<T>(0.0f), const T __FF_IN v42 = static_cast<T>(0.0f), const T __FF_IN v43 = static_cast<T>(0.0f), const T __FF_IN v44 = static_cast<T>(0.0f) )
 		: m_mat{ v11, v12, v13, v14,
 		 		 v21, v22, v23, v24,
 		 		 v31, v32, v33, v34,
@@ -95,7 +95,7 @@ namespace FF {
 		 * @return   [Return identity matrix]
 		 */
 		template<typename U>
-		friend inline FF::Matrix4x4<U>& Identity(void);
+		friend constexpr FF::Matrix4x4<U> Identity(void);
 
 
 
@@ -196,7 +196,7 @@ namespace FF {
 		
 		/**
 		 * @brief   [Friend function that calculate mul of two mats]
-		 * @details [Each component is mul of appropriate components of appropriate row and column]
+		 * @details [Each component is sum of four muls of appropriate components of appropriate row and column]
 		 * 
 		 * @param mat1 [First matrix]
 		 * @param mat2 [Second matrix]
@@ -288,7 +288,7 @@ namespace FF {
 		 * @tparam T [Generic type]
 		 * @return   [Return element]
 		 */
-		inline const T&        operator()(const std::size_t& __FF_IN i, const std::size_t& __FF_IN j);
+		inline const T&        operator()(const std::size_t& __FF_IN i, const std::size_t& __FF_IN j) const;
 		
 
 
@@ -317,13 +317,13 @@ namespace FF {
 						 	     FF::Vector4<T>& __FF_IN vec2,
 						 	     FF::Vector4<T>& __FF_IN vec3,
 						 	     FF::Vector4<T>& __FF_IN vec4 )
-	: m_mat{ vec1.getXComponent(), vec1.getYComponent(), vec1.GetZComponent(), vec1.GetWComponent(),
-		 	 vec2.getXComponent(), vec2.getYComponent(), vec2.GetZComponent(), vec2.GetWComponent(),
-		 	 vec3.getXComponent(), vec3.getYComponent(), vec3.GetZComponent(), vec3.GetWComponent(),
-		 	 vec4.getXComponent(), vec4.getYComponent(), vec4.GetZComponent(), vec4.GetWComponent() } {}
+	: m_mat{ vec1.GetXComponent(), vec1.GetYComponent(), vec1.GetZComponent(), vec1.GetWComponent(),
+		 	 vec2.GetXComponent(), vec2.GetYComponent(), vec2.GetZComponent(), vec2.GetWComponent(),
+		 	 vec3.GetXComponent(), vec3.GetYComponent(), vec3.GetZComponent(), vec3.GetWComponent(),
+		 	 vec4.GetXComponent(), vec4.GetYComponent(), vec4.GetZComponent(), vec4.GetWComponent() } {}
 
 	template<typename T>
-	inline FF::Matrix4x4<T>& Identity(void){
+	constexpr FF::Matrix4x4<T> Identity(void){
 		return FF::Matrix4x4<T>( static_cast<T>(1.0f), static_cast<T>(0.0f), static_cast<T>(0.0f), static_cast<T>(0.0f),
 				  		  	     static_cast<T>(0.0f), static_cast<T>(1.0f), static_cast<T>(0.0f), static_cast<T>(0.0f),
 				  		   		 static_cast<T>(0.0f), static_cast<T>(0.0f), static_cast<T>(1.0f), static_cast<T>(0.0f),
@@ -407,33 +407,33 @@ namespace FF {
 
 	template<typename T>
 	inline FF::Matrix4x4<T> operator*(const FF::Matrix4x4<T>& __FF_IN mat1, const FF::Matrix4x4<T>& __FF_IN mat2){
-		return FF::Matrix4x4<T>( mat1.m_mat[0x0][0x0] * mat2.m_mat[0x0][0x0] + mat1.m_mat[0x0][0x1] * mat2.m_mat[0x1][0x0] + mat1.m_mat[0x0][0x2] * mat2.m_mat[0x2][0x0],
-							     mat1.m_mat[0x0][0x0] * mat2.m_mat[0x0][0x1] + mat1.m_mat[0x0][0x1] * mat2.m_mat[0x1][0x1] + mat1.m_mat[0x0][0x2] * mat2.m_mat[0x2][0x1],
-							     mat1.m_mat[0x0][0x0] * mat2.m_mat[0x0][0x2] + mat1.m_mat[0x0][0x1] * mat2.m_mat[0x1][0x2] + mat1.m_mat[0x0][0x2] * mat2.m_mat[0x2][0x2],
-							     mat1.m_mat[0x0][0x0] * mat2.m_mat[0x0][0x3] + mat1.m_mat[0x0][0x1] * mat2.m_mat[0x1][0x3] + mat1.m_mat[0x0][0x2] * mat2.m_mat[0x2][0x3],
-
-							     mat1.m_mat[0x1][0x0] * mat2.m_mat[0x0][0x0] + mat1.m_mat[0x1][0x1] * mat2.m_mat[0x1][0x0] + mat1.m_mat[0x1][0x2] * mat2.m_mat[0x2][0x0],
-							     mat1.m_mat[0x1][0x0] * mat2.m_mat[0x0][0x1] + mat1.m_mat[0x1][0x1] * mat2.m_mat[0x1][0x1] + mat1.m_mat[0x1][0x2] * mat2.m_mat[0x2][0x1],
-							     mat1.m_mat[0x1][0x0] * mat2.m_mat[0x0][0x2] + mat1.m_mat[0x1][0x1] * mat2.m_mat[0x1][0x2] + mat1.m_mat[0x1][0x2] * mat2.m_mat[0x2][0x2],
-							     mat1.m_mat[0x1][0x0] * mat2.m_mat[0x0][0x3] + mat1.m_mat[0x1][0x1] * mat2.m_mat[0x1][0x3] + mat1.m_mat[0x1][0x2] * mat2.m_mat[0x2][0x3],
-
-							     mat1.m_mat[0x2][0x0] * mat2.m_mat[0x0][0x0] + mat1.m_mat[0x2][0x1] * mat2.m_mat[0x1][0x0] + mat1.m_mat[0x2][0x2] * mat2.m_mat[0x2][0x0],
-							     mat1.m_mat[0x2][0x0] * mat2.m_mat[0x0][0x1] + mat1.m_mat[0x2][0x1] * mat2.m_mat[0x1][0x1] + mat1.m_mat[0x2][0x2] * mat2.m_mat[0x2][0x1],
-							     mat1.m_mat[0x2][0x0] * mat2.m_mat[0x0][0x2] + mat1.m_mat[0x2][0x1] * mat2.m_mat[0x1][0x2] + mat1.m_mat[0x2][0x2] * mat2.m_mat[0x2][0x2],
-							     mat1.m_mat[0x2][0x0] * mat2.m_mat[0x0][0x3] + mat1.m_mat[0x2][0x1] * mat2.m_mat[0x1][0x3] + mat1.m_mat[0x2][0x2] * mat2.m_mat[0x2][0x3],
-
-							     mat1.m_mat[0x3][0x0] * mat2.m_mat[0x0][0x0] + mat1.m_mat[0x3][0x1] * mat2.m_mat[0x1][0x0] + mat1.m_mat[0x3][0x2] * mat2.m_mat[0x2][0x0],
-							     mat1.m_mat[0x3][0x0] * mat2.m_mat[0x0][0x1] + mat1.m_mat[0x3][0x1] * mat2.m_mat[0x1][0x1] + mat1.m_mat[0x3][0x2] * mat2.m_mat[0x2][0x1],
-							     mat1.m_mat[0x3][0x0] * mat2.m_mat[0x0][0x2] + mat1.m_mat[0x3][0x1] * mat2.m_mat[0x1][0x2] + mat1.m_mat[0x3][0x2] * mat2.m_mat[0x2][0x2],
-							     mat1.m_mat[0x3][0x0] * mat2.m_mat[0x0][0x3] + mat1.m_mat[0x3][0x1] * mat2.m_mat[0x1][0x3] + mat1.m_mat[0x3][0x2] * mat2.m_mat[0x2][0x3] );
+		return FF::Matrix4x4<T>( mat1.m_mat[0x0][0x0] * mat2.m_mat[0x0][0x0] + mat1.m_mat[0x0][0x1] * mat2.m_mat[0x1][0x0] + mat1.m_mat[0x0][0x2] * mat2.m_mat[0x2][0x0] + mat1.m_mat[0x0][0x3] * mat2.m_mat[0x3][0x0],
+							     mat1.m_mat[0x0][0x0] * mat2.m_mat[0x0][0x1] + mat1.m_mat[0x0][0x1] * mat2.m_mat[0x1][0x1] + mat1.m_mat[0x0][0x2] * mat2.m_mat[0x2][0x1] + mat1.m_mat[0x0][0x3] * mat2.m_mat[0x3][0x1],
+							     mat1.m_mat[0x0][0x0] * mat2.m_mat[0x0][0x2] + mat1.m_mat[0x0][0x1] * mat2.m_mat[0x1][0x2] + mat1.m_mat[0x0][0x2] * mat2.m_mat[0x2][0x2] + mat1.m_mat[0x0][0x3] * mat2.m_mat[0x3][0x2],
+							     mat1.m_mat[0x0][0x0] * mat2.m_mat[0x0][0x3] + mat1.m_mat[0x0][0x1] * mat2.m_mat[0x1][0x3] + mat1.m_mat[0x0][0x2] * mat2.m_mat[0x2][0x3] + mat1.m_mat[0x0][0x3] * mat2.m_mat[0x3][0x3],
+
+							     mat1.m_mat[0x1][0x0] * mat2.m_mat[0x0][0x0] + mat1.m_mat[0x1][0x1] * mat2.m_mat[0x1][0x0] + mat1.m_mat[0x1][0x2] * mat2.m_mat[0x2][0x0] + mat1.m_mat[0x1][0x3] * mat2.m_mat[0x3][0x0],
+							     mat1.m_mat[0x1][0x0] * mat2.m_mat[0x0][0x1] + mat1.m_mat[0x1][0x1] * mat2.m_mat[0x1][0x1] + mat1.m_mat[0x1][0x2] * mat2.m_mat[0x2][0x1] + mat1.m_mat[0x1][0x3] * mat2.m_mat[0x3][0x1],
+							     mat1.m_mat[0x1][0x0] * mat2.m_mat[0x0][0x2] + mat1.m_mat[0x1][0x1] * mat2.m_mat[0x1][0x2] + mat1.m_mat[0x1][0x2] * mat2.m_mat[0x2][0x2] + mat1.m_mat[0x1][0x3] * mat2.m_mat[0x3][0x2],
+							     mat1.m_mat[0x1][0x0] * mat2.m_mat[0x0][0x3] + mat1.m_mat[0x1][0x1] * mat2.m_mat[0x1][0x3] + mat1.m_mat[0x1][0x2] * mat2.m_mat[0x2][0x3] + mat1.m_mat[0x1][0x3] * mat2.m_mat[0x3][0x3],
+
+							     mat1.m_mat[0x2][0x0] * mat2.m_mat[0x0][0x0] + mat1.m_mat[0x2][0x1] * mat2.m_mat[0x1][0x0] + mat1.m_mat[0x2][0x2] * mat2.m_mat[0x2][0x0] + mat1.m_mat[0x2][0x3] * mat2.m_mat[0x3][0x0],
+							     mat1.m_mat[0x2][0x0] * mat2.m_mat[0x0][0x1] + mat1.m_mat[0x2][0x1] * mat2.m_mat[0x1][0x1] + mat1.m_mat[0x2][0x2] * mat2.m_mat[0x2][0x1] + mat1.m_mat[0x2][0x3] * mat2.m_mat[0x3][0x1],
+							     mat1.m_mat[0x2][0x0] * mat2.m_mat[0x0][0x2] + mat1.m_mat[0x2][0x1] * mat2.m_mat[0x1][0x2] + mat1.m_mat[0x2][0x2] * mat2.m_mat[0x2][0x2] + mat1.m_mat[0x2][0x3] * mat2.m_mat[0x3][0x2],
+							     mat1.m_mat[0x2][0x0] * mat2.m_mat[0x0][0x3] + mat1.m_mat[0x2][0x1] * mat2.m_mat[0x1][0x3] + mat1.m_mat[0x2][0x2] * mat2.m_mat[0x2][0x3] + mat1.m_mat[0x2][0x3] * mat2.m_mat[0x3][0x3],
+
+							     mat1.m_mat[0x3][0x0] * mat2.m_mat[0x0][0x0] + mat1.m_mat[0x3][0x1] * mat2.m_mat[0x1][0x0] + mat1.m_mat[0x3][0x2] * mat2.m_mat[0x2][0x0] + mat1.m_mat[0x3][0x3] * mat2.m_mat[0x3][0x0],
+							     mat1.m_mat[0x3][0x0] * mat2.m_mat[0x0][0x1] + mat1.m_mat[0x3][0x1] * mat2.m_mat[0x1][0x1] + mat1.m_mat[0x3][0x2] * mat2.m_mat[0x2][0x1] + mat1.m_mat[0x3][0x3] * mat2.m_mat[0x3][0x1],
+							     mat1.m_mat[0x3][0x0] * mat2.m_mat[0x0][0x2] + mat1.m_mat[0x3][0x1] * mat2.m_mat[0x1][0x2] + mat1.m_mat[0x3][0x2] * mat2.m_mat[0x2][0x2] + mat1.m_mat[0x3][0x3] * mat2.m_mat[0x3][0x2],
+							     mat1.m_mat[0x3][0x0] * mat2.m_mat[0x0][0x3] + mat1.m_mat[0x3][0x1] * mat2.m_mat[0x1][0x3] + mat1.m_mat[0x3][0x2] * mat2.m_mat[0x2][0x3] + mat1.m_mat[0x3][0x3] * mat2.m_mat[0x3][0x3] );
 	}
 
 	template<typename T>
 	inline FF::Vector4<T>   operator*(const FF::Matrix4x4<T>& __FF_IN mat,  const FF::Vector4<T>& __FF_IN vec){
-		return FF::Vector4<T>( mat.m_mat[0x0][0x0] * vec.getXComponent(vec) + mat.m_mat[0x0][0x1] * vec.getYComponent(vec) + mat.m_mat[0x0][0x2] * vec.getZComponent(vec) + mat.m_mat[0x0][0x3] * vec.getWComponent(vec),
-							   mat.m_mat[0x1][0x0] * vec.getXComponent(vec) + mat.m_mat[0x1][0x1] * vec.getYComponent(vec) + mat.m_mat[0x1][0x2] * vec.getZComponent(vec) + mat.m_mat[0x1][0x3] * vec.getWComponent(vec),
-							   mat.m_mat[0x2][0x0] * vec.getXComponent(vec) + mat.m_mat[0x2][0x1] * vec.getYComponent(vec) + mat.m_mat[0x2][0x2] * vec.getZComponent(vec) + mat.m_mat[0x2][0x3] * vec.getWComponent(vec),
-							   mat.m_mat[0x3][0x0] * vec.getXComponent(vec) + mat.m_mat[0x3][0x1] * vec.getYComponent(vec) + mat.m_mat[0x3][0x2] * vec.getZComponent(vec) + mat.m_mat[0x3][0x3] * vec.getWComponent(vec) );
+		return FF::Vector4<T>( mat.m_mat[0x0][0x0] * vec.GetXComponent() + mat.m_mat[0x0][0x1] * vec.GetYComponent() + mat.m_mat[0x0][0x2] * vec.GetZComponent() + mat.m_mat[0x0][0x3] * vec.GetWComponent(),
+							   mat.m_mat[0x1][0x0] * vec.GetXComponent() + mat.m_mat[0x1][0x1] * vec.GetYComponent() + mat.m_mat[0x1][0x2] * vec.GetZComponent() + mat.m_mat[0x1][0x3] * vec.GetWComponent(),
+							   mat.m_mat[0x2][0x0] * vec.GetXComponent() + mat.m_mat[0x2][0x1] * vec.GetYComponent() + mat.m_mat[0x2][0x2] * vec.GetZComponent() + mat.m_mat[0x2][0x3] * vec.GetWComponent(),
+							   mat.m_mat[0x3][0x0] * vec.GetXComponent() + mat.m_mat[0x3][0x1] * vec.GetYComponent() + mat.m_mat[0x3][0x2] * vec.GetZComponent() + mat.m_mat[0x3][0x3] * vec.GetWComponent() );
 	}
 
 	template<typename T>
@@ -473,14 +473,14 @@ namespace FF {
 
 	template<typename T>
 	inline FF::Vector4<T> FF::Matrix4x4<T>::operator[](const std::size_t& __FF_IN rowNumber){
-		FF_STATIC_ASSERT_MESSAGE(rowNumber < 0x4uL, "Going beyond the vector!");
+		FF_ASSERT_MESSAGE(rowNumber < 0x4uL, "Going beyond the vector!");
 
 		return FF::Vector4<T>(m_mat[rowNumber][0x0], m_mat[rowNumber][0x1], m_mat[rowNumber][0x2], m_mat[rowNumber][0x3]);
 	}
 
 	template<typename T>
-	inline const T& FF::Matrix4<T>::operator()(const std::size_t& __FF_IN i, const std::size_t& __FF_IN j){
-		FF_STATIC_ASSERT_MESSAGE(i < 0x4uL && j < 0x4uL, "I or J index greater 0x2. Going beyond array bound!");
+	inline const T& FF::Matrix4x4<T>::operator()(const std::size_t& __FF_IN i, const std::size_t& __FF_IN j) const {
+		FF_ASSERT_MESSAGE(i < 0x4uL && j < 0x4uL, "I or J index greater 0x3. Going beyond array bound!");
 
 		return this->m_mat[i][j];
 	}
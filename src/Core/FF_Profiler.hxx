@@ -0,0 +1,286 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "FF_Macros.hxx"
+
+#ifndef FF_PROFILER_HXX_
+#define FF_PROFILER_HXX_
+
+namespace FF {
+    /**
+     * @brief   [Record of profiler]
+     * @details [Scope has begin and duration, counter has value at begin. Times are in nanoseconds since start of profiler]
+     */
+    struct ProfileEvent {
+        const char*   m_Name;
+        std::uint64_t m_Begin;
+        std::uint64_t m_Duration;
+        double        m_Value;
+        std::uint32_t m_Thread;
+        bool          m_isCounter;
+    };
+
+    /**
+     * @brief   [Records of profiler with same name]
+     * @details [Times are in microseconds, for counters TOTAL is sum of values]
+     */
+    struct ProfileSummary {
+        const char* m_Name;
+        std::size_t m_Count;
+        double      m_Total;
+        double      m_Min;
+        double      m_Max;
+        bool        m_isCounter;
+    };
+
+    /**
+     * @brief   [Collector of timings of scopes and values of counters]
+     * @details [Code is instrumented by FF_PROFILE_SCOPE and FF_PROFILE_COUNTER macros, which record to the
+     *           single profiler only if __FF_PROFILE is defined. Names must be string literals, they are stored
+     *           by pointer. Recording is thread safe, records are exported as Chrome trace (chrome://tracing,
+     *           Perfetto) or CSV]
+     */
+    class Profiler {
+    private:
+        std::chrono::steady_clock::time_point m_Start;
+
+        std::mutex                            m_Mutex;
+        std::vector<FF::ProfileEvent>         m_Events;
+
+        explicit Profiler(void);
+
+        inline void Add(const FF::ProfileEvent& __FF_IN event);
+
+        static inline std::uint32_t ThreadIndex(void);
+
+        static inline void WriteMicroseconds(std::ostream& __FF_OUT out, const std::uint64_t __FF_IN time);
+    public:
+        Profiler(const FF::Profiler&)                = delete;
+        FF::Profiler& operator=(const FF::Profiler&) = delete;
+
+        static inline FF::Profiler& Get(void);
+
+        inline std::uint64_t Now(void) const;
+
+        inline void AddScope(const char* __FF_IN name, const std::uint64_t __FF_IN begin, const std::uint64_t __FF_IN end);
+        inline void AddCounter(const char* __FF_IN name, const double __FF_IN value);
+
+        inline void Clear(void);
+
+        inline std::vector<FF::ProfileEvent>   GetEvents(void);
+        inline std::vector<FF::ProfileSummary> GetSummary(void);
+
+        inline void WriteChromeTrace(std::ostream& __FF_OUT out);
+        inline void WriteCSV(std::ostream& __FF_OUT out);
+
+        ~Profiler(void) = default;
+    };
+
+    /**
+     * @brief   [Object which record time of its life to the profiler]
+     * @details [Is created by FF_PROFILE_SCOPE macro]
+     */
+    class ProfileScope {
+    private:
+        const char*   m_Name;
+        std::uint64_t m_Begin;
+    public:
+        explicit ProfileScope(void) = delete;
+
+        explicit ProfileScope(const char* __FF_IN name);
+
+        ProfileScope(const FF::ProfileScope&)                = delete;
+        FF::ProfileScope& operator=(const FF::ProfileScope&) = delete;
+
+        ~ProfileScope(void);
+    };
+
+    inline FF::Profiler::Profiler(void)
+    : m_Start(std::chrono::steady_clock::now()) {}
+
+    /**
+     * @brief [Method that get the single profiler]
+     *
+     * @return [Return profiler shared by all threads]
+     */
+    inline FF::Profiler& FF::Profiler::Get(void){
+        static FF::Profiler profiler;
+
+        return profiler;
+    }
+
+    /**
+     * @brief [Method that get small index of calling thread]
+     * @details [Threads are numbered in order of their first record]
+     *
+     * @return [Return index of thread]
+     */
+    inline std::uint32_t FF::Profiler::ThreadIndex(void){
+        static std::atomic<std::uint32_t> threadCount(0x0);
+        thread_local const std::uint32_t  index = threadCount++;
+
+        return index;
+    }
+
+    /**
+     * @brief [Method that get current time]
+     *
+     * @return [Return nanoseconds since start of profiler]
+     */
+    inline std::uint64_t FF::Profiler::Now(void) const {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->m_Start).count());
+    }
+
+    inline void FF::Profiler::Add(const FF::ProfileEvent& __FF_IN event){
+        std::lock_guard<std::mutex> lock(this->m_Mutex);
+        this->m_Events.push_back(event);
+    }
+
+    /**
+     * @brief [Method that record scope]
+     *
+     * @param name [Name of scope, string literal]
+     * @param begin [Time of begin from Now()]
+     * @param end [Time of end from Now()]
+     */
+    inline void FF::Profiler::AddScope(const char* __FF_IN name, const std::uint64_t __FF_IN begin, const std::uint64_t __FF_IN end){
+        this->Add(FF::ProfileEvent{ name, begin, end - begin, 0.0, FF::Profiler::ThreadIndex(), false });
+    }
+
+    /**
+     * @brief [Method that record value of counter at current time]
+     *
+     * @param name [Name of counter, string literal]
+     * @param value [Value of counter]
+     */
+    inline void FF::Profiler::AddCounter(const char* __FF_IN name, const double __FF_IN value){
+        this->Add(FF::ProfileEvent{ name, this->Now(), 0x0, value, FF::Profiler::ThreadIndex(), true });
+    }
+
+    inline void FF::Profiler::Clear(void){
+        std::lock_guard<std::mutex> lock(this->m_Mutex);
+        this->m_Events.clear();
+    }
+
+    /**
+     * @brief [Method that get copy of records]
+     *
+     * @return [Return records in order of their end]
+     */
+    inline std::vector<FF::ProfileEvent> FF::Profiler::GetEvents(void){
+        std::lock_guard<std::mutex> lock(this->m_Mutex);
+
+        return this->m_Events;
+    }
+
+    /**
+     * @brief [Method that group records by name]
+     * @details [Groups are in order of first record of each name]
+     *
+     * @return [Return summary of each name]
+     */
+    inline std::vector<FF::ProfileSummary> FF::Profiler::GetSummary(void){
+        const std::vector<FF::ProfileEvent> events = this->GetEvents();
+
+        std::vector<FF::ProfileSummary> summary;
+        for (const FF::ProfileEvent& event : events) {
+            const double value = event.m_isCounter ? event.m_Value : static_cast<double>(event.m_Duration) * 1e-3;
+
+            std::size_t group = 0x0;
+            while (group < summary.size() && std::strcmp(summary[group].m_Name, event.m_Name) != 0x0) {
+                group++;
+            }
+
+            if (group == summary.size()) {
+                summary.push_back(FF::ProfileSummary{ event.m_Name, 0x0, 0.0, value, value, event.m_isCounter });
+            }
+
+            FF::ProfileSummary& entry = summary[group];
+            entry.m_Count++;
+            entry.m_Total += value;
+            entry.m_Min    = (value < entry.m_Min) ? value : entry.m_Min;
+            entry.m_Max    = (value > entry.m_Max) ? value : entry.m_Max;
+        }
+
+        return summary;
+    }
+
+    /**
+     * @brief [Method that write time in microseconds with three decimals]
+     * @details [Integer part and nanoseconds are written separately, so time is exact and stream format is kept]
+     *
+     * @param out [Stream]
+     * @param time [Time in nanoseconds]
+     */
+    inline void FF::Profiler::WriteMicroseconds(std::ostream& __FF_OUT out, const std::uint64_t __FF_IN time){
+        const std::uint64_t nanoseconds = time % 0x3E8;
+
+        out << time / 0x3E8 << '.' << static_cast<char>('0' + nanoseconds / 0x64)
+            << static_cast<char>('0' + nanoseconds / 0xA % 0xA) << static_cast<char>('0' + nanoseconds % 0xA);
+    }
+
+    /**
+     * @brief [Method that write records in Chrome trace event format]
+     * @details [Scopes are complete events, counters are counter events, times are in microseconds
+     *           with three decimals]
+     *
+     * @param out [Stream of JSON file]
+     */
+    inline void FF::Profiler::WriteChromeTrace(std::ostream& __FF_OUT out){
+        const std::vector<FF::ProfileEvent> events = this->GetEvents();
+
+        out << "{\"traceEvents\":[";
+        for (std::size_t i = 0x0; i < events.size(); i++) {
+            const FF::ProfileEvent& event = events[i];
+
+            out << ((i == 0x0) ? "\n" : ",\n");
+            out << "{\"name\":\"" << event.m_Name << "\",\"cat\":\"FF\",\"pid\":0,\"tid\":" << event.m_Thread
+                << ",\"ts\":";
+            FF::Profiler::WriteMicroseconds(out, event.m_Begin);
+            if (event.m_isCounter) {
+                out << ",\"ph\":\"C\",\"args\":{\"value\":" << event.m_Value << "}}";
+            } else {
+                out << ",\"ph\":\"X\",\"dur\":";
+                FF::Profiler::WriteMicroseconds(out, event.m_Duration);
+                out << "}";
+            }
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    /**
+     * @brief [Method that write records as CSV table]
+     * @details [Columns are type, name, thread, begin and duration in microseconds with three decimals,
+     *           value of counter]
+     *
+     * @param out [Stream of CSV file]
+     */
+    inline void FF::Profiler::WriteCSV(std::ostream& __FF_OUT out){
+        const std::vector<FF::ProfileEvent> events = this->GetEvents();
+
+        out << "type,name,thread,begin_us,duration_us,value\n";
+        for (const FF::ProfileEvent& event : events) {
+            out << (event.m_isCounter ? "counter" : "scope") << ',' << event.m_Name << ',' << event.m_Thread << ',';
+            FF::Profiler::WriteMicroseconds(out, event.m_Begin);
+            out << ',';
+            FF::Profiler::WriteMicroseconds(out, event.m_Duration);
+            out << ',' << event.m_Value << '\n';
+        }
+    }
+
+    inline FF::ProfileScope::ProfileScope(const char* __FF_IN name)
+    : m_Name(name),
+      m_Begin(FF::Profiler::Get().Now()) {}
+
+    inline FF::ProfileScope::~ProfileScope(void){
+        FF::Profiler& profiler = FF::Profiler::Get();
+        profiler.AddScope(this->m_Name, this->m_Begin, profiler.Now());
+    }
+};
+
+#endif // FF_PROFILER_HXX_
@@ -37,14 +37,14 @@ namespace FF {
 		 * @param y [Z component]
 		 * @param w [W component]
 		 */
-		explicit Quaternion( T __FF_IN x = static_cast<T>(0.0f),
-				             T __FF_IN y = static_cast<T>(0.0f),
-				             T __FF_IN z = static_cast<T>(0.0f),
-				             T __FF_IN w = static_cast<T>(0.0f) )
+		explicit constexpr Quaternion( T __FF_IN x = static_cast<T>(0.0f),
+				                       T __FF_IN y = static_cast<T>(0.0f),
+				                       T __FF_IN z = static_cast<T>(0.0f),
+				                       T __FF_IN w = static_cast<T>(0.0f) )
 		: m_x(x), 
 		  m_y(y), 
-		  m_y(z), 
-		  m_y(w) {}
+		  m_z(z), 
+		  m_w(w) {}
 
 		/**
 		 * @brief [Constructor with parameters]
@@ -76,19 +76,29 @@ namespace FF {
 		template<typename U>
 		friend inline FF::Quaternion<U> operator*(const FF::Quaternion<U>& __FF_IN quat1, const FF::Quaternion<U>& __FF_IN quat2);
 
+		/**
+		 * @brief [Methods that get components of quaternion]
+		 * @details [Const methods]
+		 * @return [Return component]
+		 */
+		const inline T& GetXComponent(void) const noexcept;
+		const inline T& GetYComponent(void) const noexcept;
+		const inline T& GetZComponent(void) const noexcept;
+		const inline T& GetWComponent(void) const noexcept;
+
 		/**
 		 * @brief [Method that get vector part of quaternion]
 		 * @details [X, Y and Z components are vector part]
 		 * @return [Return VEC3 with X, Y and Z components from origin quaternion]
 		 */
-		inline const FF::Vector3<T>& GetVectorPart(void) const;
+		inline FF::Vector3<T>   GetVectorPart(void) const;
 
 		/**
 		 * @brief [Method that get rotation matrix by quaternion]
-		 * @details [Const method]
+		 * @details [Const method. Quaternion must be unit. Arrays of quaternions are converted by FF::TransformBatch]
 		 * @return [Return rotation MAT3]
 		 */
-		inline FF::Matrix3x3<T>& GetRotationMatrix(void) const;
+		inline FF::Matrix3x3<T> GetRotationMatrix(void) const;
 
 		/**
 		 * @brief [Method that set rotation matrix]
@@ -123,19 +133,39 @@ namespace FF {
 
 	template<typename T>
 	inline FF::Quaternion<T> operator*(const FF::Quaternion<T>& quat1, const FF::Quaternion<T>& quat2){
-		return FF::Quaternion<T>( quat1.m_w * quat2.x + quat1.m_x * quat2.m_w + quat1.m_y * quat2.m_z - quat1.m_z * quat2.m_y, 
-								  quat1.m_w * quat2.y - quat1.m_x * quat2.m_z + quat1.m_y * quat2.m_w + quat1.m_z * quat2.m_x, 
-								  quat1.m_w * quat2.z + quat1.m_x * quat2.m_y - quat1.m_y * quat2.m_x + quat1.m_z * quat2.m_w, 
-								  quat1.m_w * quat2.w - quat1.m_x * quat2.m_x - quat1.m_y * quat2.m_y - quat1.m_z * quat2.m_z );
+		return FF::Quaternion<T>( quat1.m_w * quat2.m_x + quat1.m_x * quat2.m_w + quat1.m_y * quat2.m_z - quat1.m_z * quat2.m_y, 
+								  quat1.m_w * quat2.m_y - quat1.m_x * quat2.m_z + quat1.m_y * quat2.m_w + quat1.m_z * quat2.m_x, 
+								  quat1.m_w * quat2.m_z + quat1.m_x * quat2.m_y - quat1.m_y * quat2.m_x + quat1.m_z * quat2.m_w, 
+								  quat1.m_w * quat2.m_w - quat1.m_x * quat2.m_x - quat1.m_y * quat2.m_y - quat1.m_z * quat2.m_z );
+	}
+
+	template<typename T>
+	const inline T& FF::Quaternion<T>::GetXComponent(void) const noexcept {
+		return this->m_x;
+	}
+
+	template<typename T>
+	const inline T& FF::Quaternion<T>::GetYComponent(void) const noexcept {
+		return this->m_y;
+	}
+
+	template<typename T>
+	const inline T& FF::Quaternion<T>::GetZComponent(void) const noexcept {
+		return this->m_z;
+	}
+
+	template<typename T>
+	const inline T& FF::Quaternion<T>::GetWComponent(void) const noexcept {
+		return this->m_w;
 	}
 
 	template<typename T>
-	inline const FF::Vector3<T>& FF::Quaternion<T>::GetVectorPart(void) const {
+	inline FF::Vector3<T>   FF::Quaternion<T>::GetVectorPart(void) const {
 		return FF::Vector3<T>( this->m_x, this->m_y, this->m_z );
 	}
 
 	template<typename T>
-	inline FF::Matrix3x3<T>& FF::Quaternion<T>::GetRotationMatrix(void) const {
+	inline FF::Matrix3x3<T> FF::Quaternion<T>::GetRotationMatrix(void) const {
 		T xx = FF::sqr(this->m_x);
 		T yy = FF::sqr(this->m_y);
 		T zz = FF::sqr(this->m_z);
@@ -148,7 +178,7 @@ namespace FF {
 
 		return FF::Matrix3x3<T>( 1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz),        2.0f * (xz + wy), 
 								 2.0f * (xy + wz),        1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx),
-								 2.0f * (xz - xy), 	      2.0f * (yz + wx),        1.0f - 2.0f * (xx + yy) );
+								 2.0f * (xz - wy), 	      2.0f * (yz + wx),        1.0f - 2.0f * (xx + yy) );
 	}
 
 	template<typename T>
@@ -0,0 +1,362 @@
+#include <cstdint>
+
+#include "FF_Macros.hxx"
+#include "FF_CommonMath.hxx"
+#include "FF_VectorBatch.hxx"
+
+#ifndef FF_TRANSFORMBATCH_HXX_
+#define FF_TRANSFORMBATCH_HXX_
+
+namespace FF {
+    /**
+     * @brief   [Scalar kernels that build and apply transforms of arrays of instances]
+     * @details [Locations and quaternions are stored as structure of arrays like in FF::VectorBatch.
+     *           Matrices are stored one after another, each row-major: rotation of unit quaternion in columns 0-2,
+     *           location in column 3, so point is transformed as M * (x, y, z, 1). 3x4 matrix is the first three
+     *           rows of 4x4 one. It is the reference implementation, SIMD kernels do the same operations in the same
+     *           order, so their results are equal bit to bit while compiler doesn't contract mul and add to FMA]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    class ScalarTransformBatch {
+    public:
+        explicit ScalarTransformBatch(void) = delete;
+
+        /**
+         * @brief [Method that write identity matrix]
+         *
+         * @param out [ROWCOUNT x 4 matrix]
+         * @param rowCount [3 or 4]
+         */
+        static constexpr void Identity(T* __FF_OUT out, const std::size_t __FF_IN rowCount);
+
+        /**
+         * @brief [Method that write matrix of rotation by quaternion Q and translation by P]
+         * @details [Rotation is the same as FF::Quaternion<T>::GetRotationMatrix()]
+         *
+         * @param out [ROWCOUNT x 4 matrix]
+         * @param rowCount [3 or 4]
+         */
+        static constexpr void RigidTransform( const T __FF_IN qx, const T __FF_IN qy, const T __FF_IN qz, const T __FF_IN qw,
+                                              const T __FF_IN px, const T __FF_IN py, const T __FF_IN pz,
+                                              T*      __FF_OUT out,
+                                              const std::size_t __FF_IN rowCount );
+
+        /**
+         * @brief [Method that build 4x4 matrices of array of instances]
+         * @details [OUT[16 * i .. 16 * i + 15] = RigidTransform(Q[i], P[i])]
+         */
+        static inline void BuildMatrices4x4( const T* __FF_IN  qx, const T* __FF_IN qy, const T* __FF_IN qz, const T* __FF_IN qw,
+                                             const T* __FF_IN  px, const T* __FF_IN py, const T* __FF_IN pz,
+                                             T*       __FF_OUT out,
+                                             const std::size_t __FF_IN count );
+
+        /**
+         * @brief [Method that build 3x4 matrices of array of instances]
+         * @details [OUT[12 * i .. 12 * i + 11] = RigidTransform(Q[i], P[i])]
+         */
+        static inline void BuildMatrices3x4( const T* __FF_IN  qx, const T* __FF_IN qy, const T* __FF_IN qz, const T* __FF_IN qw,
+                                             const T* __FF_IN  px, const T* __FF_IN py, const T* __FF_IN pz,
+                                             T*       __FF_OUT out,
+                                             const std::size_t __FF_IN count );
+
+        /**
+         * @brief [Method that transform array of points by one matrix]
+         * @details [OUT[i] = M * (V[i], 1), only the first three rows of M are used, so it may be 3x4 or 4x4]
+         */
+        static inline void TransformPoints( const T* __FF_IN  matrix,
+                                            const T* __FF_IN  x,  const T* __FF_IN  y,  const T* __FF_IN  z,
+                                            T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz,
+                                            const std::size_t __FF_IN count );
+
+        /**
+         * @brief [Method that transform array of four-dimensional vectors by one 4x4 matrix]
+         * @details [OUT[i] = M * V[i]]
+         */
+        static inline void TransformVectors( const T* __FF_IN  matrix,
+                                             const T* __FF_IN  x,  const T* __FF_IN  y,  const T* __FF_IN  z,  const T* __FF_IN  w,
+                                             T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz, T*       __FF_OUT ow,
+                                             const std::size_t __FF_IN count );
+
+        ~ScalarTransformBatch(void) = delete;
+    };
+
+    template<typename T>
+    constexpr void FF::ScalarTransformBatch<T>::Identity(T* __FF_OUT out, const std::size_t __FF_IN rowCount){
+        for (std::size_t row = 0x0; row < rowCount; row++) {
+            for (std::size_t column = 0x0; column < 0x4; column++) {
+                out[row * 0x4 + column] = (row == column) ? static_cast<T>(0x1) : static_cast<T>(0x0);
+            }
+        }
+    }
+
+    template<typename T>
+    constexpr void FF::ScalarTransformBatch<T>::RigidTransform( const T __FF_IN qx, const T __FF_IN qy, const T __FF_IN qz, const T __FF_IN qw,
+                                                                const T __FF_IN px, const T __FF_IN py, const T __FF_IN pz,
+                                                                T*      __FF_OUT out,
+                                                                const std::size_t __FF_IN rowCount ){
+        const T one = static_cast<T>(0x1);
+        const T two = static_cast<T>(0x2);
+
+        const T xx = qx * qx;
+        const T yy = qy * qy;
+        const T zz = qz * qz;
+        const T xy = qx * qy;
+        const T xz = qx * qz;
+        const T yz = qy * qz;
+        const T wx = qw * qx;
+        const T wy = qw * qy;
+        const T wz = qw * qz;
+
+        out[0x0] = one - two * (yy + zz); out[0x1] = two * (xy - wz);       out[0x2]  = two * (xz + wy);       out[0x3]  = px;
+        out[0x4] = two * (xy + wz);       out[0x5] = one - two * (xx + zz); out[0x6]  = two * (yz - wx);       out[0x7]  = py;
+        out[0x8] = two * (xz - wy);       out[0x9] = two * (yz + wx);       out[0xA]  = one - two * (xx + yy); out[0xB]  = pz;
+
+        if (rowCount == 0x4) {
+            out[0xC] = static_cast<T>(0x0); out[0xD] = static_cast<T>(0x0); out[0xE] = static_cast<T>(0x0); out[0xF] = one;
+        }
+    }
+
+    template<typename T>
+    inline void FF::ScalarTransformBatch<T>::BuildMatrices4x4( const T* __FF_IN  qx, const T* __FF_IN qy, const T* __FF_IN qz, const T* __FF_IN qw,
+                                                               const T* __FF_IN  px, const T* __FF_IN py, const T* __FF_IN pz,
+                                                               T*       __FF_OUT out,
+                                                               const std::size_t __FF_IN count ){
+        for (std::size_t i = 0x0; i < count; i++) {
+            RigidTransform(qx[i], qy[i], qz[i], qw[i], px[i], py[i], pz[i], out + i * 0x10, 0x4);
+        }
+    }
+
+    template<typename T>
+    inline void FF::ScalarTransformBatch<T>::BuildMatrices3x4( const T* __FF_IN  qx, const T* __FF_IN qy, const T* __FF_IN qz, const T* __FF_IN qw,
+                                                               const T* __FF_IN  px, const T* __FF_IN py, const T* __FF_IN pz,
+                                                               T*       __FF_OUT out,
+                                                               const std::size_t __FF_IN count ){
+        for (std::size_t i = 0x0; i < count; i++) {
+            RigidTransform(qx[i], qy[i], qz[i], qw[i], px[i], py[i], pz[i], out + i * 0xC, 0x3);
+        }
+    }
+
+    template<typename T>
+    inline void FF::ScalarTransformBatch<T>::TransformPoints( const T* __FF_IN  matrix,
+                                                              const T* __FF_IN  x,  const T* __FF_IN  y,  const T* __FF_IN  z,
+                                                              T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz,
+                                                              const std::size_t __FF_IN count ){
+        for (std::size_t i = 0x0; i < count; i++) {
+            const T vx = x[i];
+            const T vy = y[i];
+            const T vz = z[i];
+
+            ox[i] = ((matrix[0x0] * vx + matrix[0x1] * vy) + matrix[0x2] * vz) + matrix[0x3];
+            oy[i] = ((matrix[0x4] * vx + matrix[0x5] * vy) + matrix[0x6] * vz) + matrix[0x7];
+            oz[i] = ((matrix[0x8] * vx + matrix[0x9] * vy) + matrix[0xA] * vz) + matrix[0xB];
+        }
+    }
+
+    template<typename T>
+    inline void FF::ScalarTransformBatch<T>::TransformVectors( const T* __FF_IN  matrix,
+                                                               const T* __FF_IN  x,  const T* __FF_IN  y,  const T* __FF_IN  z,  const T* __FF_IN  w,
+                                                               T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz, T*       __FF_OUT ow,
+                                                               const std::size_t __FF_IN count ){
+        for (std::size_t i = 0x0; i < count; i++) {
+            const T vx = x[i];
+            const T vy = y[i];
+            const T vz = z[i];
+            const T vw = w[i];
+
+            ox[i] = ((matrix[0x0] * vx + matrix[0x1] * vy) + matrix[0x2] * vz) + matrix[0x3] * vw;
+            oy[i] = ((matrix[0x4] * vx + matrix[0x5] * vy) + matrix[0x6] * vz) + matrix[0x7] * vw;
+            oz[i] = ((matrix[0x8] * vx + matrix[0x9] * vy) + matrix[0xA] * vz) + matrix[0xB] * vw;
+            ow[i] = ((matrix[0xC] * vx + matrix[0xD] * vy) + matrix[0xE] * vz) + matrix[0xF] * vw;
+        }
+    }
+
+#if defined(__FF_SIMD_AVX2) || defined(__FF_SIMD_SSE2)
+    /**
+     * @brief   [SIMD kernels that build and apply transforms of arrays of instances]
+     * @details [Matrices of SimdLane<T>::WIDTH instances are built component by component, then blocks
+     *           of WIDTH components are transposed in registers and stored as rows of separate matrices,
+     *           so output has the same layout as ScalarTransformBatch. The tail is processed by ScalarTransformBatch]
+     *
+     * @tparam T [float or double]
+     */
+    template<typename T>
+    class SimdTransformBatch {
+    private:
+        using Lane     = FF::SimdLane<T>;
+        using Register = typename Lane::Register;
+
+        template<std::size_t ROW_COUNT>
+        static inline void RigidTransforms( const T* __FF_IN  qx, const T* __FF_IN qy, const T* __FF_IN qz, const T* __FF_IN qw,
+                                            const T* __FF_IN  px, const T* __FF_IN py, const T* __FF_IN pz,
+                                            T*       __FF_OUT out,
+                                            const std::size_t __FF_IN count );
+    public:
+        explicit SimdTransformBatch(void) = delete;
+
+        static constexpr void Identity(T* __FF_OUT out, const std::size_t __FF_IN rowCount){
+            FF::ScalarTransformBatch<T>::Identity(out, rowCount);
+        }
+
+        static inline void BuildMatrices4x4( const T* __FF_IN  qx, const T* __FF_IN qy, const T* __FF_IN qz, const T* __FF_IN qw,
+                                             const T* __FF_IN  px, const T* __FF_IN py, const T* __FF_IN pz,
+                                             T*       __FF_OUT out,
+                                             const std::size_t __FF_IN count ){
+            RigidTransforms<0x4>(qx, qy, qz, qw, px, py, pz, out, count);
+        }
+
+        static inline void BuildMatrices3x4( const T* __FF_IN  qx, const T* __FF_IN qy, const T* __FF_IN qz, const T* __FF_IN qw,
+                                             const T* __FF_IN  px, const T* __FF_IN py, const T* __FF_IN pz,
+                                             T*       __FF_OUT out,
+                                             const std::size_t __FF_IN count ){
+            RigidTransforms<0x3>(qx, qy, qz, qw, px, py, pz, out, count);
+        }
+
+        static inline void TransformPoints( const T* __FF_IN  matrix,
+                                            const T* __FF_IN  x,  const T* __FF_IN  y,  const T* __FF_IN  z,
+                                            T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz,
+                                            const std::size_t __FF_IN count ){
+            Register m[0xC];
+            for (std::size_t k = 0x0; k < 0xC; k++) {
+                m[k] = Lane::Set(matrix[k]);
+            }
+
+            std::size_t i = 0x0;
+            for (; i + Lane::WIDTH <= count; i += Lane::WIDTH) {
+                const Register vx = Lane::Load(x + i);
+                const Register vy = Lane::Load(y + i);
+                const Register vz = Lane::Load(z + i);
+
+                Lane::Store(ox + i, Lane::Add(Lane::Add(Lane::Add(Lane::Mul(m[0x0], vx), Lane::Mul(m[0x1], vy)), Lane::Mul(m[0x2], vz)), m[0x3]));
+                Lane::Store(oy + i, Lane::Add(Lane::Add(Lane::Add(Lane::Mul(m[0x4], vx), Lane::Mul(m[0x5], vy)), Lane::Mul(m[0x6], vz)), m[0x7]));
+                Lane::Store(oz + i, Lane::Add(Lane::Add(Lane::Add(Lane::Mul(m[0x8], vx), Lane::Mul(m[0x9], vy)), Lane::Mul(m[0xA], vz)), m[0xB]));
+            }
+            FF::ScalarTransformBatch<T>::TransformPoints(matrix, x + i, y + i, z + i, ox + i, oy + i, oz + i, count - i);
+        }
+
+        static inline void TransformVectors( const T* __FF_IN  matrix,
+                                             const T* __FF_IN  x,  const T* __FF_IN  y,  const T* __FF_IN  z,  const T* __FF_IN  w,
+                                             T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz, T*       __FF_OUT ow,
+                                             const std::size_t __FF_IN count ){
+            Register m[0x10];
+            for (std::size_t k = 0x0; k < 0x10; k++) {
+                m[k] = Lane::Set(matrix[k]);
+            }
+
+            T* const out[0x4] = { ox, oy, oz, ow };
+
+            std::size_t i = 0x0;
+            for (; i + Lane::WIDTH <= count; i += Lane::WIDTH) {
+                const Register vx = Lane::Load(x + i);
+                const Register vy = Lane::Load(y + i);
+                const Register vz = Lane::Load(z + i);
+                const Register vw = Lane::Load(w + i);
+
+                for (std::size_t row = 0x0; row < 0x4; row++) {
+                    const Register* r = m + row * 0x4;
+                    Lane::Store(out[row] + i, Lane::Add(Lane::Add(Lane::Add(Lane::Mul(r[0x0], vx), Lane::Mul(r[0x1], vy)), Lane::Mul(r[0x2], vz)), Lane::Mul(r[0x3], vw)));
+                }
+            }
+            FF::ScalarTransformBatch<T>::TransformVectors(matrix, x + i, y + i, z + i, w + i, ox + i, oy + i, oz + i, ow + i, count - i);
+        }
+
+        ~SimdTransformBatch(void) = delete;
+    };
+
+    template<typename T>
+    template<std::size_t ROW_COUNT>
+    inline void FF::SimdTransformBatch<T>::RigidTransforms( const T* __FF_IN  qx, const T* __FF_IN qy, const T* __FF_IN qz, const T* __FF_IN qw,
+                                                            const T* __FF_IN  px, const T* __FF_IN py, const T* __FF_IN pz,
+                                                            T*       __FF_OUT out,
+                                                            const std::size_t __FF_IN count ){
+        constexpr std::size_t SIZE        = ROW_COUNT * 0x4;
+        constexpr std::size_t BLOCK_COUNT = (SIZE + Lane::WIDTH - 0x1) / Lane::WIDTH;
+
+        // The last block of 3x4 matrix is half of register only for 8 floats
+        static_assert(SIZE % Lane::WIDTH == 0x0 || SIZE % Lane::WIDTH == Lane::WIDTH / 0x2, "Matrix must fill whole or half register!");
+
+        const Register zero = Lane::Set(static_cast<T>(0x0));
+        const Register one  = Lane::Set(static_cast<T>(0x1));
+        const Register two  = Lane::Set(static_cast<T>(0x2));
+
+        std::size_t i = 0x0;
+        for (; i + Lane::WIDTH <= count; i += Lane::WIDTH) {
+            const Register x = Lane::Load(qx + i);
+            const Register y = Lane::Load(qy + i);
+            const Register z = Lane::Load(qz + i);
+            const Register w = Lane::Load(qw + i);
+
+            const Register xx = Lane::Mul(x, x);
+            const Register yy = Lane::Mul(y, y);
+            const Register zz = Lane::Mul(z, z);
+            const Register xy = Lane::Mul(x, y);
+            const Register xz = Lane::Mul(x, z);
+            const Register yz = Lane::Mul(y, z);
+            const Register wx = Lane::Mul(w, x);
+            const Register wy = Lane::Mul(w, y);
+            const Register wz = Lane::Mul(w, z);
+
+            // Component K of all instances, padded by zeros up to whole blocks
+            Register c[BLOCK_COUNT * Lane::WIDTH];
+            c[0x0] = Lane::Sub(one, Lane::Mul(two, Lane::Add(yy, zz)));
+            c[0x1] = Lane::Mul(two, Lane::Sub(xy, wz));
+            c[0x2] = Lane::Mul(two, Lane::Add(xz, wy));
+            c[0x3] = Lane::Load(px + i);
+            c[0x4] = Lane::Mul(two, Lane::Add(xy, wz));
+            c[0x5] = Lane::Sub(one, Lane::Mul(two, Lane::Add(xx, zz)));
+            c[0x6] = Lane::Mul(two, Lane::Sub(yz, wx));
+            c[0x7] = Lane::Load(py + i);
+            c[0x8] = Lane::Mul(two, Lane::Sub(xz, wy));
+            c[0x9] = Lane::Mul(two, Lane::Add(yz, wx));
+            c[0xA] = Lane::Sub(one, Lane::Mul(two, Lane::Add(xx, yy)));
+            c[0xB] = Lane::Load(pz + i);
+
+            for (std::size_t k = 0xC; k < BLOCK_COUNT * Lane::WIDTH; k++) {
+                c[k] = zero;
+            }
+            if (ROW_COUNT == 0x4) {
+                c[0xF] = one;
+            }
+
+            T* matrices = out + i * SIZE;
+            for (std::size_t block = 0x0; block < BLOCK_COUNT; block++) {
+                Register* rows = c + block * Lane::WIDTH;
+                Lane::Transpose(rows);
+
+                for (std::size_t j = 0x0; j < Lane::WIDTH; j++) {
+                    if ((block + 0x1) * Lane::WIDTH <= SIZE) {
+                        Lane::Store(matrices + j * SIZE + block * Lane::WIDTH, rows[j]);
+                    } else {
+                        Lane::StoreHalf(matrices + j * SIZE + block * Lane::WIDTH, rows[j]);
+                    }
+                }
+            }
+        }
+
+        for (; i < count; i++) {
+            FF::ScalarTransformBatch<T>::RigidTransform(qx[i], qy[i], qz[i], qw[i], px[i], py[i], pz[i], out + i * SIZE, ROW_COUNT);
+        }
+    }
+#endif
+
+    /**
+     * @brief   [Kernels that build and apply transforms of arrays of instances]
+     * @details [Scalar for generic type, SimdTransformBatch for float and double if SIMD is enabled.
+     *           Use FF::AlignedVector for arrays, so SIMD loads and stores don't split cache lines]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    class TransformBatch : public FF::ScalarTransformBatch<T> {};
+
+#if defined(__FF_SIMD_AVX2) || defined(__FF_SIMD_SSE2)
+    template<>
+    class TransformBatch<float>  : public FF::SimdTransformBatch<float>  {};
+
+    template<>
+    class TransformBatch<double> : public FF::SimdTransformBatch<double> {};
+#endif
+};
+
+#endif // FF_TRANSFORMBATCH_HXX_
@@ -1,10 +1,10 @@
-#include "..\Core\FF_Macros.hxx"
+#include "../Core/FF_Macros.hxx"
 
-#include "..\Core\FF_CommonMath.hxx"
+#include "../Core/FF_CommonMath.hxx"
 
-#include "..\Core\FF_Vector3.hxx"
-#include "..\Core\FF_Matrix3x3.hxx"
-#include "..\Core\FF_Quaternion.hxx"
+#include "../Core/FF_Vector3.hxx"
+#include "../Core/FF_Matrix3x3.hxx"
+#include "../Core/FF_Quaternion.hxx"
 
 #ifndef FF_TRANSFORMS_HXX_
 #define FF_TRANSFORMS_HXX_
@@ -46,7 +46,18 @@ namespace FF {
          * 
          * @param vec [Vector]
          */
-        explicit Vector3(FF::Vector3<T>& __FF_IN vec);
+        Vector3(const FF::Vector3<T>& __FF_IN vec) = default;
+
+
+
+        /**
+         * @brief [Copy assignment of VEC3]
+         * @details [Copy each component of VEC to this vector]
+         * 
+         * @param vec [Vector]
+         * @return [Return this vector]
+         */
+        FF::Vector3<T>& operator=(const FF::Vector3<T>& __FF_IN vec) = default;
 
 
 
@@ -437,13 +448,6 @@ namespace FF {
         friend inline std::ostream& operator<< (std::ostream& __FF_IN out, FF::Vector3<U>& __FF_IN vec);
     };
 
-    template<typename T>
-    FF::Vector3<T>::Vector3(FF::Vector3<T>& __FF_IN vec) {
-        this->m_x = vec.GetXComponent();
-        this->m_y = vec.GetYComponent();
-        this->m_z = vec.GetZComponent();
-    }
-
     template<typename T>
     inline void FF::Vector3<T>::SetXComponent(const T __FF_IN x) noexcept {
         this->m_x = x;
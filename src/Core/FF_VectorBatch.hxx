@@ -0,0 +1,403 @@
+#include <cmath>
+#include <cstdint>
+
+#include "FF_Macros.hxx"
+#include "FF_CommonMath.hxx"
+
+#if defined(__FF_SIMD_AVX2) || defined(__FF_SIMD_SSE2)
+    #include <immintrin.h>
+#endif
+
+#ifndef FF_VECTORBATCH_HXX_
+#define FF_VECTORBATCH_HXX_
+
+namespace FF {
+    /**
+     * @brief   [Scalar kernels over arrays of three-dimensional vectors]
+     * @details [Vectors are stored as structure of arrays: component X of vector I is X[I] and so on.
+     *           It is the reference implementation, SIMD kernels do the same operations in the same order,
+     *           so their results are equal bit to bit while compiler doesn't contract mul and add to FMA]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    class ScalarVectorBatch {
+    public:
+        explicit ScalarVectorBatch(void) = delete;
+
+        /**
+         * @brief [Method that calculate difference of two arrays of vectors]
+         * @details [OUT[i] = A[i] - B[i]]
+         */
+        static inline void Subtract( const T* __FF_IN  ax, const T* __FF_IN  ay, const T* __FF_IN  az,
+                                     const T* __FF_IN  bx, const T* __FF_IN  by, const T* __FF_IN  bz,
+                                     T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz,
+                                     const std::size_t __FF_IN count );
+
+        /**
+         * @brief [Method that calculate dot products of two arrays of vectors]
+         * @details [OUT[i] = A[i] . B[i]]
+         */
+        static inline void DotProduct( const T* __FF_IN  ax, const T* __FF_IN  ay, const T* __FF_IN  az,
+                                       const T* __FF_IN  bx, const T* __FF_IN  by, const T* __FF_IN  bz,
+                                       T*       __FF_OUT out,
+                                       const std::size_t __FF_IN count );
+
+        /**
+         * @brief [Method that calculate magnitudes of array of vectors]
+         * @details [OUT[i] = |V[i]|]
+         */
+        static inline void Magnitude( const T* __FF_IN  x, const T* __FF_IN y, const T* __FF_IN z,
+                                      T*       __FF_OUT out,
+                                      const std::size_t __FF_IN count );
+
+        /**
+         * @brief [Method that normalize array of vectors]
+         * @details [OUT[i] = V[i] / |V[i]|, vector which magnitude is close to zero become zero vector]
+         */
+        static inline void Normalize( const T* __FF_IN  x,  const T* __FF_IN  y,  const T* __FF_IN  z,
+                                      T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz,
+                                      const std::size_t __FF_IN count );
+
+        /**
+         * @brief [Method that add scaled vectors to accumulator]
+         * @details [OUT[i] += SCALE[i] * V[i]]
+         */
+        static inline void ScaleAccumulate( const T* __FF_IN  scale,
+                                            const T* __FF_IN  x,  const T* __FF_IN  y,  const T* __FF_IN  z,
+                                            T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz,
+                                            const std::size_t __FF_IN count );
+
+        ~ScalarVectorBatch(void) = delete;
+    };
+
+    template<typename T>
+    inline void FF::ScalarVectorBatch<T>::Subtract( const T* __FF_IN  ax, const T* __FF_IN  ay, const T* __FF_IN  az,
+                                                    const T* __FF_IN  bx, const T* __FF_IN  by, const T* __FF_IN  bz,
+                                                    T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz,
+                                                    const std::size_t __FF_IN count ){
+        for (std::size_t i = 0x0; i < count; i++) {
+            ox[i] = ax[i] - bx[i];
+            oy[i] = ay[i] - by[i];
+            oz[i] = az[i] - bz[i];
+        }
+    }
+
+    template<typename T>
+    inline void FF::ScalarVectorBatch<T>::DotProduct( const T* __FF_IN  ax, const T* __FF_IN  ay, const T* __FF_IN  az,
+                                                      const T* __FF_IN  bx, const T* __FF_IN  by, const T* __FF_IN  bz,
+                                                      T*       __FF_OUT out,
+                                                      const std::size_t __FF_IN count ){
+        for (std::size_t i = 0x0; i < count; i++) {
+            out[i] = (ax[i] * bx[i] + ay[i] * by[i]) + az[i] * bz[i];
+        }
+    }
+
+    template<typename T>
+    inline void FF::ScalarVectorBatch<T>::Magnitude( const T* __FF_IN  x, const T* __FF_IN y, const T* __FF_IN z,
+                                                     T*       __FF_OUT out,
+                                                     const std::size_t __FF_IN count ){
+        for (std::size_t i = 0x0; i < count; i++) {
+            out[i] = std::sqrt((x[i] * x[i] + y[i] * y[i]) + z[i] * z[i]);
+        }
+    }
+
+    template<typename T>
+    inline void FF::ScalarVectorBatch<T>::Normalize( const T* __FF_IN  x,  const T* __FF_IN  y,  const T* __FF_IN  z,
+                                                     T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz,
+                                                     const std::size_t __FF_IN count ){
+        for (std::size_t i = 0x0; i < count; i++) {
+            const T magnitude       = std::sqrt((x[i] * x[i] + y[i] * y[i]) + z[i] * z[i]);
+            const T invertMagnitude = FF::CloseToZero(magnitude) ? static_cast<T>(0x0) : static_cast<T>(0x1) / magnitude;
+
+            ox[i] = x[i] * invertMagnitude;
+            oy[i] = y[i] * invertMagnitude;
+            oz[i] = z[i] * invertMagnitude;
+        }
+    }
+
+    template<typename T>
+    inline void FF::ScalarVectorBatch<T>::ScaleAccumulate( const T* __FF_IN  scale,
+                                                           const T* __FF_IN  x,  const T* __FF_IN  y,  const T* __FF_IN  z,
+                                                           T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz,
+                                                           const std::size_t __FF_IN count ){
+        for (std::size_t i = 0x0; i < count; i++) {
+            ox[i] += scale[i] * x[i];
+            oy[i] += scale[i] * y[i];
+            oz[i] += scale[i] * z[i];
+        }
+    }
+
+#if defined(__FF_SIMD_AVX2) || defined(__FF_SIMD_SSE2)
+    /**
+     * @brief   [Thin wrapper above SIMD register of generic type]
+     * @details [Specialized for float and double. WIDTH is count of values in one register.
+     *           Transpose() turns WIDTH registers of one component of WIDTH instances into
+     *           WIDTH registers of WIDTH components of one instance, StoreHalf() stores the first WIDTH / 2 values]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    struct SimdLane;
+
+#if defined(__FF_SIMD_AVX2)
+    template<>
+    struct SimdLane<float> {
+        using Register = __m256;
+        static constexpr std::size_t WIDTH = 0x8;
+
+        static inline Register Load(const float* __FF_IN p)                   { return _mm256_loadu_ps(p); }
+        static inline void     Store(float* __FF_OUT p, const Register v)     { _mm256_storeu_ps(p, v); }
+        static inline Register Set(const float __FF_IN value)                 { return _mm256_set1_ps(value); }
+        static inline Register Gather(const float* __FF_IN base, const std::uint32_t* __FF_IN index) {
+            // Masked form with zero source, unmasked one reads undefined source register
+            return _mm256_mask_i32gather_ps( _mm256_setzero_ps(), base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index)),
+                                             _mm256_castsi256_ps(_mm256_set1_epi32(-0x1)), 0x4 );
+        }
+
+        static inline Register Add(const Register a, const Register b)        { return _mm256_add_ps(a, b); }
+        static inline Register Sub(const Register a, const Register b)        { return _mm256_sub_ps(a, b); }
+        static inline Register Mul(const Register a, const Register b)        { return _mm256_mul_ps(a, b); }
+        static inline Register Div(const Register a, const Register b)        { return _mm256_div_ps(a, b); }
+        static inline Register Sqrt(const Register a)                         { return _mm256_sqrt_ps(a); }
+        static inline Register Greater(const Register a, const Register b)    { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static inline Register And(const Register mask, const Register a)     { return _mm256_and_ps(mask, a); }
+        static inline Register Epsilon(void)                                  { return _mm256_set1_ps(FF::fEPSILON); }
+
+        static inline void     StoreHalf(float* __FF_OUT p, const Register v) { _mm_storeu_ps(p, _mm256_castps256_ps128(v)); }
+        static inline void     Transpose(Register* __FF_OUT rows) {
+            const Register t0 = _mm256_unpacklo_ps(rows[0x0], rows[0x1]);
+            const Register t1 = _mm256_unpackhi_ps(rows[0x0], rows[0x1]);
+            const Register t2 = _mm256_unpacklo_ps(rows[0x2], rows[0x3]);
+            const Register t3 = _mm256_unpackhi_ps(rows[0x2], rows[0x3]);
+            const Register t4 = _mm256_unpacklo_ps(rows[0x4], rows[0x5]);
+            const Register t5 = _mm256_unpackhi_ps(rows[0x4], rows[0x5]);
+            const Register t6 = _mm256_unpacklo_ps(rows[0x6], rows[0x7]);
+            const Register t7 = _mm256_unpackhi_ps(rows[0x6], rows[0x7]);
+
+            const Register s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(0x1, 0x0, 0x1, 0x0));
+            const Register s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(0x3, 0x2, 0x3, 0x2));
+            const Register s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(0x1, 0x0, 0x1, 0x0));
+            const Register s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(0x3, 0x2, 0x3, 0x2));
+            const Register s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(0x1, 0x0, 0x1, 0x0));
+            const Register s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(0x3, 0x2, 0x3, 0x2));
+            const Register s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(0x1, 0x0, 0x1, 0x0));
+            const Register s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(0x3, 0x2, 0x3, 0x2));
+
+            rows[0x0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+            rows[0x1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+            rows[0x2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+            rows[0x3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+            rows[0x4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+            rows[0x5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+            rows[0x6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+            rows[0x7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+        }
+    };
+
+    template<>
+    struct SimdLane<double> {
+        using Register = __m256d;
+        static constexpr std::size_t WIDTH = 0x4;
+
+        static inline Register Load(const double* __FF_IN p)                  { return _mm256_loadu_pd(p); }
+        static inline void     Store(double* __FF_OUT p, const Register v)    { _mm256_storeu_pd(p, v); }
+        static inline Register Set(const double __FF_IN value)                { return _mm256_set1_pd(value); }
+        static inline Register Gather(const double* __FF_IN base, const std::uint32_t* __FF_IN index) {
+            return _mm256_mask_i32gather_pd( _mm256_setzero_pd(), base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(index)),
+                                             _mm256_castsi256_pd(_mm256_set1_epi64x(-0x1)), 0x8 );
+        }
+
+        static inline Register Add(const Register a, const Register b)        { return _mm256_add_pd(a, b); }
+        static inline Register Sub(const Register a, const Register b)        { return _mm256_sub_pd(a, b); }
+        static inline Register Mul(const Register a, const Register b)        { return _mm256_mul_pd(a, b); }
+        static inline Register Div(const Register a, const Register b)        { return _mm256_div_pd(a, b); }
+        static inline Register Sqrt(const Register a)                         { return _mm256_sqrt_pd(a); }
+        static inline Register Greater(const Register a, const Register b)    { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+        static inline Register And(const Register mask, const Register a)     { return _mm256_and_pd(mask, a); }
+        static inline Register Epsilon(void)                                  { return _mm256_set1_pd(FF::dEPSILON); }
+
+        static inline void     StoreHalf(double* __FF_OUT p, const Register v) { _mm_storeu_pd(p, _mm256_castpd256_pd128(v)); }
+        static inline void     Transpose(Register* __FF_OUT rows) {
+            const Register t0 = _mm256_unpacklo_pd(rows[0x0], rows[0x1]);
+            const Register t1 = _mm256_unpackhi_pd(rows[0x0], rows[0x1]);
+            const Register t2 = _mm256_unpacklo_pd(rows[0x2], rows[0x3]);
+            const Register t3 = _mm256_unpackhi_pd(rows[0x2], rows[0x3]);
+
+            rows[0x0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+            rows[0x1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+            rows[0x2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+            rows[0x3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+        }
+    };
+#else
+    template<>
+    struct SimdLane<float> {
+        using Register = __m128;
+        static constexpr std::size_t WIDTH = 0x4;
+
+        static inline Register Load(const float* __FF_IN p)                   { return _mm_loadu_ps(p); }
+        static inline void     Store(float* __FF_OUT p, const Register v)     { _mm_storeu_ps(p, v); }
+        static inline Register Set(const float __FF_IN value)                 { return _mm_set1_ps(value); }
+        static inline Register Gather(const float* __FF_IN base, const std::uint32_t* __FF_IN index) {
+            return _mm_set_ps(base[index[0x3]], base[index[0x2]], base[index[0x1]], base[index[0x0]]);
+        }
+
+        static inline Register Add(const Register a, const Register b)        { return _mm_add_ps(a, b); }
+        static inline Register Sub(const Register a, const Register b)        { return _mm_sub_ps(a, b); }
+        static inline Register Mul(const Register a, const Register b)        { return _mm_mul_ps(a, b); }
+        static inline Register Div(const Register a, const Register b)        { return _mm_div_ps(a, b); }
+        static inline Register Sqrt(const Register a)                         { return _mm_sqrt_ps(a); }
+        static inline Register Greater(const Register a, const Register b)    { return _mm_cmpgt_ps(a, b); }
+        static inline Register And(const Register mask, const Register a)     { return _mm_and_ps(mask, a); }
+        static inline Register Epsilon(void)                                  { return _mm_set1_ps(FF::fEPSILON); }
+
+        static inline void     StoreHalf(float* __FF_OUT p, const Register v) { _mm_storel_pi(reinterpret_cast<__m64*>(p), v); }
+        static inline void     Transpose(Register* __FF_OUT rows) {
+            _MM_TRANSPOSE4_PS(rows[0x0], rows[0x1], rows[0x2], rows[0x3]);
+        }
+    };
+
+    template<>
+    struct SimdLane<double> {
+        using Register = __m128d;
+        static constexpr std::size_t WIDTH = 0x2;
+
+        static inline Register Load(const double* __FF_IN p)                  { return _mm_loadu_pd(p); }
+        static inline void     Store(double* __FF_OUT p, const Register v)    { _mm_storeu_pd(p, v); }
+        static inline Register Set(const double __FF_IN value)                { return _mm_set1_pd(value); }
+        static inline Register Gather(const double* __FF_IN base, const std::uint32_t* __FF_IN index) {
+            return _mm_set_pd(base[index[0x1]], base[index[0x0]]);
+        }
+
+        static inline Register Add(const Register a, const Register b)        { return _mm_add_pd(a, b); }
+        static inline Register Sub(const Register a, const Register b)        { return _mm_sub_pd(a, b); }
+        static inline Register Mul(const Register a, const Register b)        { return _mm_mul_pd(a, b); }
+        static inline Register Div(const Register a, const Register b)        { return _mm_div_pd(a, b); }
+        static inline Register Sqrt(const Register a)                         { return _mm_sqrt_pd(a); }
+        static inline Register Greater(const Register a, const Register b)    { return _mm_cmpgt_pd(a, b); }
+        static inline Register And(const Register mask, const Register a)     { return _mm_and_pd(mask, a); }
+        static inline Register Epsilon(void)                                  { return _mm_set1_pd(FF::dEPSILON); }
+
+        static inline void     StoreHalf(double* __FF_OUT p, const Register v) { _mm_store_sd(p, v); }
+        static inline void     Transpose(Register* __FF_OUT rows) {
+            const Register t0 = _mm_unpacklo_pd(rows[0x0], rows[0x1]);
+            rows[0x1]         = _mm_unpackhi_pd(rows[0x0], rows[0x1]);
+            rows[0x0]         = t0;
+        }
+    };
+#endif
+
+    /**
+     * @brief   [SIMD kernels over arrays of three-dimensional vectors]
+     * @details [Process SimdLane<T>::WIDTH vectors per instruction, the tail is processed by ScalarVectorBatch]
+     *
+     * @tparam T [float or double]
+     */
+    template<typename T>
+    class SimdVectorBatch {
+    private:
+        using Lane     = FF::SimdLane<T>;
+        using Register = typename Lane::Register;
+    public:
+        explicit SimdVectorBatch(void) = delete;
+
+        static inline void Subtract( const T* __FF_IN  ax, const T* __FF_IN  ay, const T* __FF_IN  az,
+                                     const T* __FF_IN  bx, const T* __FF_IN  by, const T* __FF_IN  bz,
+                                     T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz,
+                                     const std::size_t __FF_IN count ){
+            std::size_t i = 0x0;
+            for (; i + Lane::WIDTH <= count; i += Lane::WIDTH) {
+                Lane::Store(ox + i, Lane::Sub(Lane::Load(ax + i), Lane::Load(bx + i)));
+                Lane::Store(oy + i, Lane::Sub(Lane::Load(ay + i), Lane::Load(by + i)));
+                Lane::Store(oz + i, Lane::Sub(Lane::Load(az + i), Lane::Load(bz + i)));
+            }
+            FF::ScalarVectorBatch<T>::Subtract(ax + i, ay + i, az + i, bx + i, by + i, bz + i, ox + i, oy + i, oz + i, count - i);
+        }
+
+        static inline void DotProduct( const T* __FF_IN  ax, const T* __FF_IN  ay, const T* __FF_IN  az,
+                                       const T* __FF_IN  bx, const T* __FF_IN  by, const T* __FF_IN  bz,
+                                       T*       __FF_OUT out,
+                                       const std::size_t __FF_IN count ){
+            std::size_t i = 0x0;
+            for (; i + Lane::WIDTH <= count; i += Lane::WIDTH) {
+                Register dot = Lane::Add(Lane::Mul(Lane::Load(ax + i), Lane::Load(bx + i)), Lane::Mul(Lane::Load(ay + i), Lane::Load(by + i)));
+                Lane::Store(out + i, Lane::Add(dot, Lane::Mul(Lane::Load(az + i), Lane::Load(bz + i))));
+            }
+            FF::ScalarVectorBatch<T>::DotProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i, count - i);
+        }
+
+        static inline void Magnitude( const T* __FF_IN  x, const T* __FF_IN y, const T* __FF_IN z,
+                                      T*       __FF_OUT out,
+                                      const std::size_t __FF_IN count ){
+            std::size_t i = 0x0;
+            for (; i + Lane::WIDTH <= count; i += Lane::WIDTH) {
+                Register vx = Lane::Load(x + i);
+                Register vy = Lane::Load(y + i);
+                Register vz = Lane::Load(z + i);
+
+                Lane::Store(out + i, Lane::Sqrt(Lane::Add(Lane::Add(Lane::Mul(vx, vx), Lane::Mul(vy, vy)), Lane::Mul(vz, vz))));
+            }
+            FF::ScalarVectorBatch<T>::Magnitude(x + i, y + i, z + i, out + i, count - i);
+        }
+
+        static inline void Normalize( const T* __FF_IN  x,  const T* __FF_IN  y,  const T* __FF_IN  z,
+                                      T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz,
+                                      const std::size_t __FF_IN count ){
+            const Register one     = Lane::Set(static_cast<T>(0x1));
+            const Register epsilon = Lane::Epsilon();
+
+            std::size_t i = 0x0;
+            for (; i + Lane::WIDTH <= count; i += Lane::WIDTH) {
+                Register vx = Lane::Load(x + i);
+                Register vy = Lane::Load(y + i);
+                Register vz = Lane::Load(z + i);
+
+                Register magnitude       = Lane::Sqrt(Lane::Add(Lane::Add(Lane::Mul(vx, vx), Lane::Mul(vy, vy)), Lane::Mul(vz, vz)));
+                Register invertMagnitude = Lane::And(Lane::Greater(magnitude, epsilon), Lane::Div(one, magnitude));
+
+                Lane::Store(ox + i, Lane::Mul(vx, invertMagnitude));
+                Lane::Store(oy + i, Lane::Mul(vy, invertMagnitude));
+                Lane::Store(oz + i, Lane::Mul(vz, invertMagnitude));
+            }
+            FF::ScalarVectorBatch<T>::Normalize(x + i, y + i, z + i, ox + i, oy + i, oz + i, count - i);
+        }
+
+        static inline void ScaleAccumulate( const T* __FF_IN  scale,
+                                            const T* __FF_IN  x,  const T* __FF_IN  y,  const T* __FF_IN  z,
+                                            T*       __FF_OUT ox, T*       __FF_OUT oy, T*       __FF_OUT oz,
+                                            const std::size_t __FF_IN count ){
+            std::size_t i = 0x0;
+            for (; i + Lane::WIDTH <= count; i += Lane::WIDTH) {
+                Register s = Lane::Load(scale + i);
+
+                Lane::Store(ox + i, Lane::Add(Lane::Load(ox + i), Lane::Mul(s, Lane::Load(x + i))));
+                Lane::Store(oy + i, Lane::Add(Lane::Load(oy + i), Lane::Mul(s, Lane::Load(y + i))));
+                Lane::Store(oz + i, Lane::Add(Lane::Load(oz + i), Lane::Mul(s, Lane::Load(z + i))));
+            }
+            FF::ScalarVectorBatch<T>::ScaleAccumulate(scale + i, x + i, y + i, z + i, ox + i, oy + i, oz + i, count - i);
+        }
+
+        ~SimdVectorBatch(void) = delete;
+    };
+#endif
+
+    /**
+     * @brief   [Kernels over arrays of three-dimensional vectors]
+     * @details [Scalar for generic type, SimdVectorBatch for float and double if SIMD is enabled]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    class VectorBatch : public FF::ScalarVectorBatch<T> {};
+
+#if defined(__FF_SIMD_AVX2) || defined(__FF_SIMD_SSE2)
+    template<>
+    class VectorBatch<float>  : public FF::SimdVectorBatch<float>  {};
+
+    template<>
+    class VectorBatch<double> : public FF::SimdVectorBatch<double> {};
+#endif
+};
+
+#endif // FF_VECTORBATCH_HXX_
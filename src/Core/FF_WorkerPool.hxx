@@ -0,0 +1,182 @@
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "FF_Macros.hxx"
+
+#ifndef FF_WORKERPOOL_HXX_
+#define FF_WORKERPOOL_HXX_
+
+namespace FF {
+    /**
+     * @brief   [Fixed pool of worker threads for data-parallel loops]
+     * @details [ParallelFor() splits range into one contiguous chunk per thread, chunk 0 is executed by
+     *           calling thread. Bounds of chunks depend only on range and thread count, so the loop
+     *           gives the same result for fixed thread count if chunks don't write to shared data]
+     */
+    class WorkerPool {
+    private:
+        using JobFunction = void (*)(void*, std::size_t);
+
+        std::vector<std::thread>          m_Workers;
+
+        std::mutex                        m_Mutex;
+        std::condition_variable           m_WakeCondition;
+        std::condition_variable           m_DoneCondition;
+
+        JobFunction                       m_Job;                // Trampoline that calls M_JOBDATA for one chunk
+        void*                             m_JobData;            // Chunk function on the stack of ParallelFor()
+        std::size_t                       m_PendingWorkers;
+        std::uint64_t                     m_Generation;
+        bool                              m_isStopping;
+
+        inline void WorkerLoop(const std::size_t __FF_IN chunk);
+
+        template<typename ChunkFunction>
+        static inline void CallChunk(void* __FF_IN chunkFunction, const std::size_t __FF_IN chunk);
+    public:
+        explicit WorkerPool(void) = delete;
+
+        /**
+         * @brief [Constructor with parameters]
+         * @details [Start THREADCOUNT - 1 workers, calling thread executes chunk 0]
+         *
+         * @param threadCount [Count of threads that execute every loop, must be positive]
+         */
+        explicit WorkerPool(const std::size_t __FF_IN threadCount);
+
+        WorkerPool(const FF::WorkerPool&)            = delete;
+        FF::WorkerPool& operator=(const FF::WorkerPool&) = delete;
+
+        inline std::size_t GetThreadCount(void) const;
+
+        inline std::size_t ChunkBegin(const std::size_t __FF_IN begin, const std::size_t __FF_IN end, const std::size_t __FF_IN chunk) const;
+
+        template<typename Function>
+        inline void ParallelFor(const std::size_t __FF_IN begin, const std::size_t __FF_IN end, Function __FF_IN function);
+
+        ~WorkerPool(void);
+    };
+
+    inline FF::WorkerPool::WorkerPool(const std::size_t __FF_IN threadCount)
+    : m_Job(nullptr),
+      m_JobData(nullptr),
+      m_PendingWorkers(0x0),
+      m_Generation(0x0),
+      m_isStopping(false) {
+        FF_ASSERT_MESSAGE(threadCount > 0x0, "Worker pool must have at least one thread!");
+
+        for (std::size_t i = 0x1; i < threadCount; i++) {
+            this->m_Workers.emplace_back(&FF::WorkerPool::WorkerLoop, this, i);
+        }
+    }
+
+    inline FF::WorkerPool::~WorkerPool(void){
+        {
+            std::lock_guard<std::mutex> lock(this->m_Mutex);
+            this->m_isStopping = true;
+        }
+        this->m_WakeCondition.notify_all();
+
+        for (std::thread& worker : this->m_Workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief [Method that get count of threads]
+     * @details [Workers and calling thread]
+     *
+     * @return [Return count of chunks of every loop]
+     */
+    inline std::size_t FF::WorkerPool::GetThreadCount(void) const {
+        return (this->m_Workers.size() + 0x1);
+    }
+
+    /**
+     * @brief [Method that find begin of chunk]
+     * @details [End of chunk is begin of next chunk, end of last chunk is END]
+     *
+     * @param begin [Begin of range]
+     * @param end [End of range]
+     * @param chunk [Index of chunk]
+     * @return [Return first index of chunk]
+     */
+    inline std::size_t FF::WorkerPool::ChunkBegin(const std::size_t __FF_IN begin, const std::size_t __FF_IN end, const std::size_t __FF_IN chunk) const {
+        return (begin + (end - begin) * chunk / this->GetThreadCount());
+    }
+
+    inline void FF::WorkerPool::WorkerLoop(const std::size_t __FF_IN chunk){
+        std::uint64_t seenGeneration = 0x0;
+
+        for (;;) {
+            std::unique_lock<std::mutex> lock(this->m_Mutex);
+            this->m_WakeCondition.wait(lock, [this, &seenGeneration]() {
+                return this->m_isStopping || this->m_Generation != seenGeneration;
+            });
+
+            if (this->m_isStopping) {
+                return;
+            }
+
+            seenGeneration = this->m_Generation;
+
+            const JobFunction job     = this->m_Job;
+            void*             jobData = this->m_JobData;
+            lock.unlock();
+
+            job(jobData, chunk);
+
+            lock.lock();
+            if (--this->m_PendingWorkers == 0x0) {
+                this->m_DoneCondition.notify_one();
+            }
+        }
+    }
+
+    template<typename ChunkFunction>
+    inline void FF::WorkerPool::CallChunk(void* __FF_IN chunkFunction, const std::size_t __FF_IN chunk){
+        (*static_cast<ChunkFunction*>(chunkFunction))(chunk);
+    }
+
+    /**
+     * @brief [Method that execute FUNCTION(chunkBegin, chunkEnd) for each chunk of [BEGIN, END)]
+     * @details [Return when all chunks are done. Must not be called from FUNCTION. Workers get pointer to
+     *           FUNCTION and typed trampoline, so nothing is copied or allocated per loop]
+     *
+     * @param begin [Begin of range]
+     * @param end [End of range]
+     * @param function [Function void(std::size_t, std::size_t)]
+     */
+    template<typename Function>
+    inline void FF::WorkerPool::ParallelFor(const std::size_t __FF_IN begin, const std::size_t __FF_IN end, Function __FF_IN function){
+        if (this->m_Workers.empty() || end <= begin) {
+            function(begin, end);
+            return;
+        }
+
+        auto chunkFunction = [this, begin, end, &function](std::size_t chunk) {
+            function(this->ChunkBegin(begin, end, chunk), this->ChunkBegin(begin, end, chunk + 0x1));
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(this->m_Mutex);
+            this->m_Job            = &FF::WorkerPool::CallChunk<decltype(chunkFunction)>;
+            this->m_JobData        = &chunkFunction;
+            this->m_PendingWorkers = this->m_Workers.size();
+            this->m_Generation++;
+        }
+        this->m_WakeCondition.notify_all();
+
+        chunkFunction(0x0);
+
+        std::unique_lock<std::mutex> lock(this->m_Mutex);
+        this->m_DoneCondition.wait(lock, [this]() {
+            return this->m_PendingWorkers == 0x0;
+        });
+    }
+};
+
+#endif // FF_WORKERPOOL_HXX_
@@ -1,4 +1,6 @@
-#include "..\..\Core\FF_Vector3.hxx"
+#include "../../Core/FF_CommonMath.hxx"
+
+#include "../../Core/FF_Vector3.hxx"
 
 #ifndef FF_AABB_HXX_
 #define FF_AABB_HXX_
@@ -12,46 +14,96 @@ namespace FF {
 	public:
 		explicit AABB(void) = delete;
 
-		explicit AABB( FF::Vector3<T>& __FF_IN vec1,
-					   FF::Vector3<T>& __FF_IN vec2 ) 
+		explicit AABB( const FF::Vector3<T>& __FF_IN vec1,
+					   const FF::Vector3<T>& __FF_IN vec2 ) 
 		: m_BottomBound(vec1), m_TopBound(vec2) {}
 
-		explicit AABB(FF::AABB<T> box);
+		AABB(const FF::AABB<T>& box) = default;
+		FF::AABB<T>& operator=(const FF::AABB<T>& box) = default;
 
-		inline FF::Vector3<T>& GetBottomBound(void) const;
-		inline FF::Vector3<T>& GetTopBound(void) const;
+		inline const FF::Vector3<T>& GetBottomBound(void) const;
+		inline const FF::Vector3<T>& GetTopBound(void) const;
 
-		inline void SetBottomBound(FF::Vector3<T>& __FF_IN vec);
-		inline void SetTopBound(FF::Vector3<T>& __FF_IN vec);	
+		inline void SetBottomBound(const FF::Vector3<T>& __FF_IN vec);
+		inline void SetTopBound(const FF::Vector3<T>& __FF_IN vec);	
 
 		~AABB(void) = default;	
 	};
 
 	template<typename T>
-	FF::AABB<T>::AABB(FF::AABB<T> box) {
-		this->m_BottomBound = box.GetBottomBound();
-		this->m_TopBound    = box.GetTopBound();
-	}
-
-	template<typename T>
-	inline FF::Vector3<T>& FF::AABB<T>::GetBottomBound(void) const {
+	inline const FF::Vector3<T>& FF::AABB<T>::GetBottomBound(void) const {
 		return this->m_BottomBound;
 	}
 
 	template<typename T>
-	inline FF::Vector3<T>& FF::AABB<T>::GetTopBound(void) const {
+	inline const FF::Vector3<T>& FF::AABB<T>::GetTopBound(void) const {
 		return this->m_TopBound;
 	}
 
 	template<typename T>
-	inline void FF::AABB<T>::SetBottomBound(FF::Vector3<T>& __FF_IN vec){
+	inline void FF::AABB<T>::SetBottomBound(const FF::Vector3<T>& __FF_IN vec){
 		this->m_BottomBound = vec;
 	}
 
 	template<typename T>
-	inline void FF::AABB<T>::SetTopBound(FF::Vector3<T>& __FF_IN vec){
+	inline void FF::AABB<T>::SetTopBound(const FF::Vector3<T>& __FF_IN vec){
 		this->m_TopBound = vec;
 	}
+
+	/**
+	 * @brief [Method that find the smallest AABB that contains both boxes]
+	 * @details [-]
+	 * 
+	 * @param first [First AABB]
+	 * @param second [Second AABB]
+	 * @tparam T [Generic type]
+	 * @return [Return union of boxes]
+	 */
+	template<typename T>
+	inline FF::AABB<T> Union(const FF::AABB<T>& __FF_IN first, const FF::AABB<T>& __FF_IN second){
+		return FF::AABB<T>( FF::Vector3<T>( FF::min(first.GetBottomBound().GetXComponent(), second.GetBottomBound().GetXComponent()),
+											FF::min(first.GetBottomBound().GetYComponent(), second.GetBottomBound().GetYComponent()),
+											FF::min(first.GetBottomBound().GetZComponent(), second.GetBottomBound().GetZComponent()) ),
+							FF::Vector3<T>( FF::max(first.GetTopBound().GetXComponent(), second.GetTopBound().GetXComponent()),
+											FF::max(first.GetTopBound().GetYComponent(), second.GetTopBound().GetYComponent()),
+											FF::max(first.GetTopBound().GetZComponent(), second.GetTopBound().GetZComponent()) ) );
+	}
+
+	/**
+	 * @brief [Method that check that INNER box lies inside OUTER box]
+	 * @details [-]
+	 * 
+	 * @param outer [Outer AABB]
+	 * @param inner [Inner AABB]
+	 * @tparam T [Generic type]
+	 * @return [Return true if INNER is inside OUTER]
+	 */
+	template<typename T>
+	inline bool Contains(const FF::AABB<T>& __FF_IN outer, const FF::AABB<T>& __FF_IN inner){
+		return outer.GetBottomBound().GetXComponent() <= inner.GetBottomBound().GetXComponent() &&
+			   outer.GetBottomBound().GetYComponent() <= inner.GetBottomBound().GetYComponent() &&
+			   outer.GetBottomBound().GetZComponent() <= inner.GetBottomBound().GetZComponent() &&
+			   inner.GetTopBound().GetXComponent()    <= outer.GetTopBound().GetXComponent()    &&
+			   inner.GetTopBound().GetYComponent()    <= outer.GetTopBound().GetYComponent()    &&
+			   inner.GetTopBound().GetZComponent()    <= outer.GetTopBound().GetZComponent();
+	}
+
+	/**
+	 * @brief [Method that calculate surface area of box]
+	 * @details [It is the cost of the box in surface area heuristic of bounding volume hierarchies]
+	 * 
+	 * @param box [AABB]
+	 * @tparam T [Generic type]
+	 * @return [Return area of six faces of box]
+	 */
+	template<typename T>
+	inline T SurfaceArea(const FF::AABB<T>& __FF_IN box){
+		const T width  = box.GetTopBound().GetXComponent() - box.GetBottomBound().GetXComponent();
+		const T height = box.GetTopBound().GetYComponent() - box.GetBottomBound().GetYComponent();
+		const T depth  = box.GetTopBound().GetZComponent() - box.GetBottomBound().GetZComponent();
+
+		return static_cast<T>(0x2) * (width * height + height * depth + depth * width);
+	}
 };
 
 #endif // FF_AABB_HXX_
\ No newline at end of file
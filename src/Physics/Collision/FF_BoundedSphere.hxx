@@ -1,4 +1,4 @@
-#include "..\..\Core\FF_Vector3.hxx"
+#include "../../Core/FF_Vector3.hxx"
 
 #ifndef FF_BOUNDEDSPHERE_HXX_
 #define FF_BOUNDEDSPHERE_HXX_
@@ -12,14 +12,15 @@ namespace FF {
 	public:
 		explicit BoundedSphere(void) = delete;
 
-		explicit BoundedSphere( FF::Vector3<T>& location, 
+		explicit BoundedSphere( const FF::Vector3<T>& location, 
 								T radius ) 
-		: m_Location(location), m_radius(radius) {}
+		: m_Radius(radius), m_Location(location) {}
 
-		explicit BoundedSphere(FF::BoundedSphere<T> sphere);
+		BoundedSphere(const FF::BoundedSphere<T>& sphere) = default;
+		FF::BoundedSphere<T>& operator=(const FF::BoundedSphere<T>& sphere) = default;
 
-		inline void     SetLocation(const FF::Vector3<T>& location);
-		inline const T& GetLocation(void) const;
+		inline void                  SetLocation(const FF::Vector3<T>& location);
+		inline const FF::Vector3<T>& GetLocation(void) const;
 
 		inline void     SetRadius(const T& radius);
 		inline const T& GetRadius(void) const;		
@@ -27,19 +28,13 @@ namespace FF {
 		~BoundedSphere(void) = default;	
 	};
 
-	template<typename T>
-	FF::BoundedSphere<T>::BoundedSphere(FF::BoundedSphere<T> sphere){
-		this->m_Location = sphere.GetLocation();
-		this->m_Radius   = sphere.GetRadius();
-	}
-
 	template<typename T>
 	inline void     FF::BoundedSphere<T>::SetLocation(const FF::Vector3<T>& location){
 		this->m_Location = location;
 	}
 
 	template<typename T>
-	inline const T& FF::BoundedSphere<T>::GetLocation(void) const {
+	inline const FF::Vector3<T>& FF::BoundedSphere<T>::GetLocation(void) const {
 		return this->m_Location;
 	}
 
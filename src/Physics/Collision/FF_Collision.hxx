@@ -1,6 +1,8 @@
-#include "..\..\Core\FF_CommonMath.hxx"
+#include <cmath>
 
-#include "..\..\Core\FF_Vector3.hxx"
+#include "../../Core/FF_CommonMath.hxx"
+
+#include "../../Core/FF_Vector3.hxx"
 
 #include "FF_AABB.hxx"
 #include "FF_BoundedSphere.hxx"
@@ -11,17 +13,89 @@
 namespace FF {
 	template<typename T>
 	class Collision {
+	private:
+		static inline const T AxisSquaredDistance(const T __FF_IN value, const T __FF_IN bottom, const T __FF_IN top);
+		static inline const bool ClipSlab( const T  __FF_IN    start,
+										   const T  __FF_IN    invert,
+										   const T  __FF_IN    bottom,
+										   const T  __FF_IN    top,
+										   T&       __FF_OUT   enter,
+										   T&       __FF_OUT   exit );
 	public:
 		explicit Collision(void) = default;
 
-		inline const bool AABBIntersectAABB(FF::AABB<T>& __FF_IN first, FF::AABB<T>& __FF_IN second) const;
-		inline const bool BSphereIntersectBSphere(FF::BoundedSphere<T>& __FF_IN first, FF::BoundedSphere<T>& __FF_IN second) const;
+		inline const bool AABBIntersectAABB(const FF::AABB<T>& __FF_IN first, const FF::AABB<T>& __FF_IN second) const;
+		inline const bool BSphereIntersectBSphere(const FF::BoundedSphere<T>& __FF_IN first, const FF::BoundedSphere<T>& __FF_IN second) const;
+		inline const bool BSphereIntersectAABB(const FF::BoundedSphere<T>& __FF_IN sphere, const FF::AABB<T>& __FF_IN box) const;
+		inline const bool RayIntersectAABB( const FF::Vector3<T>& __FF_IN origin,
+											const FF::Vector3<T>& __FF_IN invertDirection,
+											const T               __FF_IN maxDistance,
+											const FF::AABB<T>&    __FF_IN box ) const;
+		inline const bool RayIntersectBSphere( const FF::Vector3<T>&       __FF_IN  origin,
+											   const FF::Vector3<T>&       __FF_IN  direction,
+											   const FF::BoundedSphere<T>& __FF_IN  sphere,
+											   T&                          __FF_OUT distance ) const;
 
 		// inline const bool CheckCollision(const MaterialPoint<T>& firstObject, const MaterialPoint<T>& secondObject, const bool (*ReactionFunc)(void)) const;
 
 		~Collision(void) = default;	
 	};
 
+	/**
+	 * @brief [Method get squared distance from value to interval along one axis]
+	 * 
+	 * @param value [Component of point]
+	 * @param bottom [Component of bottom bound]
+	 * @param top [Component of top bound]
+	 * @tparam T [Generic type]
+	 * @return [Return zero if value lies in [BOTTOM, TOP], squared distance to the closest bound in another case]
+	 */
+	template<typename T>
+	inline const T FF::Collision<T>::AxisSquaredDistance(const T __FF_IN value, const T __FF_IN bottom, const T __FF_IN top){
+		if (value < bottom) {
+			return FF::sqr(bottom - value);
+		} else if (value > top) {
+			return FF::sqr(value - top);
+		}
+
+		return static_cast<T>(0x0);
+	}
+
+	/**
+	 * @brief [Method clip ray segment by slab of one axis]
+	 * @details [Ray parallel to slab gives NaN when origin lies on the plane, comparisons reject NaN]
+	 * 
+	 * @param start [Component of origin of ray]
+	 * @param invert [Component of 1 / direction of ray]
+	 * @param bottom [Component of bottom bound]
+	 * @param top [Component of top bound]
+	 * @param enter [Distance where segment enters the box, is raised by slab]
+	 * @param exit [Distance where segment exits the box, is lowered by slab]
+	 * @tparam T [Generic type]
+	 * @return [Return false if clipped segment is empty]
+	 */
+	template<typename T>
+	inline const bool FF::Collision<T>::ClipSlab( const T  __FF_IN    start,
+												  const T  __FF_IN    invert,
+												  const T  __FF_IN    bottom,
+												  const T  __FF_IN    top,
+												  T&       __FF_OUT   enter,
+												  T&       __FF_OUT   exit ){
+		T first  = (bottom - start) * invert;
+		T second = (top - start) * invert;
+
+		if (first > second) {
+			const T temp = first;
+			first  = second;
+			second = temp;
+		}
+
+		enter = (first > enter) ? first : enter;
+		exit  = (second < exit) ? second : exit;
+
+		return !(enter > exit);
+	}
+
 	/**
 	 * @brief [Simple checking to intersect AABB]
 	 * @details [Method check each component of two AABB by two base point]
@@ -31,7 +105,7 @@ namespace FF {
 	 * @return [Return true if AABB intersected and false in another case]
 	 */
 	template<typename T>
-	inline const bool AABBIntersectAABB(FF::AABB<T>& first, FF::AABB<T>& second) const {
+	inline const bool FF::Collision<T>::AABBIntersectAABB(const FF::AABB<T>& __FF_IN first, const FF::AABB<T>& __FF_IN second) const {
 		if (first.GetTopBound().GetXComponent() < second.GetBottomBound().GetXComponent() ||
 				second.GetTopBound().GetXComponent() < first.GetBottomBound().GetXComponent()) {
 			return false;
@@ -60,9 +134,94 @@ namespace FF {
 	 * @return [Return true if spheres intersected, and false in another case]
 	 */
 	template<typename T>
-	inline const bool BSphereIntersectBSphere(FF::BoundedSphere<T>& __FF_IN first, FF::BoundedSphere<T>& __FF_IN second) const {
+	inline const bool FF::Collision<T>::BSphereIntersectBSphere(const FF::BoundedSphere<T>& __FF_IN first, const FF::BoundedSphere<T>& __FF_IN second) const {
 		T sumRadius = first.GetRadius() + second.GetRadius();
-		return (FF::sqr(sumRadius) > FF::SquaredDistance(first, second));
+		return (FF::sqr(sumRadius) > FF::SquaredDistance(first.GetLocation(), second.GetLocation()));
+	}
+
+	/**
+	 * @brief [Method check the intersection of BoundedSphere and AABB]
+	 * @details [Distance from center of sphere to the closest point of box is compared with radius]
+	 * 
+	 * @param sphere [Sphere]
+	 * @param box [AABB]
+	 * @tparam T [Generic type]
+	 * @return [Return true if sphere and box intersected, and false in another case]
+	 */
+	template<typename T>
+	inline const bool FF::Collision<T>::BSphereIntersectAABB(const FF::BoundedSphere<T>& __FF_IN sphere, const FF::AABB<T>& __FF_IN box) const {
+		const FF::Vector3<T>& center = sphere.GetLocation();
+		const FF::Vector3<T>& bottom = box.GetBottomBound();
+		const FF::Vector3<T>& top    = box.GetTopBound();
+
+		const T distance = FF::Collision<T>::AxisSquaredDistance(center.GetXComponent(), bottom.GetXComponent(), top.GetXComponent()) +
+						   FF::Collision<T>::AxisSquaredDistance(center.GetYComponent(), bottom.GetYComponent(), top.GetYComponent()) +
+						   FF::Collision<T>::AxisSquaredDistance(center.GetZComponent(), bottom.GetZComponent(), top.GetZComponent());
+
+		return (distance <= FF::sqr(sphere.GetRadius()));
+	}
+
+	/**
+	 * @brief [Method check the intersection of ray segment and AABB]
+	 * @details [Slab test. Direction is passed inverted, so one ray is tested against many boxes without division.
+	 *           Infinite components of INVERTDIRECTION for zero components of direction are handled]
+	 * 
+	 * @param origin [Origin of ray]
+	 * @param invertDirection [1 / direction of ray per component]
+	 * @param maxDistance [Length of segment in units of direction]
+	 * @param box [AABB]
+	 * @tparam T [Generic type]
+	 * @return [Return true if segment [ORIGIN, ORIGIN + MAXDISTANCE * DIRECTION] intersects box]
+	 */
+	template<typename T>
+	inline const bool FF::Collision<T>::RayIntersectAABB( const FF::Vector3<T>& __FF_IN origin,
+														  const FF::Vector3<T>& __FF_IN invertDirection,
+														  const T               __FF_IN maxDistance,
+														  const FF::AABB<T>&    __FF_IN box ) const {
+		const FF::Vector3<T>& bottom = box.GetBottomBound();
+		const FF::Vector3<T>& top    = box.GetTopBound();
+
+		T enter = static_cast<T>(0x0);
+		T exit  = maxDistance;
+
+		return FF::Collision<T>::ClipSlab(origin.GetXComponent(), invertDirection.GetXComponent(), bottom.GetXComponent(), top.GetXComponent(), enter, exit) &&
+			   FF::Collision<T>::ClipSlab(origin.GetYComponent(), invertDirection.GetYComponent(), bottom.GetYComponent(), top.GetYComponent(), enter, exit) &&
+			   FF::Collision<T>::ClipSlab(origin.GetZComponent(), invertDirection.GetZComponent(), bottom.GetZComponent(), top.GetZComponent(), enter, exit);
+	}
+
+	/**
+	 * @brief [Method find the first intersection of ray and BoundedSphere]
+	 * @details [Ray that starts inside of sphere hits it at distance zero]
+	 * 
+	 * @param origin [Origin of ray]
+	 * @param direction [Normalized direction of ray]
+	 * @param sphere [Sphere]
+	 * @param distance [Distance from origin to hit point]
+	 * @tparam T [Generic type]
+	 * @return [Return true if ray hits sphere]
+	 */
+	template<typename T>
+	inline const bool FF::Collision<T>::RayIntersectBSphere( const FF::Vector3<T>&       __FF_IN  origin,
+															 const FF::Vector3<T>&       __FF_IN  direction,
+															 const FF::BoundedSphere<T>& __FF_IN  sphere,
+															 T&                          __FF_OUT distance ) const {
+		FF::Vector3<T> offset = origin - sphere.GetLocation();
+
+		const T projection = FF::DotProduct(offset, direction);
+		const T excess     = FF::DotProduct(offset, offset) - FF::sqr(sphere.GetRadius());
+
+		// Origin is outside and ray points away
+		if (excess > static_cast<T>(0x0) && projection > static_cast<T>(0x0)) {
+			return false;
+		}
+
+		const T discriminant = FF::sqr(projection) - excess;
+		if (discriminant < static_cast<T>(0x0)) {
+			return false;
+		}
+
+		distance = FF::max(static_cast<T>(0x0), -projection - std::sqrt(discriminant));
+		return true;
 	}
 
 	/*template<typename T>
@@ -0,0 +1,629 @@
+#include <cstdint>
+#include <vector>
+
+#include "../../Core/FF_Macros.hxx"
+#include "../../Core/FF_CommonMath.hxx"
+
+#include "../../Core/FF_Vector3.hxx"
+#include "FF_AABB.hxx"
+#include "FF_Collision.hxx"
+
+#ifndef FF_DYNAMICAABBTREE_HXX_
+#define FF_DYNAMICAABBTREE_HXX_
+
+namespace FF {
+	/**
+	 * @brief [Dynamic bounding volume hierarchy of AABB]
+	 * @details [Each object is a leaf (proxy) with enlarged ("fat") AABB. Object that moves inside its fat box
+	 *           doesn't change the tree, object that leaves it is removed and inserted again, so cost of
+	 *           update is proportional to count of objects that really moved. Leaves are inserted next to
+	 *           the sibling of the least surface area cost and the tree is kept balanced by rotations,
+	 *           queries and ray casts visit O(log N) nodes for small regions]
+	 *
+	 * @tparam T [Generic type]
+	 */
+	template<typename T>
+	class DynamicAABBTree {
+	public:
+		static constexpr std::int32_t NULL_NODE = -0x1;
+	private:
+		static constexpr std::size_t MAX_STACK_SIZE = 0x100;
+
+		struct Node {
+			FF::AABB<T>  m_Box;
+			std::size_t  m_UserData;
+			std::int32_t m_Parent;								// Next free node if node is free
+			std::int32_t m_FirstChild;							// NULL_NODE for leaves
+			std::int32_t m_SecondChild;
+			std::int32_t m_Height;								// Zero for leaves, -1 for free nodes
+
+			inline bool isLeaf(void) const { return this->m_FirstChild == NULL_NODE; }
+		};
+
+		// Stack of traversal, nodes above MAX_STACK_SIZE go to the heap, so any tree depth is handled
+		struct Stack {
+			std::int32_t              m_Buffer[MAX_STACK_SIZE];
+			std::vector<std::int32_t> m_Overflow;
+			std::size_t               m_Size = 0x0;
+
+			inline bool isEmpty(void) const { return this->m_Size == 0x0; }
+
+			inline void Push(const std::int32_t __FF_IN node){
+				if (this->m_Size < MAX_STACK_SIZE) {
+					this->m_Buffer[this->m_Size] = node;
+				} else {
+					this->m_Overflow.push_back(node);
+				}
+				this->m_Size++;
+			}
+
+			inline std::int32_t Pop(void){
+				this->m_Size--;
+				if (this->m_Size < MAX_STACK_SIZE) {
+					return this->m_Buffer[this->m_Size];
+				}
+
+				const std::int32_t node = this->m_Overflow.back();
+				this->m_Overflow.pop_back();
+				return node;
+			}
+		};
+
+		std::vector<Node> m_Nodes;
+		std::int32_t      m_Root;
+		std::int32_t      m_FreeList;
+		std::size_t       m_ProxyCount;
+		T                 m_Margin;
+
+		inline std::int32_t AllocateNode(const FF::AABB<T>& __FF_IN box);
+		inline void         FreeNode(const std::int32_t __FF_IN node);
+
+		inline void         InsertLeaf(const std::int32_t __FF_IN leaf);
+		inline void         RemoveLeaf(const std::int32_t __FF_IN leaf);
+		inline std::int32_t Balance(const std::int32_t __FF_IN node);
+		inline void         Refit(std::int32_t node);
+	public:
+		/**
+		 * @brief [Constructor with parameters]
+		 *
+		 * @param margin [Distance that fat AABB is enlarged by in each direction]
+		 */
+		explicit DynamicAABBTree(const T __FF_IN margin = static_cast<T>(0.1f));
+
+		inline std::int32_t CreateProxy(const FF::AABB<T>& __FF_IN box, const std::size_t __FF_IN userData);
+		inline void         DestroyProxy(const std::int32_t __FF_IN proxy);
+		inline bool         MoveProxy( const std::int32_t    __FF_IN proxy,
+									   const FF::AABB<T>&    __FF_IN box,
+									   const FF::Vector3<T>& __FF_IN displacement );
+
+		inline const FF::AABB<T>& GetFatAABB(const std::int32_t __FF_IN proxy) const;
+		inline std::size_t        GetUserData(const std::int32_t __FF_IN proxy) const;
+
+		inline std::size_t  GetProxyCount(void) const;
+		inline std::int32_t GetHeight(void) const;
+		inline std::int32_t GetMaxBalance(void) const;
+		inline bool         Validate(void) const;
+
+		template<typename Callback>
+		inline void Query(const FF::AABB<T>& __FF_IN box, Callback __FF_IN callback) const;
+
+		template<typename Callback>
+		inline void RayCast( const FF::Vector3<T>& __FF_IN origin,
+							 const FF::Vector3<T>& __FF_IN direction,
+							 const T               __FF_IN maxDistance,
+							 Callback              __FF_IN callback ) const;
+
+		~DynamicAABBTree(void) = default;
+	};
+
+	template<typename T>
+	FF::DynamicAABBTree<T>::DynamicAABBTree(const T __FF_IN margin)
+	: m_Root(NULL_NODE),
+	  m_FreeList(NULL_NODE),
+	  m_ProxyCount(0x0),
+	  m_Margin(margin) {}
+
+	template<typename T>
+	inline std::int32_t FF::DynamicAABBTree<T>::AllocateNode(const FF::AABB<T>& __FF_IN box){
+		std::int32_t node;
+
+		if (this->m_FreeList != NULL_NODE) {
+			node             = this->m_FreeList;
+			this->m_FreeList = this->m_Nodes[node].m_Parent;
+
+			this->m_Nodes[node].m_Box = box;
+		} else {
+			node = static_cast<std::int32_t>(this->m_Nodes.size());
+			this->m_Nodes.push_back(Node{ box, 0x0, NULL_NODE, NULL_NODE, NULL_NODE, 0x0 });
+		}
+
+		this->m_Nodes[node].m_UserData    = 0x0;
+		this->m_Nodes[node].m_Parent      = NULL_NODE;
+		this->m_Nodes[node].m_FirstChild  = NULL_NODE;
+		this->m_Nodes[node].m_SecondChild = NULL_NODE;
+		this->m_Nodes[node].m_Height      = 0x0;
+
+		return node;
+	}
+
+	template<typename T>
+	inline void FF::DynamicAABBTree<T>::FreeNode(const std::int32_t __FF_IN node){
+		this->m_Nodes[node].m_Parent = this->m_FreeList;
+		this->m_Nodes[node].m_Height = -0x1;
+		this->m_FreeList             = node;
+	}
+
+	/**
+	 * @brief [Method that add object to the tree]
+	 * @details [Stored box is BOX enlarged by margin]
+	 *
+	 * @param box [Tight AABB of object]
+	 * @param userData [Value returned by GetUserData(), e.g. index of object]
+	 * @tparam T [Generic type]
+	 * @return [Return proxy of object]
+	 */
+	template<typename T>
+	inline std::int32_t FF::DynamicAABBTree<T>::CreateProxy(const FF::AABB<T>& __FF_IN box, const std::size_t __FF_IN userData){
+		const FF::Vector3<T> margin(this->m_Margin, this->m_Margin, this->m_Margin);
+
+		const std::int32_t proxy = this->AllocateNode(FF::AABB<T>(box.GetBottomBound() - margin, box.GetTopBound() + margin));
+		this->m_Nodes[proxy].m_UserData = userData;
+
+		this->InsertLeaf(proxy);
+		this->m_ProxyCount++;
+
+		return proxy;
+	}
+
+	template<typename T>
+	inline void FF::DynamicAABBTree<T>::DestroyProxy(const std::int32_t __FF_IN proxy){
+		FF_ASSERT_MESSAGE(proxy >= 0x0 && static_cast<std::size_t>(proxy) < this->m_Nodes.size() && this->m_Nodes[proxy].isLeaf(), "Invalid proxy!");
+
+		this->RemoveLeaf(proxy);
+		this->FreeNode(proxy);
+		this->m_ProxyCount--;
+	}
+
+	/**
+	 * @brief [Method that update box of object]
+	 * @details [If BOX is still inside the fat box nothing is done. Otherwise the leaf is reinserted with
+	 *           box enlarged by margin and extended by DISPLACEMENT, that is the predicted movement of object]
+	 *
+	 * @param proxy [Proxy of object]
+	 * @param box [New tight AABB of object]
+	 * @param displacement [Predicted movement of object until next update]
+	 * @tparam T [Generic type]
+	 * @return [Return true if leaf is reinserted]
+	 */
+	template<typename T>
+	inline bool FF::DynamicAABBTree<T>::MoveProxy( const std::int32_t    __FF_IN proxy,
+												   const FF::AABB<T>&    __FF_IN box,
+												   const FF::Vector3<T>& __FF_IN displacement ){
+		FF_ASSERT_MESSAGE(proxy >= 0x0 && static_cast<std::size_t>(proxy) < this->m_Nodes.size() && this->m_Nodes[proxy].isLeaf(), "Invalid proxy!");
+
+		if (FF::Contains(this->m_Nodes[proxy].m_Box, box)) {
+			return false;
+		}
+
+		this->RemoveLeaf(proxy);
+
+		const FF::Vector3<T> margin(this->m_Margin, this->m_Margin, this->m_Margin);
+		FF::Vector3<T>       bottom = box.GetBottomBound() - margin;
+		FF::Vector3<T>       top    = box.GetTopBound() + margin;
+
+		// Extend the box in the direction of movement
+		bottom.SetXYZ( bottom.GetXComponent() + FF::min(displacement.GetXComponent(), static_cast<T>(0x0)),
+					   bottom.GetYComponent() + FF::min(displacement.GetYComponent(), static_cast<T>(0x0)),
+					   bottom.GetZComponent() + FF::min(displacement.GetZComponent(), static_cast<T>(0x0)) );
+		top.SetXYZ( top.GetXComponent() + FF::max(displacement.GetXComponent(), static_cast<T>(0x0)),
+					top.GetYComponent() + FF::max(displacement.GetYComponent(), static_cast<T>(0x0)),
+					top.GetZComponent() + FF::max(displacement.GetZComponent(), static_cast<T>(0x0)) );
+
+		this->m_Nodes[proxy].m_Box = FF::AABB<T>(bottom, top);
+		this->InsertLeaf(proxy);
+
+		return true;
+	}
+
+	template<typename T>
+	inline const FF::AABB<T>& FF::DynamicAABBTree<T>::GetFatAABB(const std::int32_t __FF_IN proxy) const {
+		return this->m_Nodes[proxy].m_Box;
+	}
+
+	template<typename T>
+	inline std::size_t FF::DynamicAABBTree<T>::GetUserData(const std::int32_t __FF_IN proxy) const {
+		return this->m_Nodes[proxy].m_UserData;
+	}
+
+	template<typename T>
+	inline std::size_t FF::DynamicAABBTree<T>::GetProxyCount(void) const {
+		return this->m_ProxyCount;
+	}
+
+	template<typename T>
+	inline std::int32_t FF::DynamicAABBTree<T>::GetHeight(void) const {
+		return (this->m_Root == NULL_NODE) ? 0x0 : this->m_Nodes[this->m_Root].m_Height;
+	}
+
+	/**
+	 * @brief [Method that get the largest difference of heights of two children]
+	 *
+	 * @tparam T [Generic type]
+	 * @return [Return zero for empty tree and for tree of one leaf]
+	 */
+	template<typename T>
+	inline std::int32_t FF::DynamicAABBTree<T>::GetMaxBalance(void) const {
+		std::int32_t maxBalance = 0x0;
+
+		for (const Node& node : this->m_Nodes) {
+			if (node.m_Height < 0x2) {
+				continue;
+			}
+
+			const std::int32_t balance = this->m_Nodes[node.m_FirstChild].m_Height - this->m_Nodes[node.m_SecondChild].m_Height;
+			maxBalance = FF::max(maxBalance, (balance < 0x0) ? -balance : balance);
+		}
+
+		return maxBalance;
+	}
+
+	/**
+	 * @brief [Method that check structure of the tree]
+	 * @details [Links of parents and children, heights and boxes of inner nodes are checked from the root,
+	 *           every node must be reached from the root or from the free list exactly once. Works in
+	 *           release builds, so tests can call it after each change of the tree]
+	 *
+	 * @tparam T [Generic type]
+	 * @return [Return true if the tree is consistent]
+	 */
+	template<typename T>
+	inline bool FF::DynamicAABBTree<T>::Validate(void) const {
+		std::size_t nodeCount = 0x0;
+		std::size_t leafCount = 0x0;
+
+		Stack stack;
+
+		if (this->m_Root != NULL_NODE) {
+			if (this->m_Nodes[this->m_Root].m_Parent != NULL_NODE) {
+				return false;
+			}
+
+			stack.Push(this->m_Root);
+		}
+
+		while (!stack.isEmpty()) {
+			const std::int32_t index = stack.Pop();
+			const Node&        node  = this->m_Nodes[index];
+
+			if (++nodeCount > this->m_Nodes.size()) {
+				return false;
+			}
+
+			if (node.isLeaf()) {
+				if (node.m_SecondChild != NULL_NODE || node.m_Height != 0x0) {
+					return false;
+				}
+
+				leafCount++;
+				continue;
+			}
+
+			const Node& first  = this->m_Nodes[node.m_FirstChild];
+			const Node& second = this->m_Nodes[node.m_SecondChild];
+
+			if (first.m_Parent != index || second.m_Parent != index ||
+					node.m_Height != 0x1 + FF::max(first.m_Height, second.m_Height) ||
+					!FF::Contains(node.m_Box, first.m_Box) || !FF::Contains(node.m_Box, second.m_Box)) {
+				return false;
+			}
+
+			stack.Push(node.m_FirstChild);
+			stack.Push(node.m_SecondChild);
+		}
+
+		for (std::int32_t index = this->m_FreeList; index != NULL_NODE; index = this->m_Nodes[index].m_Parent) {
+			if (this->m_Nodes[index].m_Height != -0x1 || ++nodeCount > this->m_Nodes.size()) {
+				return false;
+			}
+		}
+
+		return leafCount == this->m_ProxyCount && nodeCount == this->m_Nodes.size();
+	}
+
+	/**
+	 * @brief [Method that recalculate heights and boxes from NODE to the root]
+	 * @details [Nodes are balanced on the way]
+	 *
+	 * @param node [First node to refit]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T>
+	inline void FF::DynamicAABBTree<T>::Refit(std::int32_t node){
+		while (node != NULL_NODE) {
+			node = this->Balance(node);
+
+			const std::int32_t first  = this->m_Nodes[node].m_FirstChild;
+			const std::int32_t second = this->m_Nodes[node].m_SecondChild;
+
+			this->m_Nodes[node].m_Height = 0x1 + FF::max(this->m_Nodes[first].m_Height, this->m_Nodes[second].m_Height);
+			this->m_Nodes[node].m_Box    = FF::Union(this->m_Nodes[first].m_Box, this->m_Nodes[second].m_Box);
+
+			node = this->m_Nodes[node].m_Parent;
+		}
+	}
+
+	template<typename T>
+	inline void FF::DynamicAABBTree<T>::InsertLeaf(const std::int32_t __FF_IN leaf){
+		if (this->m_Root == NULL_NODE) {
+			this->m_Root                 = leaf;
+			this->m_Nodes[leaf].m_Parent = NULL_NODE;
+			return;
+		}
+
+		// Find the best sibling by surface area heuristic
+		std::int32_t index = this->m_Root;
+		while (!this->m_Nodes[index].isLeaf()) {
+			const FF::AABB<T>& leafBox = this->m_Nodes[leaf].m_Box;
+			const Node&        node    = this->m_Nodes[index];
+
+			const T area         = FF::SurfaceArea(node.m_Box);
+			const T combinedArea = FF::SurfaceArea(FF::Union(node.m_Box, leafBox));
+
+			// Cost of creating a new parent for this node and the new leaf
+			const T cost = static_cast<T>(0x2) * combinedArea;
+
+			// Minimum cost of pushing the leaf further down the tree
+			const T inheritanceCost = static_cast<T>(0x2) * (combinedArea - area);
+
+			const Node& first  = this->m_Nodes[node.m_FirstChild];
+			const Node& second = this->m_Nodes[node.m_SecondChild];
+
+			const T firstCost  = FF::SurfaceArea(FF::Union(first.m_Box, leafBox)) - (first.isLeaf() ? static_cast<T>(0x0) : FF::SurfaceArea(first.m_Box)) + inheritanceCost;
+			const T secondCost = FF::SurfaceArea(FF::Union(second.m_Box, leafBox)) - (second.isLeaf() ? static_cast<T>(0x0) : FF::SurfaceArea(second.m_Box)) + inheritanceCost;
+
+			if (cost < firstCost && cost < secondCost) {
+				break;
+			}
+
+			index = (firstCost < secondCost) ? node.m_FirstChild : node.m_SecondChild;
+		}
+
+		const std::int32_t sibling   = index;
+		const std::int32_t oldParent = this->m_Nodes[sibling].m_Parent;
+		const std::int32_t newParent = this->AllocateNode(FF::Union(this->m_Nodes[leaf].m_Box, this->m_Nodes[sibling].m_Box));
+
+		this->m_Nodes[newParent].m_Parent      = oldParent;
+		this->m_Nodes[newParent].m_FirstChild  = sibling;
+		this->m_Nodes[newParent].m_SecondChild = leaf;
+		this->m_Nodes[newParent].m_Height      = this->m_Nodes[sibling].m_Height + 0x1;
+
+		if (oldParent != NULL_NODE) {
+			if (this->m_Nodes[oldParent].m_FirstChild == sibling) {
+				this->m_Nodes[oldParent].m_FirstChild = newParent;
+			} else {
+				this->m_Nodes[oldParent].m_SecondChild = newParent;
+			}
+		} else {
+			this->m_Root = newParent;
+		}
+
+		this->m_Nodes[sibling].m_Parent = newParent;
+		this->m_Nodes[leaf].m_Parent    = newParent;
+
+		this->Refit(this->m_Nodes[leaf].m_Parent);
+	}
+
+	template<typename T>
+	inline void FF::DynamicAABBTree<T>::RemoveLeaf(const std::int32_t __FF_IN leaf){
+		if (leaf == this->m_Root) {
+			this->m_Root = NULL_NODE;
+			return;
+		}
+
+		const std::int32_t parent      = this->m_Nodes[leaf].m_Parent;
+		const std::int32_t grandParent = this->m_Nodes[parent].m_Parent;
+		const std::int32_t sibling     = (this->m_Nodes[parent].m_FirstChild == leaf) ? this->m_Nodes[parent].m_SecondChild : this->m_Nodes[parent].m_FirstChild;
+
+		// Sibling takes place of parent
+		if (grandParent != NULL_NODE) {
+			if (this->m_Nodes[grandParent].m_FirstChild == parent) {
+				this->m_Nodes[grandParent].m_FirstChild = sibling;
+			} else {
+				this->m_Nodes[grandParent].m_SecondChild = sibling;
+			}
+
+			this->m_Nodes[sibling].m_Parent = grandParent;
+			this->FreeNode(parent);
+
+			this->Refit(grandParent);
+		} else {
+			this->m_Root                    = sibling;
+			this->m_Nodes[sibling].m_Parent = NULL_NODE;
+			this->FreeNode(parent);
+		}
+	}
+
+	/**
+	 * @brief [Method that rotate subtree if heights of children differ by more than one]
+	 * @details [The higher child takes place of NODE]
+	 *
+	 * @param node [Root of subtree]
+	 * @tparam T [Generic type]
+	 * @return [Return new root of subtree]
+	 */
+	template<typename T>
+	inline std::int32_t FF::DynamicAABBTree<T>::Balance(const std::int32_t __FF_IN node){
+		const std::int32_t a = node;
+		if (this->m_Nodes[a].isLeaf() || this->m_Nodes[a].m_Height < 0x2) {
+			return a;
+		}
+
+		const std::int32_t b = this->m_Nodes[a].m_FirstChild;
+		const std::int32_t c = this->m_Nodes[a].m_SecondChild;
+
+		const std::int32_t balance = this->m_Nodes[c].m_Height - this->m_Nodes[b].m_Height;
+
+		// Rotate C up
+		if (balance > 0x1) {
+			const std::int32_t f = this->m_Nodes[c].m_FirstChild;
+			const std::int32_t g = this->m_Nodes[c].m_SecondChild;
+
+			this->m_Nodes[c].m_FirstChild = a;
+			this->m_Nodes[c].m_Parent     = this->m_Nodes[a].m_Parent;
+			this->m_Nodes[a].m_Parent     = c;
+
+			const std::int32_t parent = this->m_Nodes[c].m_Parent;
+			if (parent != NULL_NODE) {
+				if (this->m_Nodes[parent].m_FirstChild == a) {
+					this->m_Nodes[parent].m_FirstChild = c;
+				} else {
+					this->m_Nodes[parent].m_SecondChild = c;
+				}
+			} else {
+				this->m_Root = c;
+			}
+
+			// The higher grandchild stays under C, the lower one moves under A
+			const std::int32_t stay = (this->m_Nodes[f].m_Height > this->m_Nodes[g].m_Height) ? f : g;
+			const std::int32_t move = (stay == f) ? g : f;
+
+			this->m_Nodes[c].m_SecondChild = stay;
+			this->m_Nodes[a].m_SecondChild = move;
+			this->m_Nodes[move].m_Parent   = a;
+
+			this->m_Nodes[a].m_Box    = FF::Union(this->m_Nodes[b].m_Box, this->m_Nodes[move].m_Box);
+			this->m_Nodes[c].m_Box    = FF::Union(this->m_Nodes[a].m_Box, this->m_Nodes[stay].m_Box);
+			this->m_Nodes[a].m_Height = 0x1 + FF::max(this->m_Nodes[b].m_Height, this->m_Nodes[move].m_Height);
+			this->m_Nodes[c].m_Height = 0x1 + FF::max(this->m_Nodes[a].m_Height, this->m_Nodes[stay].m_Height);
+
+			return c;
+		}
+
+		// Rotate B up
+		if (balance < -0x1) {
+			const std::int32_t d = this->m_Nodes[b].m_FirstChild;
+			const std::int32_t e = this->m_Nodes[b].m_SecondChild;
+
+			this->m_Nodes[b].m_FirstChild = a;
+			this->m_Nodes[b].m_Parent     = this->m_Nodes[a].m_Parent;
+			this->m_Nodes[a].m_Parent     = b;
+
+			const std::int32_t parent = this->m_Nodes[b].m_Parent;
+			if (parent != NULL_NODE) {
+				if (this->m_Nodes[parent].m_FirstChild == a) {
+					this->m_Nodes[parent].m_FirstChild = b;
+				} else {
+					this->m_Nodes[parent].m_SecondChild = b;
+				}
+			} else {
+				this->m_Root = b;
+			}
+
+			const std::int32_t stay = (this->m_Nodes[d].m_Height > this->m_Nodes[e].m_Height) ? d : e;
+			const std::int32_t move = (stay == d) ? e : d;
+
+			this->m_Nodes[b].m_SecondChild = stay;
+			this->m_Nodes[a].m_FirstChild  = move;
+			this->m_Nodes[move].m_Parent   = a;
+
+			this->m_Nodes[a].m_Box    = FF::Union(this->m_Nodes[c].m_Box, this->m_Nodes[move].m_Box);
+			this->m_Nodes[b].m_Box    = FF::Union(this->m_Nodes[a].m_Box, this->m_Nodes[stay].m_Box);
+			this->m_Nodes[a].m_Height = 0x1 + FF::max(this->m_Nodes[c].m_Height, this->m_Nodes[move].m_Height);
+			this->m_Nodes[b].m_Height = 0x1 + FF::max(this->m_Nodes[a].m_Height, this->m_Nodes[stay].m_Height);
+
+			return b;
+		}
+
+		return a;
+	}
+
+	/**
+	 * @brief [Method that find all proxies which fat boxes overlap BOX]
+	 * @details [CALLBACK(proxy) is called for each found proxy, query stops when it returns false]
+	 *
+	 * @param box [AABB of query]
+	 * @param callback [Function bool(std::int32_t)]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T>
+	template<typename Callback>
+	inline void FF::DynamicAABBTree<T>::Query(const FF::AABB<T>& __FF_IN box, Callback __FF_IN callback) const {
+		const FF::Collision<T> collision;
+
+		Stack stack;
+
+		if (this->m_Root != NULL_NODE) {
+			stack.Push(this->m_Root);
+		}
+
+		while (!stack.isEmpty()) {
+			const std::int32_t index = stack.Pop();
+			const Node&        node  = this->m_Nodes[index];
+
+			if (!collision.AABBIntersectAABB(node.m_Box, box)) {
+				continue;
+			}
+
+			if (node.isLeaf()) {
+				if (!callback(index)) {
+					return;
+				}
+			} else {
+				stack.Push(node.m_FirstChild);
+				stack.Push(node.m_SecondChild);
+			}
+		}
+	}
+
+	/**
+	 * @brief [Method that find proxies which fat boxes are crossed by ray segment]
+	 * @details [CALLBACK(proxy, maxDistance) is called for each crossed proxy and returns new length of segment,
+	 *           so closest hit search clips the segment, zero length stops the ray cast]
+	 *
+	 * @param origin [Origin of ray]
+	 * @param direction [Normalized direction of ray]
+	 * @param maxDistance [Length of segment]
+	 * @param callback [Function T(std::int32_t, T)]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T>
+	template<typename Callback>
+	inline void FF::DynamicAABBTree<T>::RayCast( const FF::Vector3<T>& __FF_IN origin,
+												 const FF::Vector3<T>& __FF_IN direction,
+												 const T               __FF_IN maxDistance,
+												 Callback              __FF_IN callback ) const {
+		const FF::Collision<T> collision;
+		const FF::Vector3<T>   invertDirection( static_cast<T>(0x1) / direction.GetXComponent(),
+												static_cast<T>(0x1) / direction.GetYComponent(),
+												static_cast<T>(0x1) / direction.GetZComponent() );
+
+		T distance = maxDistance;
+
+		Stack stack;
+
+		if (this->m_Root != NULL_NODE) {
+			stack.Push(this->m_Root);
+		}
+
+		while (!stack.isEmpty()) {
+			const std::int32_t index = stack.Pop();
+			const Node&        node  = this->m_Nodes[index];
+
+			if (!collision.RayIntersectAABB(origin, invertDirection, distance, node.m_Box)) {
+				continue;
+			}
+
+			if (node.isLeaf()) {
+				distance = callback(index, distance);
+				if (distance <= static_cast<T>(0x0)) {
+					return;
+				}
+			} else {
+				stack.Push(node.m_FirstChild);
+				stack.Push(node.m_SecondChild);
+			}
+		}
+	}
+};
+
+#endif // FF_DYNAMICAABBTREE_HXX_
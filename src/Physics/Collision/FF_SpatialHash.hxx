@@ -0,0 +1,384 @@
+#include <cstdint>
+#include <vector>
+#include <cmath>
+
+#include "../../Core/FF_Macros.hxx"
+#include "../../Core/FF_CommonMath.hxx"
+
+#include "../../Core/FF_Vector3.hxx"
+
+#ifndef FF_SPATIALHASH_HXX_
+#define FF_SPATIALHASH_HXX_
+
+namespace FF {
+	/**
+	 * @brief [Pair of object indices produced by broad phase]
+	 * @details [Indices are the insertion order of objects, M_FIRST is always less than M_SECOND]
+	 */
+	struct CollisionPair {
+		std::size_t m_First;
+		std::size_t m_Second;
+	};
+
+	/**
+	 * @brief [Uniform grid broad phase for bounded spheres]
+	 * @details [Objects are hashed by the cell that contains their center. The cell size is
+	 *           taken not less than the largest sphere diameter, so every overlapping pair
+	 *           lies in the same or in adjacent cells. Pairs are searched in the own cell and in 13 forward
+	 *           adjacent cells of each object, the other 13 cells are forward ones for their objects.
+	 *           The grid is rebuilt from scratch every step by counting sort, thus the cost
+	 *           of Build() and QueryPairs() grows linearly with the number of objects. Objects with
+	 *           non-finite center are left out of the grid, so cloth that blows up doesn't break the query]
+	 *
+	 * @tparam T [Generic type]
+	 */
+	template<typename T>
+	class SpatialHash {
+	private:
+		T                        m_CellSize;
+		T                        m_InvertCellSize;
+		T                        m_MaxRadius;
+
+		std::size_t              m_TableMask;
+
+		std::vector<T>           m_X;
+		std::vector<T>           m_Y;
+		std::vector<T>           m_Z;
+		std::vector<T>           m_Radius;
+
+		std::vector<std::int32_t> m_CellX;
+		std::vector<std::int32_t> m_CellY;
+		std::vector<std::int32_t> m_CellZ;
+		std::vector<std::uint8_t> m_isFinite;
+
+		std::vector<std::size_t> m_CellStart;
+		std::vector<std::size_t> m_CellEntries;
+
+		inline std::int32_t CellCoordinate(const T __FF_IN value) const;
+		inline std::size_t  HashCell(const std::int32_t __FF_IN x, const std::int32_t __FF_IN y, const std::int32_t __FF_IN z) const;
+	public:
+		explicit SpatialHash(void) = delete;
+
+		/**
+		 * @brief [Constructor with parameters]
+		 * @details [Reserve the memory for EXPECTEDOBJECTS objects]
+		 *
+		 * @param minCellSize [Lower bound of cell size, real cell size also depends on the largest inserted radius]
+		 * @param expectedObjects [Count of objects that expected to be inserted every step]
+		 */
+		explicit SpatialHash( const T           __FF_IN minCellSize,
+							  const std::size_t __FF_IN expectedObjects = 0x0 );
+
+		inline const T           GetCellSize(void) const;
+		inline const std::size_t GetObjectCount(void) const;
+
+		inline void Clear(void);
+		inline void Insert(const FF::Vector3<T>& __FF_IN location, const T __FF_IN radius);
+		inline void Build(void);
+
+		template<typename SkipPredicate>
+		inline void QueryPairs(std::vector<FF::CollisionPair>& __FF_OUT pairs, SkipPredicate __FF_IN skip) const;
+		inline void QueryPairs(std::vector<FF::CollisionPair>& __FF_OUT pairs) const;
+
+		template<typename Callback>
+		inline void QuerySphere(const FF::Vector3<T>& __FF_IN location, const T __FF_IN radius, Callback __FF_IN callback) const;
+
+		~SpatialHash(void) = default;
+	};
+
+	template<typename T>
+	FF::SpatialHash<T>::SpatialHash( const T           __FF_IN minCellSize,
+									 const std::size_t __FF_IN expectedObjects )
+	: m_CellSize(minCellSize),
+	  m_InvertCellSize(static_cast<T>(0x1) / minCellSize),
+	  m_MaxRadius(static_cast<T>(0x0)),
+	  m_TableMask(0x0) {
+		FF_ASSERT_MESSAGE(minCellSize > static_cast<T>(0x0), "Cell size of spatial hash must be positive!");
+
+		this->m_X.reserve(expectedObjects);
+		this->m_Y.reserve(expectedObjects);
+		this->m_Z.reserve(expectedObjects);
+		this->m_Radius.reserve(expectedObjects);
+		this->m_CellX.reserve(expectedObjects);
+		this->m_CellY.reserve(expectedObjects);
+		this->m_CellZ.reserve(expectedObjects);
+		this->m_isFinite.reserve(expectedObjects);
+		this->m_CellEntries.reserve(expectedObjects);
+	}
+
+	/**
+	 * @brief [Method that get current cell size]
+	 * @details [Valid after Build()]
+	 *
+	 * @tparam T [Generic type]
+	 * @return [Return edge length of one cell]
+	 */
+	template<typename T>
+	inline const T FF::SpatialHash<T>::GetCellSize(void) const {
+		return this->m_CellSize;
+	}
+
+	template<typename T>
+	inline const std::size_t FF::SpatialHash<T>::GetObjectCount(void) const {
+		return this->m_X.size();
+	}
+
+	/**
+	 * @brief [Method that remove all objects from the grid]
+	 * @details [Memory is not released, so rebuild every step doesn't allocate]
+	 *
+	 * @tparam T [Generic type]
+	 */
+	template<typename T>
+	inline void FF::SpatialHash<T>::Clear(void){
+		this->m_X.clear();
+		this->m_Y.clear();
+		this->m_Z.clear();
+		this->m_Radius.clear();
+		this->m_MaxRadius = static_cast<T>(0x0);
+	}
+
+	/**
+	 * @brief [Method that add bounded sphere to the grid]
+	 * @details [Index of object is the count of objects inserted before it since last Clear()]
+	 *
+	 * @param location [Center of sphere]
+	 * @param radius [Radius of sphere]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T>
+	inline void FF::SpatialHash<T>::Insert(const FF::Vector3<T>& __FF_IN location, const T __FF_IN radius){
+		this->m_X.push_back(location.GetXComponent());
+		this->m_Y.push_back(location.GetYComponent());
+		this->m_Z.push_back(location.GetZComponent());
+		this->m_Radius.push_back(radius);
+
+		this->m_MaxRadius = FF::max(this->m_MaxRadius, radius);
+	}
+
+	/**
+	 * @brief [Method that find cell of coordinate]
+	 * @details [Cells beyond +-2^30 are merged into the border cell, so conversion to integer is defined
+	 *           for any value and coordinate of adjacent cell can't overflow]
+	 *
+	 * @param value [Coordinate]
+	 * @tparam T [Generic type]
+	 * @return [Return index of cell along one axis]
+	 */
+	template<typename T>
+	inline std::int32_t FF::SpatialHash<T>::CellCoordinate(const T __FF_IN value) const {
+		constexpr std::int32_t MAX_CELL = 0x40000000;
+
+		const T cell = std::floor(value * this->m_InvertCellSize);
+		if (!(cell > static_cast<T>(-MAX_CELL))) {
+			return -MAX_CELL;
+		}
+		if (!(cell < static_cast<T>(MAX_CELL))) {
+			return MAX_CELL;
+		}
+
+		return static_cast<std::int32_t>(cell);
+	}
+
+	template<typename T>
+	inline std::size_t FF::SpatialHash<T>::HashCell(const std::int32_t __FF_IN x, const std::int32_t __FF_IN y, const std::int32_t __FF_IN z) const {
+		// Large primes from "Optimized Spatial Hashing for Collision Detection of Deformable Objects"
+		const std::uint32_t hash = (static_cast<std::uint32_t>(x) * 92837111u) ^
+								   (static_cast<std::uint32_t>(y) * 689287499u) ^
+								   (static_cast<std::uint32_t>(z) * 283923481u);
+
+		return (static_cast<std::size_t>(hash) & this->m_TableMask);
+	}
+
+	/**
+	 * @brief [Method that sort inserted objects by cells]
+	 * @details [Must be called after the last Insert() and before QueryPairs(). Objects with NaN or
+	 *           infinite coordinate are not put into cells and are never reported]
+	 *
+	 * @tparam T [Generic type]
+	 */
+	template<typename T>
+	inline void FF::SpatialHash<T>::Build(void){
+		const std::size_t count = this->m_X.size();
+
+		// The cell must contain the largest sphere, otherwise overlapping pair can skip adjacent cell
+		const T minCellSize = static_cast<T>(0x2) * this->m_MaxRadius;
+		if (this->m_CellSize < minCellSize) {
+			this->m_CellSize       = minCellSize;
+			this->m_InvertCellSize = static_cast<T>(0x1) / minCellSize;
+		}
+
+		std::size_t tableSize = 0x1;
+		while (tableSize < (count << 0x1)) {
+			tableSize <<= 0x1;
+		}
+		this->m_TableMask = tableSize - 0x1;
+
+		this->m_CellX.resize(count);
+		this->m_CellY.resize(count);
+		this->m_CellZ.resize(count);
+		this->m_isFinite.resize(count);
+		this->m_CellStart.assign(tableSize + 0x1, 0x0);
+
+		std::size_t finiteCount = 0x0;
+		for (std::size_t i = 0x0; i < count; i++) {
+			this->m_isFinite[i] = (std::isfinite(this->m_X[i]) && std::isfinite(this->m_Y[i]) && std::isfinite(this->m_Z[i])) ? 0x1 : 0x0;
+			if (!this->m_isFinite[i]) {
+				continue;
+			}
+
+			this->m_CellX[i] = this->CellCoordinate(this->m_X[i]);
+			this->m_CellY[i] = this->CellCoordinate(this->m_Y[i]);
+			this->m_CellZ[i] = this->CellCoordinate(this->m_Z[i]);
+
+			this->m_CellStart[this->HashCell(this->m_CellX[i], this->m_CellY[i], this->m_CellZ[i])]++;
+			finiteCount++;
+		}
+		this->m_CellEntries.resize(finiteCount);
+
+		// Prefix sum: M_CELLSTART[h] is the end of bucket H, then it is moved back to its begin
+		for (std::size_t h = 0x1; h <= tableSize; h++) {
+			this->m_CellStart[h] += this->m_CellStart[h - 0x1];
+		}
+
+		for (std::size_t i = count; i-- > 0x0; ) {
+			if (!this->m_isFinite[i]) {
+				continue;
+			}
+
+			const std::size_t h = this->HashCell(this->m_CellX[i], this->m_CellY[i], this->m_CellZ[i]);
+			this->m_CellEntries[--this->m_CellStart[h]] = i;
+		}
+	}
+
+	/**
+	 * @brief [Method that find all pairs of overlapping spheres]
+	 * @details [Each pair reported once. Pairs for which SKIP(first, second) return true are not reported,
+	 *           it is used to exclude objects that connected by joints or springs]
+	 *
+	 * @param pairs [Output buffer, new pairs are appended to it]
+	 * @param skip [Predicate bool(std::size_t, std::size_t)]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T>
+	template<typename SkipPredicate>
+	inline void FF::SpatialHash<T>::QueryPairs(std::vector<FF::CollisionPair>& __FF_OUT pairs, SkipPredicate __FF_IN skip) const {
+		const std::size_t count = this->m_X.size();
+		FF_ASSERT_MESSAGE(this->m_isFinite.size() == count, "SpatialHash::Build() must be called before query!");
+
+		// Own cell and cells with greater (x, y, z) in lexicographic order, every pair of cells is visited once
+		constexpr std::int32_t CELL_OFFSETS[0xE][0x3] = {
+			{ 0x0, 0x0, 0x0 },
+			{ 0x0, 0x0, 0x1 },
+			{ 0x0, 0x1, -0x1 }, { 0x0, 0x1, 0x0 }, { 0x0, 0x1, 0x1 },
+			{ 0x1, -0x1, -0x1 }, { 0x1, -0x1, 0x0 }, { 0x1, -0x1, 0x1 },
+			{ 0x1, 0x0, -0x1 },  { 0x1, 0x0, 0x0 },  { 0x1, 0x0, 0x1 },
+			{ 0x1, 0x1, -0x1 },  { 0x1, 0x1, 0x0 },  { 0x1, 0x1, 0x1 }
+		};
+
+		for (std::size_t i = 0x0; i < count; i++) {
+			if (!this->m_isFinite[i]) {
+				continue;
+			}
+
+			for (std::size_t c = 0x0; c < 0xE; c++) {
+				const std::int32_t cellX = this->m_CellX[i] + CELL_OFFSETS[c][0x0];
+				const std::int32_t cellY = this->m_CellY[i] + CELL_OFFSETS[c][0x1];
+				const std::int32_t cellZ = this->m_CellZ[i] + CELL_OFFSETS[c][0x2];
+
+				const std::size_t bucket = this->HashCell(cellX, cellY, cellZ);
+				const std::size_t end    = this->m_CellStart[bucket + 0x1];
+
+				for (std::size_t e = this->m_CellStart[bucket]; e < end; e++) {
+					const std::size_t j = this->m_CellEntries[e];
+
+					// Different cells can share one bucket, so object is accepted only from its own cell.
+					// In the own cell pair is taken by the object with less index
+					if ((c == 0x0 && j <= i) || this->m_CellX[j] != cellX || this->m_CellY[j] != cellY || this->m_CellZ[j] != cellZ) {
+						continue;
+					}
+
+					const T minDistance     = this->m_Radius[i] + this->m_Radius[j];
+					const T distanceSquared = FF::sqr(this->m_X[i] - this->m_X[j]) +
+											  FF::sqr(this->m_Y[i] - this->m_Y[j]) +
+											  FF::sqr(this->m_Z[i] - this->m_Z[j]);
+
+					const std::size_t first  = FF::min(i, j);
+					const std::size_t second = FF::max(i, j);
+
+					if (distanceSquared < FF::sqr(minDistance) && !skip(first, second)) {
+						pairs.push_back(FF::CollisionPair{ first, second });
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief [Method that find all pairs of overlapping spheres]
+	 * @details [Same as QueryPairs with predicate, but nothing is skipped]
+	 *
+	 * @param pairs [Output buffer, new pairs are appended to it]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T>
+	inline void FF::SpatialHash<T>::QueryPairs(std::vector<FF::CollisionPair>& __FF_OUT pairs) const {
+		this->QueryPairs(pairs, [](std::size_t, std::size_t) { return false; });
+	}
+
+	/**
+	 * @brief [Method that find all objects which overlap sphere]
+	 * @details [Sphere isn't inserted into the grid, CALLBACK(index) is called for each found object.
+	 *           Diameter of sphere must not exceed the cell size]
+	 *
+	 * @param location [Center of sphere]
+	 * @param radius [Radius of sphere]
+	 * @param callback [Function void(std::size_t)]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T>
+	template<typename Callback>
+	inline void FF::SpatialHash<T>::QuerySphere(const FF::Vector3<T>& __FF_IN location, const T __FF_IN radius, Callback __FF_IN callback) const {
+		FF_ASSERT_MESSAGE(this->m_isFinite.size() == this->m_X.size(), "SpatialHash::Build() must be called before query!");
+		FF_ASSERT_MESSAGE(static_cast<T>(0x2) * radius <= this->m_CellSize, "Sphere of query is larger than cell!");
+
+		if (this->m_CellEntries.empty()) {
+			return;
+		}
+
+		const std::int32_t centerX = this->CellCoordinate(location.GetXComponent());
+		const std::int32_t centerY = this->CellCoordinate(location.GetYComponent());
+		const std::int32_t centerZ = this->CellCoordinate(location.GetZComponent());
+
+		for (std::int32_t dx = -0x1; dx <= 0x1; dx++) {
+			for (std::int32_t dy = -0x1; dy <= 0x1; dy++) {
+				for (std::int32_t dz = -0x1; dz <= 0x1; dz++) {
+					const std::int32_t cellX = centerX + dx;
+					const std::int32_t cellY = centerY + dy;
+					const std::int32_t cellZ = centerZ + dz;
+
+					const std::size_t bucket = this->HashCell(cellX, cellY, cellZ);
+					const std::size_t end    = this->m_CellStart[bucket + 0x1];
+
+					for (std::size_t e = this->m_CellStart[bucket]; e < end; e++) {
+						const std::size_t j = this->m_CellEntries[e];
+
+						if (this->m_CellX[j] != cellX || this->m_CellY[j] != cellY || this->m_CellZ[j] != cellZ) {
+							continue;
+						}
+
+						const T distanceSquared = FF::sqr(location.GetXComponent() - this->m_X[j]) +
+												  FF::sqr(location.GetYComponent() - this->m_Y[j]) +
+												  FF::sqr(location.GetZComponent() - this->m_Z[j]);
+
+						if (distanceSquared < FF::sqr(radius + this->m_Radius[j])) {
+							callback(j);
+						}
+					}
+				}
+			}
+		}
+	}
+};
+
+#endif // FF_SPATIALHASH_HXX_
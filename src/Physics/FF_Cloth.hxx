@@ -1,9 +1,17 @@
-#include "..\Core\FF_Macros.hxx"
-#include "..\Core\FF_CommonMath.hxx"
+#include <vector>
+#include <memory>
+#include <algorithm>
 
-#include "..\Core\FF_Vector3.hxx"
-#include "FF_Spring.hxx"
-#include "FF_MaterialPointBase.hxx"
+#include "../Core/FF_Macros.hxx"
+#include "../Core/FF_CommonMath.hxx"
+
+#include "../Core/FF_Vector3.hxx"
+#include "../Core/FF_WorkerPool.hxx"
+#include "../Core/FF_Profiler.hxx"
+#include "FF_ClothState.hxx"
+#include "FF_Integrators.hxx"
+#include "FF_XPBD.hxx"
+#include "Collision/FF_SpatialHash.hxx"
 
 #ifndef FF_CLOTH_HXX_
 #define FF_CLOTH_HXX_
@@ -24,7 +32,9 @@ namespace FF {
         FF_RIGHT_SPRING                    = 0x2,
         FF_LEFT_SPRING                     = 0x3,
         FF_TOP_RIGHT_TO_BOTTOM_LEFT_SPRING = 0x4,
-        FF_TOP_LEFT_TO_BOTTOM_RIGHT_SPRING = 0x5
+        FF_TOP_LEFT_TO_BOTTOM_RIGHT_SPRING = 0x5,
+
+        FF_SLEEP_TILE_SIZE                 = 0x8
     };
 
     struct IndexPair {
@@ -37,23 +47,88 @@ namespace FF {
         std::size_t   m_SpringIndex[FF::CLOTH_CONSTANTS::FF_SPRINGS_PER_SQUARE]; 
     };
 
-    template<typename T>
+    /**
+     * @brief   [Mass-spring cloth]
+     * @details [Particles are connected by structural and shear springs and collide with each other.
+     *           Particles are grouped into FF_SLEEP_TILE_SIZE x FF_SLEEP_TILE_SIZE tiles that fall asleep when
+     *           speed of all their particles stays below sleep velocity for sleep step count of steps.
+     *           Sleeping particles are neither integrated nor put into broad phase, particles of sleeping
+     *           tile that are joined by springs to awake particles are taken into update as static ones.
+     *           Tile wakes up on impulse force, on contact with awake particle and when awake particle joined
+     *           to it by spring moves. Sleeping is disabled until positive sleep velocity is set]
+     *
+     * @tparam T [Generic type]
+     * @tparam Integrator [Cloth integrator from FF_Integrators.hxx or FF::XPBD for position based solver]
+     */
+    template<typename T, typename Integrator = FF::SymplecticEuler<T>>
     class Cloth {
     private:
-        std::size_t                m_TotalRows;
-        std::size_t                m_TotalColumns;
-        std::size_t                m_TotalSprings;
+        std::size_t                    m_TotalRows;
+        std::size_t                    m_TotalColumns;
+        std::size_t                    m_TotalSprings;
+
+        FF::ClothState<T>              m_State;
+        FF::ClothSprings<T>            m_Springs;
+        std::vector<FF::ClothSquare>   m_Squares;
+
+        T                              m_ParticleRadius;
+        T                              m_ParticleRestitution;
+        T                              m_LinearDampeningCoefficient;
+
+        FF::SpatialHash<T>             m_BroadPhase;
+        std::vector<FF::CollisionPair> m_CollisionPairs;
+
+        T                              m_BroadPhaseMargin;
+        bool                           m_isBroadPhaseDirty;
+        bool                           m_isBroadPhasePartial;
+        std::vector<FF::CollisionPair> m_CandidatePairs;        // Pairs closer than diameter + 2 * M_BROADPHASEMARGIN at rebuild
+        std::vector<T>                 m_BroadPhaseX;           // Locations at rebuild
+        std::vector<T>                 m_BroadPhaseY;
+        std::vector<T>                 m_BroadPhaseZ;
+
+        std::unique_ptr<FF::WorkerPool> m_WorkerPool;
+
+        Integrator                     m_Integrator;
+
+        T                              m_SleepVelocity;
+        std::size_t                    m_SleepStepCount;
 
-        FF::MaterialPointBase<T>** m_Particles;
-        FF::Spring<T>*             m_Springs;
-        FF::ClothSquare**          m_Squares;
+        std::size_t                    m_TileRows;
+        std::size_t                    m_TileColumns;
+        std::size_t                    m_AwakeTileCount;
+        std::vector<std::uint8_t>      m_isTileAwake;
+        std::vector<std::uint8_t>      m_isTileMoving;
+        std::vector<std::size_t>       m_TileSleepCounter;
 
-        T                          m_LinearDampeningCoefficient;
+        bool                           m_isActiveSetDirty;
+        std::size_t                    m_AwakeParticleCount;
+        std::vector<std::size_t>       m_ActiveParticles;       // Index in M_ACTIVESTATE -> index in M_STATE, awake particles go first
+        std::vector<std::size_t>       m_ActiveIndex;           // Index in M_STATE -> index in M_ACTIVESTATE
+        FF::ClothState<T>              m_ActiveState;
+        FF::ClothSprings<T>            m_ActiveSprings;
 
-        inline void HandleCollision( FF::Vector3<T> separationDistance,
-                                     T              changeInTime,
-                                     FF::IndexPair  firstParticle,
-                                     FF::IndexPair  secondParticle );
+        FF::SpatialHash<T>             m_SleepingBroadPhase;
+        std::vector<std::size_t>       m_SleepingParticles;
+
+        template<typename Function>
+        inline void ParallelFor(std::size_t begin, std::size_t end, Function function);
+
+        inline std::size_t   FlatIndex(std::size_t row, std::size_t column) const;
+        inline FF::IndexPair ParticleIndex(std::size_t flatIndex) const;
+        inline bool          isSpringConnected(std::size_t firstParticle, std::size_t secondParticle) const;
+
+        inline std::size_t TileIndex(std::size_t flatIndex) const;
+        inline void        WakeTile(std::size_t tile);
+        inline void        RebuildActiveSet(void);
+        inline void        UpdateSleep(const FF::ClothState<T>& state, const FF::ClothSprings<T>& springs, bool isPartial);
+
+        inline bool isBroadPhaseOutdated(const FF::ClothState<T>& state, bool isPartial) const;
+        inline void RebuildBroadPhase(const FF::ClothState<T>& state, bool isPartial);
+
+        inline void HandleCollision( FF::ClothState<T>&    state,
+                                     const FF::Vector3<T>& separationDistance,
+                                     std::size_t           firstParticle,
+                                     std::size_t           secondParticle );
     public:
         explicit Cloth(void) = delete;
 
@@ -73,13 +148,37 @@ namespace FF {
         inline void           SetParticleConstantForce(std::size_t row, std::size_t column, const FF::Vector3<T>& constantForce);
         inline FF::Vector3<T> GetParticleConstantForce(std::size_t row, std::size_t column);
 
+        inline FF::Vector3<T> GetParticleLocation(std::size_t row, std::size_t column) const;
+        inline FF::Vector3<T> GetParticleVelocity(std::size_t row, std::size_t column) const;
+
         inline bool isParticleStatic(std::size_t row, std::size_t column);
         inline void SetParticleStaticFlag(std::size_t row, std::size_t column, bool flag);
 
+        inline const FF::ClothState<T>&         GetState(void) const;
+        inline const FF::ClothSprings<T>&       GetSprings(void) const;
+        inline const std::vector<FF::ClothSquare>& GetSquares(void) const;
+        inline const std::vector<FF::CollisionPair>& GetCollisionPairs(void) const;
+
+        inline Integrator& GetIntegrator(void);
+
+        inline void        SetThreadCount(std::size_t threadCount);
+        inline std::size_t GetThreadCount(void) const;
+
+        inline T           GetSleepVelocity(void) const;
+        inline void        SetSleepVelocity(T sleepVelocity);
+        inline std::size_t GetSleepStepCount(void) const;
+        inline void        SetSleepStepCount(std::size_t sleepStepCount);
+
+        inline T           GetBroadPhaseMargin(void) const;
+        inline void        SetBroadPhaseMargin(T margin);
+
+        inline bool        isParticleAwake(std::size_t row, std::size_t column) const;
+        inline std::size_t GetAwakeParticleCount(void) const;
+        inline void        WakeUp(void);
+
         inline bool Update(const T changeInTime);
-        inline bool Render(void);
 
-        ~Cloth(void);
+        ~Cloth(void) = default;
     };
 
     /**
@@ -100,8 +199,8 @@ namespace FF {
      * 
      * @return [-]
      */
-    template<typename T>
-    inline FF::Cloth<T>::Cloth( std::size_t    __FF_IN rows, 
+    template<typename T, typename Integrator>
+    inline FF::Cloth<T, Integrator>::Cloth( std::size_t    __FF_IN rows, 
                                 std::size_t    __FF_IN columns,
                                 T              __FF_IN particleMass,
                                 T              __FF_IN particleRadius,
@@ -110,119 +209,205 @@ namespace FF {
                                 T              __FF_IN clothStiffness,
                                 T              __FF_IN dampeningFactor,
                                 T              __FF_IN linearDampeningFactor,
-                                FF::Vector3<T> __FF_IN upLeftCorner ){
+                                FF::Vector3<T> __FF_IN upLeftCorner )
+    : m_TotalRows(rows),
+      m_TotalColumns(columns),
+      m_ParticleRadius(particleRadius),
+      m_ParticleRestitution(particleElasticity),
+      m_LinearDampeningCoefficient(linearDampeningFactor),
+      m_BroadPhase(static_cast<T>(0x4) * particleRadius, rows * columns),
+      m_BroadPhaseMargin(particleRadius),
+      m_isBroadPhaseDirty(true),
+      m_isBroadPhasePartial(false),
+      m_SleepVelocity(static_cast<T>(0x0)),
+      m_SleepStepCount(0x3C),
+      m_TileRows((rows + FF::CLOTH_CONSTANTS::FF_SLEEP_TILE_SIZE - 0x1) / FF::CLOTH_CONSTANTS::FF_SLEEP_TILE_SIZE),
+      m_TileColumns((columns + FF::CLOTH_CONSTANTS::FF_SLEEP_TILE_SIZE - 0x1) / FF::CLOTH_CONSTANTS::FF_SLEEP_TILE_SIZE),
+      m_AwakeTileCount(m_TileRows * m_TileColumns),
+      m_isTileAwake(m_TileRows * m_TileColumns, 0x1),
+      m_isTileMoving(m_TileRows * m_TileColumns, 0x0),
+      m_TileSleepCounter(m_TileRows * m_TileColumns, 0x0),
+      m_isActiveSetDirty(true),
+      m_AwakeParticleCount(rows * columns),
+      m_ActiveIndex(rows * columns),
+      m_SleepingBroadPhase(static_cast<T>(0x2) * particleRadius) {
         FF_ASSERT(rows    >= 0x2);
         FF_ASSERT(columns >= 0x2);
+        FF_ASSERT(!FF::CloseToZero(particleMass));
 
-        this->m_LinearDampeningCoefficient = dampeningFactor;
+        this->m_State.Resize(rows * columns);
 
-        this->m_Particles = new FF::MaterialPointBase<T>*[rows];
-
-        if (this->m_Particles == nullptr) {
-            //to - do: exception can't alloc memory for cloth
-        }
+        FF::Vector3<T> location(upLeftCorner);
 
         for (std::size_t i = 0x0; i < rows; i++) {
-            this->m_Particles[i] = new FF::MaterialPointBase<T>[columns];
-
-            if (this->m_Particles[i] == nullptr) {
-                //to-do: exception can't alloc memory for cloth
+            for (std::size_t j = 0x0; j < columns; j++) {
+                this->m_State.SetLocation(this->FlatIndex(i, j), location);
+                this->m_State.m_InvertMass[this->FlatIndex(i, j)] = static_cast<T>(0x1) / particleMass;
+                location.SetXComponent(location.GetXComponent() + spaceBetweenParticles);          
             }
+            location.SetXComponent(upLeftCorner.GetXComponent());
+            location.SetYComponent(location.GetYComponent() - spaceBetweenParticles);
         }
 
         this->m_TotalSprings = (rows * (columns - 0x1)) +
                                 ((rows - 0x1) * columns) +
                                  ((rows - 0x1) * (columns - 0x1) * 0x2);
 
-        this->m_Springs = new FF::Spring<T>[this->m_TotalSprings];
+        this->m_Springs.Reserve(this->m_TotalSprings);
 
-        if (this->m_Springs == nullptr) {
-            //to-do: exception can't alloc memory for cloth
-        } else {
-            for (std::size_t i = 0x0; i < rows; i++) {
-                this->m_Squares = new FF::ClothSquare[columns - 0x1];
+        const T diagonalLength = spaceBetweenParticles * std::sqrt(static_cast<T>(0x2));
 
-                if (this->m_Squares == nullptr) {
-                    //to-do: exception can't alloc memory for cloth    
-                }
+        // Horizontal springs: (i, j) - (i, j + 1)
+        for (std::size_t i = 0x0; i < rows; i++) {
+            for (std::size_t j = 0x0; j < columns - 0x1; j++) {
+                this->m_Springs.AddSpring(this->FlatIndex(i, j), this->FlatIndex(i, j + 0x1), spaceBetweenParticles, clothStiffness, dampeningFactor);
             }
         }
 
-        FF::Vector3<T> location = upLeftCorner;
-
-        for (std::size_t i = 0x0; i < rows; i++) {
+        // Vertical springs: (i, j) - (i + 1, j)
+        const std::size_t firstVerticalSpring = this->m_Springs.GetSpringCount();
+        for (std::size_t i = 0x0; i < rows - 0x1; i++) {
             for (std::size_t j = 0x0; j < columns; j++) {
-                this->m_Particles[i][j].SetInvertMass(particleMass);
-                this->m_Particles[i][j].SetBoundedSphereRadius(particleRadius);
-                this->m_Particles[i][j].SetRestitution(particleElasticity);
-                this->m_Particles[i][j].SetLocation(location);
-                location.SetXComponent(location.GetXComponent() + spaceBetweenParticles);          
+                this->m_Springs.AddSpring(this->FlatIndex(i, j), this->FlatIndex(i + 0x1, j), spaceBetweenParticles, clothStiffness, dampeningFactor);
             }
-            location.SetXComponent(upLeftCorner.GetXComponent());
-            location.SetYComponent(location.GetYComponent() - spaceBetweenParticles);
         }
 
-        FF::IndexPair tmpIndex;
-        int currSpring;
-        for (std::size_t i = 0x0; i < rows; i++) {
-            for (std::size_t j = 0x0; j < columns; j++, currSpring++) {
-                // Connect to the top
-                this->m_Springs[currSpring].SetEndpointMassFirst(&this->m_Particles[i][j]);
-                this->m_Springs[currSpring].SetEndpointMassSecond(&this->m_Particles[i][j + 0x1]);
-
-                if (i < rows - 0x1) {
-                    // Store the index of the left spring
-                    this->m_Squares[i][j].m_SpringIndex[FF::CLOTH_CONSTANTS::FF_LEFT_SPRING] = currSpring;
-
-                    // Store the indices of the two particles it connects
-                    tmpIndex.m_row    = i;
-                    tmpIndex.m_column = j;
-                    this->m_Squares[i][j].m_ParticleIndex[FF::CLOTH_CONSTANTS::FF_TOP_LEFT_PARTICLE] = tmpIndex;
-                    tmpIndex.m_row = i + 0x1;
-                    this->m_Squares[i][j].m_ParticleIndex[FF::CLOTH_CONSTANTS::FF_BOTTOM_LEFT_PARTICLE] = tmpIndex;
-                }
+        // For each square, store its particles and springs, and connect the diagonal springs
+        this->m_Squares.resize((rows - 0x1) * (columns - 0x1));
 
-                // If this is not the first column of particles
-                if (j > 0x0) {
-                    // Store the index of the bottom spring
-                    this->m_Squares[i][j - 0x1].m_SpringIndex[FF::CLOTH_CONSTANTS::FF_RIGHT_SPRING] = currSpring;
-
-                    // Store the indices of the two particles it connects
-                    tmpIndex.m_row = i;
-                    tmpIndex.m_column = j;
-                    this->m_Squares[i][j - 0x1].m_ParticleIndex[FF::CLOTH_CONSTANTS::FF_TOP_RIGHT_PARTICLE] = tmpIndex;
-                    tmpIndex.m_row = i + 0x1;
-                    this->m_Squares[i][j - 0x1].m_ParticleIndex[FF::CLOTH_CONSTANTS::FF_BOTTOM_RIGHT_PARTICLE] = tmpIndex;
-                }
-            }
-        }
-
-        // For each square, connect the diagonal springs
         for (std::size_t i = 0x0; i < rows - 0x1; i++) {
             for (std::size_t j = 0x0; j < columns - 0x1; j++) {
+                FF::ClothSquare& square = this->m_Squares[i * (columns - 0x1) + j];
+
+                square.m_ParticleIndex[FF::CLOTH_CONSTANTS::FF_TOP_LEFT_PARTICLE]     = FF::IndexPair{ i,         j         };
+                square.m_ParticleIndex[FF::CLOTH_CONSTANTS::FF_TOP_RIGHT_PARTICLE]    = FF::IndexPair{ i,         j + 0x1   };
+                square.m_ParticleIndex[FF::CLOTH_CONSTANTS::FF_BOTTOM_LEFT_PARTICLE]  = FF::IndexPair{ i + 0x1,   j         };
+                square.m_ParticleIndex[FF::CLOTH_CONSTANTS::FF_BOTTOM_RIGHT_PARTICLE] = FF::IndexPair{ i + 0x1,   j + 0x1   };
+
+                square.m_SpringIndex[FF::CLOTH_CONSTANTS::FF_TOP_SPRING]    = i * (columns - 0x1) + j;
+                square.m_SpringIndex[FF::CLOTH_CONSTANTS::FF_BOTTOM_SPRING] = (i + 0x1) * (columns - 0x1) + j;
+                square.m_SpringIndex[FF::CLOTH_CONSTANTS::FF_LEFT_SPRING]   = firstVerticalSpring + i * columns + j;
+                square.m_SpringIndex[FF::CLOTH_CONSTANTS::FF_RIGHT_SPRING]  = firstVerticalSpring + i * columns + j + 0x1;
+
                 // Connect the spring from the top left to the bottom right
-                this->m_Springs[currSpring].SetEndpointMassFirst(&this->m_Particles[i][j]);
-                this->m_Springs[currSpring].SetEndpointMassSecond(&this->m_Particles[i + 0x1][j + 0x1]);
-                this->m_Squares[i][j].m_SpringIndex[FF::CLOTH_CONSTANTS::FF_TOP_RIGHT_TO_BOTTOM_LEFT_SPRING] = currSpring++;
+                square.m_SpringIndex[FF::CLOTH_CONSTANTS::FF_TOP_LEFT_TO_BOTTOM_RIGHT_SPRING] =
+                    this->m_Springs.AddSpring(this->FlatIndex(i, j), this->FlatIndex(i + 0x1, j + 0x1), diagonalLength, clothStiffness, dampeningFactor);
 
                 // Connect the spring from the top right to the bottom left
-                this->m_Springs[currSpring].SetEndpointMassFirst(&this->m_Particles[i][j + 0x1]);
-                this->m_Springs[currSpring].SetEndpointMassSecond(&this->m_Particles[i + 0x1][j]);
-                this->m_Squares[i][j].m_SpringIndex[FF::CLOTH_CONSTANTS::FF_TOP_LEFT_TO_BOTTOM_RIGHT_SPRING] = currSpring++;
+                square.m_SpringIndex[FF::CLOTH_CONSTANTS::FF_TOP_RIGHT_TO_BOTTOM_LEFT_SPRING] =
+                    this->m_Springs.AddSpring(this->FlatIndex(i, j + 0x1), this->FlatIndex(i + 0x1, j), diagonalLength, clothStiffness, dampeningFactor);
+            }
+        }
+
+        FF_ASSERT(this->m_Springs.GetSpringCount() == this->m_TotalSprings);
+
+        // Group springs into batches without shared particles, so each batch can be evaluated in parallel
+        const std::vector<std::size_t> newSpringIndex = this->m_Springs.SortByColor(rows * columns);
+
+        for (FF::ClothSquare& square : this->m_Squares) {
+            for (std::size_t k = 0x0; k < FF::CLOTH_CONSTANTS::FF_SPRINGS_PER_SQUARE; k++) {
+                square.m_SpringIndex[k] = newSpringIndex[square.m_SpringIndex[k]];
             }
         }
+    }
+
+    /**
+     * @brief [Method that convert index of particle in PARTICLE_BUFFER to index in FF::ClothState]
+     * @details [Particles are stored row by row]
+     * 
+     * @param row [Row in PARTICLE_BUFFER]
+     * @param column [Column in PARTICLE_BUFFER]
+     * @tparam T [Generic type]
+     * 
+     * @return [Return index of particle in every array of state]
+     */
+    template<typename T, typename Integrator>
+    inline std::size_t FF::Cloth<T, Integrator>::FlatIndex(std::size_t row, std::size_t column) const {
+        return (row * this->m_TotalColumns + column);
+    }
+
+    /**
+     * @brief [Method that convert index of particle in FF::ClothState to index in PARTICLE_BUFFER]
+     * @details [Particles are stored row by row]
+     * 
+     * @param flatIndex [Index of particle in state]
+     * @tparam T [Generic type]
+     * 
+     * @return [Return row and column of particle]
+     */
+    template<typename T, typename Integrator>
+    inline FF::IndexPair FF::Cloth<T, Integrator>::ParticleIndex(std::size_t flatIndex) const {
+        FF::IndexPair index;
+        index.m_row    = flatIndex / this->m_TotalColumns;
+        index.m_column = flatIndex % this->m_TotalColumns;
 
-        // Set the common properties of all springs
-        for (std::size_t i = 0x0; i < this->m_TotalSprings; i++) {
-            this->m_Springs[i].SetDampening(dampeningFactor);
-            this->m_Springs[i].SetForce(clothStiffness);
+        return index;
+    }
+
+    /**
+     * @brief [Method that check that two particles are joined by spring]
+     * @details [Structural and shear springs connect each particle with all its neighbours in the grid,
+     *           so the particles are joined if they are differ at most by one row and one column]
+     * 
+     * @param firstParticle [Index of first particle in state]
+     * @param secondParticle [Index of second particle in state]
+     * @tparam T [Generic type]
+     * 
+     * @return [Return true if particles are joined by spring]
+     */
+    template<typename T, typename Integrator>
+    inline bool FF::Cloth<T, Integrator>::isSpringConnected(std::size_t firstParticle, std::size_t secondParticle) const {
+        FF::IndexPair first  = this->ParticleIndex(firstParticle);
+        FF::IndexPair second = this->ParticleIndex(secondParticle);
+
+        std::size_t rowDifference    = (first.m_row > second.m_row) ? (first.m_row - second.m_row) : (second.m_row - first.m_row);
+        std::size_t columnDifference = (first.m_column > second.m_column) ? (first.m_column - second.m_column) : (second.m_column - first.m_column);
+
+        return (rowDifference <= 0x1 && columnDifference <= 0x1);
+    }
 
-            FF::Vector3<T> tmpVector = this->m_Springs[i].GetEndpointMassFirst()->GetLocation() - this->m_Springs[i].GetEndpointMassSecond()->GetLocation();
-            this->m_Springs[i].GetLength(FF::Magnitude(tmpVector));
+    /**
+     * @brief [Method that resolve collision of two particles]
+     * @details [Particles are pushed apart along the separation distance in proportion to their invert masses,
+     *           approaching velocity along the separation distance is reflected with restitution]
+     * 
+     * @param state [State that contains both particles]
+     * @param separationDistance [Vector from the second particle to the first particle]
+     * @param firstParticle [Index of first particle in state]
+     * @param secondParticle [Index of second particle in state]
+     * @tparam T [Generic type]
+     * 
+     * @return [-]
+     */
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::HandleCollision( FF::ClothState<T>&    state,
+                                               const FF::Vector3<T>& separationDistance,
+                                               std::size_t           firstParticle,
+                                               std::size_t           secondParticle ){
+        T firstInvertMass  = state.m_StaticMask[firstParticle]  ? static_cast<T>(0x0) : state.m_InvertMass[firstParticle];
+        T secondInvertMass = state.m_StaticMask[secondParticle] ? static_cast<T>(0x0) : state.m_InvertMass[secondParticle];
+        T sumInvertMass    = firstInvertMass + secondInvertMass;
+
+        T distance = FF::Magnitude(separationDistance);
+        if (FF::CloseToZero(distance) || FF::CloseToZero(sumInvertMass)) {
+            return;
         }
 
-        this->m_TotalRows    = rows;
-        this->m_TotalColumns = columns;
+        FF::Vector3<T> normal = separationDistance / distance;
+
+        // Push the particles out of each other
+        T penetration = static_cast<T>(0x2) * this->m_ParticleRadius - distance;
+        state.SetLocation(firstParticle,  state.GetLocation(firstParticle)  + normal * (penetration * firstInvertMass / sumInvertMass));
+        state.SetLocation(secondParticle, state.GetLocation(secondParticle) - normal * (penetration * secondInvertMass / sumInvertMass));
+
+        // Reflect the approaching part of relative velocity
+        T approachingVelocity = FF::DotProduct(state.GetVelocity(firstParticle) - state.GetVelocity(secondParticle), normal);
+        if (approachingVelocity < static_cast<T>(0x0)) {
+            T impulse = -(static_cast<T>(0x1) + this->m_ParticleRestitution) * approachingVelocity / sumInvertMass;
+
+            state.SetVelocity(firstParticle,  state.GetVelocity(firstParticle)  + normal * (impulse * firstInvertMass));
+            state.SetVelocity(secondParticle, state.GetVelocity(secondParticle) - normal * (impulse * secondInvertMass));
+        }
     }
 
     /**
@@ -236,12 +421,16 @@ namespace FF {
      * 
      * @return [-]
      */
-    template<typename T>
-    inline void FF::Cloth<T>::SetParticleImpulseForce(std::size_t row, std::size_t column, const FF::Vector3<T>& impulseForce){
-        FF_ASSERT_MESSAGE((row >= 0x0 && row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
-        FF_ASSERT_MESSAGE((column >= 0x0 && column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::SetParticleImpulseForce(std::size_t row, std::size_t column, const FF::Vector3<T>& impulseForce){
+        FF_ASSERT_MESSAGE((row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
+        FF_ASSERT_MESSAGE((column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
         
-        this->m_Particles[row][column].SetImpulseForce(impulseForce);
+        this->m_State.SetForce(this->FlatIndex(row, column), impulseForce);
+
+        if (!FF::CloseToZero(FF::DotProduct(impulseForce, impulseForce))) {
+            this->WakeTile(this->TileIndex(this->FlatIndex(row, column)));
+        }
     }
 
     /**
@@ -255,12 +444,12 @@ namespace FF {
      * 
      * @return [Return impulse force of (i, j) particle in PARTICLE_BUFFER]
      */
-    template<typename T>
-    inline FF::Vector3<T> FF::Cloth<T>::GetParticleImpulseForce(std::size_t row, std::size_t column){
-        FF_ASSERT_MESSAGE((row >= 0x0 && row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
-        FF_ASSERT_MESSAGE((column >= 0x0 && column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
+    template<typename T, typename Integrator>
+    inline FF::Vector3<T> FF::Cloth<T, Integrator>::GetParticleImpulseForce(std::size_t row, std::size_t column){
+        FF_ASSERT_MESSAGE((row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
+        FF_ASSERT_MESSAGE((column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
         
-        return (this->m_Particles[row][column].GetImpulseForce());
+        return (this->m_State.GetForce(this->FlatIndex(row, column)));
     }
 
     /**
@@ -274,12 +463,13 @@ namespace FF {
      * 
      * @return [-]
      */
-    template<typename T>
-    inline void FF::Cloth<T>::SetParticleConstantForce(std::size_t row, std::size_t column, const FF::Vector3<T>& constantForce){
-        FF_ASSERT_MESSAGE((row >= 0x0 && row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
-        FF_ASSERT_MESSAGE((column >= 0x0 && column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::SetParticleConstantForce(std::size_t row, std::size_t column, const FF::Vector3<T>& constantForce){
+        FF_ASSERT_MESSAGE((row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
+        FF_ASSERT_MESSAGE((column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
         
-        this->m_Particles[row][column].SetConstantForce(constantForce);
+        this->m_State.SetConstantForce(this->FlatIndex(row, column), constantForce);
+        this->WakeTile(this->TileIndex(this->FlatIndex(row, column)));
     }
 
     /**
@@ -293,12 +483,48 @@ namespace FF {
      * 
      * @return [Return constant force of (i, j) particle in PARTICLE_BUFFER]
      */
-    template<typename T>
-    inline FF::Vector3<T> FF::Cloth<T>::GetParticleConstantForce(std::size_t row, std::size_t column){
-        FF_ASSERT_MESSAGE((row >= 0x0 && row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
-        FF_ASSERT_MESSAGE((column >= 0x0 && column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
+    template<typename T, typename Integrator>
+    inline FF::Vector3<T> FF::Cloth<T, Integrator>::GetParticleConstantForce(std::size_t row, std::size_t column){
+        FF_ASSERT_MESSAGE((row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
+        FF_ASSERT_MESSAGE((column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
         
-        return (this->m_Particles[row][column].GetConstantForce());
+        return (this->m_State.GetConstantForce(this->FlatIndex(row, column)));
+    }
+
+    /**
+     * @brief [Method that get location of (i, j) particle in PARTICLE_BUFFER]
+     * @details [-]
+     * 
+     * @param row [Row in PARTICLE_BUFFER]
+     * @param column [Column in PARTICLE_BUFFER]
+     * @tparam T [Generic Type]
+     * 
+     * @return [Return location of (i, j) particle in PARTICLE_BUFFER]
+     */
+    template<typename T, typename Integrator>
+    inline FF::Vector3<T> FF::Cloth<T, Integrator>::GetParticleLocation(std::size_t row, std::size_t column) const {
+        FF_ASSERT_MESSAGE((row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
+        FF_ASSERT_MESSAGE((column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
+
+        return (this->m_State.GetLocation(this->FlatIndex(row, column)));
+    }
+
+    /**
+     * @brief [Method that get velocity of (i, j) particle in PARTICLE_BUFFER]
+     * @details [-]
+     * 
+     * @param row [Row in PARTICLE_BUFFER]
+     * @param column [Column in PARTICLE_BUFFER]
+     * @tparam T [Generic Type]
+     * 
+     * @return [Return velocity of (i, j) particle in PARTICLE_BUFFER]
+     */
+    template<typename T, typename Integrator>
+    inline FF::Vector3<T> FF::Cloth<T, Integrator>::GetParticleVelocity(std::size_t row, std::size_t column) const {
+        FF_ASSERT_MESSAGE((row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
+        FF_ASSERT_MESSAGE((column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
+
+        return (this->m_State.GetVelocity(this->FlatIndex(row, column)));
     }
 
     /**
@@ -311,12 +537,12 @@ namespace FF {
      * 
      * @return [Flag that represent move ability for particle]
      */
-    template<typename T>
-    inline bool FF::Cloth<T>::isParticleStatic(std::size_t row, std::size_t column){
-        FF_ASSERT_MESSAGE((row >= 0x0 && row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
-        FF_ASSERT_MESSAGE((column >= 0x0 && column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
+    template<typename T, typename Integrator>
+    inline bool FF::Cloth<T, Integrator>::isParticleStatic(std::size_t row, std::size_t column){
+        FF_ASSERT_MESSAGE((row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
+        FF_ASSERT_MESSAGE((column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
 
-        return this->m_Particles[row][column].isStatic();
+        return (this->m_State.m_StaticMask[this->FlatIndex(row, column)] != 0x0);
     }
 
     /**
@@ -329,98 +555,666 @@ namespace FF {
      * 
      * @return [-]
      */
-    template<typename T>
-    inline void FF::Cloth<T>::SetParticleStaticFlag(std::size_t row, std::size_t column, bool flag){
-        FF_ASSERT_MESSAGE((row >= 0x0 && row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
-        FF_ASSERT_MESSAGE((column >= 0x0 && column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::SetParticleStaticFlag(std::size_t row, std::size_t column, bool flag){
+        FF_ASSERT_MESSAGE((row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
+        FF_ASSERT_MESSAGE((column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
+
+        std::size_t index = this->FlatIndex(row, column);
+        this->m_State.m_StaticMask[index] = flag ? 0x1 : 0x0;
 
-        this-m_Particles[row][column].SetStaticFlag();
+        if (flag) {
+            this->m_State.SetVelocity(index, FF::Vector3<T>(0.0f, 0.0f, 0.0f));
+        }
+
+        this->WakeTile(this->TileIndex(index));
     }
 
     /**
-     * @brief [Method update states from each particle from PARTICLE_BUFFER]
+     * @brief [Method that get particles of cloth]
+     * @details [Arrays of state can be read directly by renderer or other solvers]
+     * 
+     * @tparam T [Generic type]
+     * @return [Return structure-of-arrays state of particles]
+     */
+    template<typename T, typename Integrator>
+    inline const FF::ClothState<T>& FF::Cloth<T, Integrator>::GetState(void) const {
+        return this->m_State;
+    }
+
+    /**
+     * @brief [Method that get springs of cloth]
      * @details [-]
      * 
-     * @param changeInTime [Frame of time that need to recalculate states]
      * @tparam T [Generic type]
+     * @return [Return flat spring topology]
+     */
+    template<typename T, typename Integrator>
+    inline const FF::ClothSprings<T>& FF::Cloth<T, Integrator>::GetSprings(void) const {
+        return this->m_Springs;
+    }
+
+    /**
+     * @brief [Method that get squares of cloth]
+     * @details [Square (i, j) has index i * (columns - 1) + j]
+     * 
+     * @tparam T [Generic type]
+     * @return [Return squares with indices of their particles and springs]
+     */
+    template<typename T, typename Integrator>
+    inline const std::vector<FF::ClothSquare>& FF::Cloth<T, Integrator>::GetSquares(void) const {
+        return this->m_Squares;
+    }
+
+    /**
+     * @brief [Method that get pairs of particles handled by the last Update()]
+     * @details [Indices are in state that was updated, it is compact state of awake particles while some tiles sleep]
+     * 
+     * @tparam T [Generic type]
+     * @return [Return colliding pairs of the last step]
+     */
+    template<typename T, typename Integrator>
+    inline const std::vector<FF::CollisionPair>& FF::Cloth<T, Integrator>::GetCollisionPairs(void) const {
+        return this->m_CollisionPairs;
+    }
+
+    /**
+     * @brief [Method that get integrator of cloth]
+     * @details [It is used to tune integrator, e.g. iterations of FF::BackwardEuler]
+     * 
+     * @tparam T [Generic type]
+     * @return [Return integrator]
+     */
+    template<typename T, typename Integrator>
+    inline Integrator& FF::Cloth<T, Integrator>::GetIntegrator(void){
+        return this->m_Integrator;
+    }
+
+    /**
+     * @brief [Method that set count of threads that update cloth]
+     * @details [Workers are started here, not in Update(). Result of Update() doesn't depend on count of threads]
+     * 
+     * @param threadCount [Count of threads including calling thread, 1 disables multi-threading]
+     * @tparam T [Generic type]
+     * 
+     * @return [-]
+     */
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::SetThreadCount(std::size_t threadCount){
+        FF_ASSERT_MESSAGE(threadCount > 0x0, "Cloth must be updated by at least one thread!");
+
+        if (threadCount == this->GetThreadCount()) {
+            return;
+        }
+
+        this->m_WorkerPool.reset();
+        if (threadCount > 0x1) {
+            this->m_WorkerPool.reset(new FF::WorkerPool(threadCount));
+        }
+    }
+
+    template<typename T, typename Integrator>
+    inline std::size_t FF::Cloth<T, Integrator>::GetThreadCount(void) const {
+        return (this->m_WorkerPool ? this->m_WorkerPool->GetThreadCount() : 0x1);
+    }
+
+    /**
+     * @brief [Method that get speed below which tiles of particles fall asleep]
+     * @details [-]
+     * 
+     * @tparam T [Generic type]
+     * @return [Return sleep velocity]
+     */
+    template<typename T, typename Integrator>
+    inline T FF::Cloth<T, Integrator>::GetSleepVelocity(void) const {
+        return this->m_SleepVelocity;
+    }
+
+    /**
+     * @brief [Method that set speed below which tiles of particles fall asleep]
+     * @details [Zero velocity disables sleeping, it is the default]
+     * 
+     * @param sleepVelocity [Sleep velocity]
+     * @tparam T [Generic type]
+     * 
+     * @return [-]
+     */
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::SetSleepVelocity(T sleepVelocity){
+        FF_ASSERT_MESSAGE(sleepVelocity >= static_cast<T>(0x0), "Sleep velocity can't be negative!");
+        this->m_SleepVelocity = sleepVelocity;
+    }
+
+    template<typename T, typename Integrator>
+    inline std::size_t FF::Cloth<T, Integrator>::GetSleepStepCount(void) const {
+        return this->m_SleepStepCount;
+    }
+
+    /**
+     * @brief [Method that set count of steps that tile must rest before it falls asleep]
+     * @details [-]
+     * 
+     * @param sleepStepCount [Count of steps]
+     * @tparam T [Generic type]
+     * 
+     * @return [-]
+     */
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::SetSleepStepCount(std::size_t sleepStepCount){
+        FF_ASSERT_MESSAGE(sleepStepCount > 0x0, "Tile must rest at least one step before sleeping!");
+        this->m_SleepStepCount = sleepStepCount;
+    }
+
+    template<typename T, typename Integrator>
+    inline T FF::Cloth<T, Integrator>::GetBroadPhaseMargin(void) const {
+        return this->m_BroadPhaseMargin;
+    }
+
+    /**
+     * @brief [Method that set distance which particles may move before broad phase is rebuilt]
+     * @details [Broad phase keeps pairs closer than diameter + 2 * MARGIN, so larger margin means rarer
+     *           rebuilds but more pairs checked every step. Zero margin rebuilds broad phase every step]
+     * 
+     * @param margin [Margin of broad phase]
+     * @tparam T [Generic type]
+     * 
      * @return [-]
      */
-    template<typename T>
-    inline bool FF::Cloth<T>::Update(const T changeInTime){
-        std::size_t i,j;
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::SetBroadPhaseMargin(T margin){
+        FF_ASSERT_MESSAGE(margin >= static_cast<T>(0x0), "Margin of broad phase can't be negative!");
+        this->m_BroadPhaseMargin  = margin;
+        this->m_isBroadPhaseDirty = true;
+    }
+
+    /**
+     * @brief [Method that check that (i, j) particle is updated]
+     * @details [-]
+     * 
+     * @param row [Row in PARTICLE_BUFFER]
+     * @param column [Column in PARTICLE_BUFFER]
+     * @tparam T [Generic type]
+     * 
+     * @return [Return false if tile of particle sleeps]
+     */
+    template<typename T, typename Integrator>
+    inline bool FF::Cloth<T, Integrator>::isParticleAwake(std::size_t row, std::size_t column) const {
+        FF_ASSERT_MESSAGE((row < this->m_TotalRows), "Going beyond particle buffer! Check row index!");
+        FF_ASSERT_MESSAGE((column < this->m_TotalColumns), "Going beyond particle buffer! Check column index!");
+
+        return (this->m_isTileAwake[this->TileIndex(this->FlatIndex(row, column))] != 0x0);
+    }
 
-        // Calculate the force exerted by each spring
-        for (i = 0x0; i < this->m_TotalSprings; i++) {
-            if (this->m_Springs[i].IsDisplaced()) {
-                this->m_Springs[i].CalculateReactions(changeInTime);
+    /**
+     * @brief [Method that get count of particles in awake tiles]
+     * @details [-]
+     * 
+     * @tparam T [Generic type]
+     * @return [Return count of particles that are integrated by next Update()]
+     */
+    template<typename T, typename Integrator>
+    inline std::size_t FF::Cloth<T, Integrator>::GetAwakeParticleCount(void) const {
+        std::size_t count = 0x0;
+
+        for (std::size_t tileRow = 0x0; tileRow < this->m_TileRows; tileRow++) {
+            for (std::size_t tileColumn = 0x0; tileColumn < this->m_TileColumns; tileColumn++) {
+                if (this->m_isTileAwake[tileRow * this->m_TileColumns + tileColumn]) {
+                    const std::size_t rows    = FF::min<std::size_t>(FF::CLOTH_CONSTANTS::FF_SLEEP_TILE_SIZE, this->m_TotalRows - tileRow * FF::CLOTH_CONSTANTS::FF_SLEEP_TILE_SIZE);
+                    const std::size_t columns = FF::min<std::size_t>(FF::CLOTH_CONSTANTS::FF_SLEEP_TILE_SIZE, this->m_TotalColumns - tileColumn * FF::CLOTH_CONSTANTS::FF_SLEEP_TILE_SIZE);
+
+                    count += rows * columns;
+                }
             }
         }
 
-        // Update the position of every particle in the grid.
-        for (i = 0x0; i < this->m_TotalRows; i++) {
-            for (j = 0x0; j < this->m_TotalColumns; j++) {
-                for (std::size_t k = i; k < this->m_TotalColumns; k++) {
-                    for (std::size_t m = j + 0x1; m < this->m_TotalColumns; m++) {
-                        // Find the distance vector between the particles.
-                        FF::Vector3<T> distance = this->m_Particles[i][j].GetLocation() - this->m_Particles[k][m].GetLocation();
-                        T distanceSquared = FF::SquaredMagnitude(distance);
-
-                        // Find the square of the sum of the radii of the balls.
-                        T minDistanceSquared = this->m_Particles[i][j].GetBoundingSphereRadius() + this->m_Particles[k][m].GetBoundingSphereRadius();
-                        minDistanceSquared *= minDistanceSquared;
-
-                        // If there is a collision
-                        if (distanceSquared < minDistanceSquared) {
-                            IndexPair firstParticle, secondParticle;
-                            firstParticle.m_row     = i;
-                            firstParticle.m_column  = j;
-                            secondParticle.m_row    = k;
-                            secondParticle.m_column = m;
-
-                            // Handle the collision.
-                            HandleCollision(distance, changeInTime, firstParticle, secondParticle);
-                        }
-                    }
+        return count;
+    }
+
+    /**
+     * @brief [Method that wake all tiles of cloth]
+     * @details [-]
+     * 
+     * @tparam T [Generic type]
+     * @return [-]
+     */
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::WakeUp(void){
+        for (std::size_t tile = 0x0; tile < this->m_isTileAwake.size(); tile++) {
+            this->WakeTile(tile);
+        }
+    }
+
+    /**
+     * @brief [Method that convert index of particle in FF::ClothState to index of its sleep tile]
+     * @details [Tiles are stored row by row]
+     * 
+     * @param flatIndex [Index of particle in state]
+     * @tparam T [Generic type]
+     * 
+     * @return [Return index of tile]
+     */
+    template<typename T, typename Integrator>
+    inline std::size_t FF::Cloth<T, Integrator>::TileIndex(std::size_t flatIndex) const {
+        FF::IndexPair index = this->ParticleIndex(flatIndex);
+
+        return ((index.m_row / FF::CLOTH_CONSTANTS::FF_SLEEP_TILE_SIZE) * this->m_TileColumns + index.m_column / FF::CLOTH_CONSTANTS::FF_SLEEP_TILE_SIZE);
+    }
+
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::WakeTile(std::size_t tile){
+        this->m_TileSleepCounter[tile] = 0x0;
+
+        if (!this->m_isTileAwake[tile]) {
+            this->m_isTileAwake[tile] = 0x1;
+            this->m_AwakeTileCount++;
+            this->m_isActiveSetDirty  = true;
+        }
+    }
+
+    /**
+     * @brief [Method that collect particles and springs that are updated while some tiles sleep]
+     * @details [Particles of awake tiles go first, then sleeping particles joined to them by springs.
+     *           Springs keep order of M_SPRINGS, so batches of colors stay without shared particles.
+     *           Other sleeping particles are put into sleeping broad phase to detect contacts with them.
+     *           It is called only when some tile falls asleep or wakes up]
+     * 
+     * @tparam T [Generic type]
+     * @return [-]
+     */
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::RebuildActiveSet(void){
+        const std::size_t count = this->m_State.GetParticleCount();
+        const std::size_t none  = count;
+
+        this->m_ActiveParticles.clear();
+        for (std::size_t i = 0x0; i < count; i++) {
+            if (this->m_isTileAwake[this->TileIndex(i)]) {
+                this->m_ActiveIndex[i] = this->m_ActiveParticles.size();
+                this->m_ActiveParticles.push_back(i);
+            } else {
+                this->m_ActiveIndex[i] = none;
+            }
+        }
+        this->m_AwakeParticleCount = this->m_ActiveParticles.size();
+
+        this->m_ActiveSprings.Clear();
+        for (std::size_t c = 0x0; c < this->m_Springs.GetColorCount(); c++) {
+            this->m_ActiveSprings.m_ColorOffsets.push_back(this->m_ActiveSprings.GetSpringCount());
+
+            for (std::size_t s = this->m_Springs.m_ColorOffsets[c]; s < this->m_Springs.m_ColorOffsets[c + 0x1]; s++) {
+                const std::size_t first  = this->m_Springs.m_First[s];
+                const std::size_t second = this->m_Springs.m_Second[s];
+
+                const bool isFirstAwake  = this->m_isTileAwake[this->TileIndex(first)] != 0x0;
+                const bool isSecondAwake = this->m_isTileAwake[this->TileIndex(second)] != 0x0;
+
+                if (!isFirstAwake && !isSecondAwake) {
+                    continue;
                 }
+
+                // Sleeping end of spring is updated as static particle
+                const std::size_t sleeping = isFirstAwake ? second : first;
+                if (!(isFirstAwake && isSecondAwake) && this->m_ActiveIndex[sleeping] == none) {
+                    this->m_ActiveIndex[sleeping] = this->m_ActiveParticles.size();
+                    this->m_ActiveParticles.push_back(sleeping);
+                }
+
+                this->m_ActiveSprings.AddSpring( this->m_ActiveIndex[first], this->m_ActiveIndex[second], this->m_Springs.m_RestLength[s],
+                                                 this->m_Springs.m_Stiffness[s], this->m_Springs.m_Dampening[s] );
+            }
+        }
+        this->m_ActiveSprings.m_ColorOffsets.push_back(this->m_ActiveSprings.GetSpringCount());
+
+        this->m_ActiveState.Resize(this->m_ActiveParticles.size());
+
+        this->m_SleepingParticles.clear();
+        this->m_SleepingBroadPhase.Clear();
+        for (std::size_t i = 0x0; i < count; i++) {
+            if (this->m_ActiveIndex[i] == none) {
+                this->m_SleepingBroadPhase.Insert(this->m_State.GetLocation(i), this->m_ParticleRadius);
+                this->m_SleepingParticles.push_back(i);
             }
         }
+        this->m_SleepingBroadPhase.Build();
+
+        this->m_isActiveSetDirty  = false;
+        this->m_isBroadPhaseDirty = true;
+    }
+
+    /**
+     * @brief [Method that update sleep counters of awake tiles]
+     * @details [Tile which particles were slower than sleep velocity for sleep step count of steps falls asleep
+     *           and its velocities are zeroed. Sleeping tile wakes up if awake particle joined to it moves]
+     * 
+     * @param state [Updated state, M_STATE or M_ACTIVESTATE]
+     * @param springs [Updated springs]
+     * @param isPartial [True if STATE is M_ACTIVESTATE]
+     * @tparam T [Generic type]
+     * 
+     * @return [-]
+     */
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::UpdateSleep(const FF::ClothState<T>& state, const FF::ClothSprings<T>& springs, bool isPartial){
+        const std::size_t awakeCount     = isPartial ? this->m_AwakeParticleCount : state.GetParticleCount();
+        const T           sleepVelocity2 = FF::sqr(this->m_SleepVelocity);
+
+        auto isMoving = [&state, sleepVelocity2](std::size_t i) {
+            return (state.m_VelocityX[i] * state.m_VelocityX[i] + state.m_VelocityY[i] * state.m_VelocityY[i] + state.m_VelocityZ[i] * state.m_VelocityZ[i]) >= sleepVelocity2;
+        };
 
-        FF::Vector3<T> dampening;
-        for (i = 0x0;i < this->m_TotalRows; i++) {
-            for (j = 0x0; j < this->m_TotalColumns; j++) {
-                dampening = -this->m_linearDampeningCoefficient * this->m_Particles[i][j].GetLinearVelocity();
-                this->m_Particles[i][j].SetLinearVelocity(this->m_Particles[i][j].GetLinearVelocity() + dampening);
+        std::fill(this->m_isTileMoving.begin(), this->m_isTileMoving.end(), 0x0);
+        for (std::size_t i = 0x0; i < awakeCount; i++) {
+            if (isMoving(i)) {
+                this->m_isTileMoving[this->TileIndex(isPartial ? this->m_ActiveParticles[i] : i)] = 0x1;
             }
         }
 
-        // Update each ball.
-        for (i = 0x0; i < this->m_TotalRows; i++) {
-            for (j = 0x0; j < this->m_TotalColumns; j++) {
-                this->m_Particles[i][j].Update(changeInTime);
+        // Wake sleeping tiles pulled by moving neighbours before new tiles fall asleep
+        if (isPartial) {
+            for (std::size_t s = 0x0; s < springs.GetSpringCount(); s++) {
+                const std::size_t first  = springs.m_First[s];
+                const std::size_t second = springs.m_Second[s];
+
+                if (first >= awakeCount && isMoving(second)) {
+                    this->WakeTile(this->TileIndex(this->m_ActiveParticles[first]));
+                } else if (second >= awakeCount && isMoving(first)) {
+                    this->WakeTile(this->TileIndex(this->m_ActiveParticles[second]));
+                }
             }
         }
 
-        return true;
+        bool isAnyAsleep = false;
+        for (std::size_t tile = 0x0; tile < this->m_isTileAwake.size(); tile++) {
+            if (!this->m_isTileAwake[tile]) {
+                continue;
+            }
+
+            this->m_TileSleepCounter[tile] = this->m_isTileMoving[tile] ? 0x0 : this->m_TileSleepCounter[tile] + 0x1;
+
+            if (this->m_TileSleepCounter[tile] >= this->m_SleepStepCount) {
+                this->m_isTileAwake[tile] = 0x0;
+                this->m_AwakeTileCount--;
+                this->m_isActiveSetDirty  = true;
+                isAnyAsleep               = true;
+            }
+        }
+
+        if (isAnyAsleep) {
+            for (std::size_t i = 0x0; i < awakeCount; i++) {
+                const std::size_t particle = isPartial ? this->m_ActiveParticles[i] : i;
+
+                if (!this->m_isTileAwake[this->TileIndex(particle)]) {
+                    this->m_State.SetVelocity(particle, FF::Vector3<T>(0.0f, 0.0f, 0.0f));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief [Method that execute FUNCTION(chunkBegin, chunkEnd) over [BEGIN, END) on worker pool]
+     * @details [Range is executed by calling thread if cloth is single-threaded]
+     * 
+     * @param begin [Begin of range]
+     * @param end [End of range]
+     * @param function [Function void(std::size_t, std::size_t)]
+     * @tparam T [Generic type]
+     * 
+     * @return [-]
+     */
+    template<typename T, typename Integrator>
+    template<typename Function>
+    inline void FF::Cloth<T, Integrator>::ParallelFor(std::size_t begin, std::size_t end, Function function){
+        if (this->m_WorkerPool) {
+            this->m_WorkerPool->ParallelFor(begin, end, function);
+        }
+        else {
+            function(begin, end);
+        }
     }
 
     /**
-     * @brief [Method that render cloth]
-     * @details [Render each of particle that consists in cloth]
+     * @brief [Method that check that candidate pairs of broad phase can miss a contact]
+     * @details [Pair can come closer than diameter only if one of its particles moved more than margin
+     *           since rebuild. Broad phase is outdated also after change of updated particles]
      * 
+     * @param state [State that is updated]
+     * @param isPartial [True if STATE is compact state of awake particles]
      * @tparam T [Generic type]
-     * @return [Return status of render cloth]
+     * 
+     * @return [Return true if broad phase must be rebuilt]
      */
-    template<typename T>
-    inline bool FF::Cloth<T>::Render(void){
-        bool RenderStatus = true;
+    template<typename T, typename Integrator>
+    inline bool FF::Cloth<T, Integrator>::isBroadPhaseOutdated(const FF::ClothState<T>& state, bool isPartial) const {
+        const std::size_t count = state.GetParticleCount();
+
+        if (this->m_isBroadPhaseDirty || this->m_isBroadPhasePartial != isPartial || this->m_BroadPhaseX.size() != count) {
+            return true;
+        }
+
+        // No early exit, so the loop is vectorized
+        T maxDisplacement = static_cast<T>(0x0);
+        for (std::size_t i = 0x0; i < count; i++) {
+            const T displacement = FF::sqr(state.m_LocationX[i] - this->m_BroadPhaseX[i]) +
+                                   FF::sqr(state.m_LocationY[i] - this->m_BroadPhaseY[i]) +
+                                   FF::sqr(state.m_LocationZ[i] - this->m_BroadPhaseZ[i]);
+
+            maxDisplacement = (displacement > maxDisplacement) ? displacement : maxDisplacement;
+        }
+
+        // Negated, so NaN location rebuilds broad phase too
+        return !(maxDisplacement <= FF::sqr(this->m_BroadPhaseMargin));
+    }
+
+    /**
+     * @brief [Method that find candidate pairs of particles]
+     * @details [Spheres are inflated by margin, pairs joined by spring are skipped]
+     * 
+     * @param state [State that is updated]
+     * @param isPartial [True if STATE is compact state of awake particles]
+     * @tparam T [Generic type]
+     * 
+     * @return [-]
+     */
+    template<typename T, typename Integrator>
+    inline void FF::Cloth<T, Integrator>::RebuildBroadPhase(const FF::ClothState<T>& state, bool isPartial){
+        const std::size_t count = state.GetParticleCount();
+
+        auto particle = [this, isPartial](std::size_t i) {
+            return isPartial ? this->m_ActiveParticles[i] : i;
+        };
+
+        this->m_BroadPhase.Clear();
+        for (std::size_t i = 0x0; i < count; i++) {
+            this->m_BroadPhase.Insert(state.GetLocation(i), this->m_ParticleRadius + this->m_BroadPhaseMargin);
+        }
+        this->m_BroadPhase.Build();
+
+        this->m_CandidatePairs.clear();
+        this->m_BroadPhase.QueryPairs(this->m_CandidatePairs, [this, &particle](std::size_t first, std::size_t second) {
+            return this->isSpringConnected(particle(first), particle(second));
+        });
+
+        this->m_BroadPhaseX.assign(state.m_LocationX.begin(), state.m_LocationX.end());
+        this->m_BroadPhaseY.assign(state.m_LocationY.begin(), state.m_LocationY.end());
+        this->m_BroadPhaseZ.assign(state.m_LocationZ.begin(), state.m_LocationZ.end());
+
+        this->m_isBroadPhaseDirty   = false;
+        this->m_isBroadPhasePartial = isPartial;
+    }
+
+    /**
+     * @brief [Method update states from each particle from PARTICLE_BUFFER]
+     * @details [Collisions are handled by calling thread, broad phase is rebuilt only when some particle moved
+     *           more than broad phase margin, otherwise its candidate pairs are only checked for overlap.
+     *           Then velocities are dampened and INTEGRATOR
+     *           moves particles by spring, impulse and constant forces. Springs, dampening and integration run
+     *           on worker pool. Springs of one color don't share particles, so every particle gets forces
+     *           in the same order and result is bitwise the same for any count of threads.
+     *           While some tiles sleep, only awake particles and their sleeping neighbours are gathered
+     *           into compact state, updated and scattered back, so cost follows count of awake particles.
+     *           With __FF_PROFILE every phase, count of collision pairs and count of evaluated springs are recorded]
+     * 
+     * @param changeInTime [Frame of time that need to recalculate states]
+     * @tparam T [Generic type]
+     * @return [-]
+     */
+    template<typename T, typename Integrator>
+    inline bool FF::Cloth<T, Integrator>::Update(const T changeInTime){
+        FF_PROFILE_SCOPE("Cloth::Update");
+
+        const bool isPartial = this->m_AwakeTileCount < this->m_isTileAwake.size();
+        if (isPartial && this->m_isActiveSetDirty) {
+            this->RebuildActiveSet();
+        }
+
+        if (isPartial && this->m_AwakeParticleCount == 0x0) {
+            return true;
+        }
+
+        FF::ClothState<T>&         state   = isPartial ? this->m_ActiveState : this->m_State;
+        const FF::ClothSprings<T>& springs = isPartial ? this->m_ActiveSprings : this->m_Springs;
+        const std::size_t          count   = state.GetParticleCount();
+
+        auto particle = [this, isPartial](std::size_t i) {
+            return isPartial ? this->m_ActiveParticles[i] : i;
+        };
 
-        for (std::size_t i = 0x0; RenderStatus && i < this->m_TotalRows; i++) {
-            for (std::size_t  j = 0x0; RenderStatus && j < this->m_TotalColumns; j++) {
-                RenderStatus = this->m_Particles[i][j].Render();
+        // Gather awake particles and their sleeping neighbours, the latter don't move
+        if (isPartial) {
+            FF_PROFILE_SCOPE("Cloth::Gather");
+
+            this->ParallelFor(0x0, count, [this, &state](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    const std::size_t p = this->m_ActiveParticles[i];
+
+                    state.SetLocation(i, this->m_State.GetLocation(p));
+                    state.SetVelocity(i, this->m_State.GetVelocity(p));
+                    state.SetForce(i, this->m_State.GetForce(p));
+                    state.SetConstantForce(i, this->m_State.GetConstantForce(p));
+                    state.m_InvertMass[i] = this->m_State.m_InvertMass[p];
+                    state.m_StaticMask[i] = (i < this->m_AwakeParticleCount) ? this->m_State.m_StaticMask[p] : 0x1;
+                }
+            });
+        }
+
+        {
+            FF_PROFILE_SCOPE("Cloth::Collision");
+
+            // Rebuild the broad phase only when particles moved out of margin and handle only pairs of particles which bounded spheres overlap
+            {
+                FF_PROFILE_SCOPE("Cloth::BroadPhase");
+
+                if (this->isBroadPhaseOutdated(state, isPartial)) {
+                    FF_PROFILE_SCOPE("Cloth::BroadPhaseRebuild");
+
+                    this->RebuildBroadPhase(state, isPartial);
+                }
+
+                const T minDistance2 = FF::sqr(static_cast<T>(0x2) * this->m_ParticleRadius);
+
+                this->m_CollisionPairs.clear();
+                for (const FF::CollisionPair& pair : this->m_CandidatePairs) {
+                    const T distance2 = FF::sqr(state.m_LocationX[pair.m_First] - state.m_LocationX[pair.m_Second]) +
+                                        FF::sqr(state.m_LocationY[pair.m_First] - state.m_LocationY[pair.m_Second]) +
+                                        FF::sqr(state.m_LocationZ[pair.m_First] - state.m_LocationZ[pair.m_Second]);
+
+                    if (distance2 < minDistance2) {
+                        this->m_CollisionPairs.push_back(pair);
+                    }
+                }
+            }
+            FF_PROFILE_COUNTER("Cloth::CollisionPairs", this->m_CollisionPairs.size());
+
+            for (const FF::CollisionPair& pair : this->m_CollisionPairs) {
+                // Contact wakes sleeping particle
+                if (isPartial) {
+                    if (pair.m_First >= this->m_AwakeParticleCount) {
+                        this->WakeTile(this->TileIndex(particle(pair.m_First)));
+                    }
+                    if (pair.m_Second >= this->m_AwakeParticleCount) {
+                        this->WakeTile(this->TileIndex(particle(pair.m_Second)));
+                    }
+                }
+
+                // Find the distance vector between the particles.
+                FF::Vector3<T> distance = state.GetLocation(pair.m_First) - state.GetLocation(pair.m_Second);
+
+                // Handle the collision.
+                HandleCollision(state, distance, pair.m_First, pair.m_Second);
+            }
+
+            // Sleeping particles out of update are woken by contact and handled from the next step
+            if (isPartial && !this->m_SleepingParticles.empty()) {
+                for (std::size_t i = 0x0; i < this->m_AwakeParticleCount; i++) {
+                    this->m_SleepingBroadPhase.QuerySphere(state.GetLocation(i), this->m_ParticleRadius, [this, &particle, i](std::size_t j) {
+                        const std::size_t sleeping = this->m_SleepingParticles[j];
+
+                        if (!this->isSpringConnected(particle(i), sleeping)) {
+                            this->WakeTile(this->TileIndex(sleeping));
+                        }
+                    });
+                }
             }
         }
 
-        return (RenderStatus);
+        {
+            FF_PROFILE_SCOPE("Cloth::Dampen");
+
+            const T dampening = static_cast<T>(0x1) - this->m_LinearDampeningCoefficient;
+            this->ParallelFor(0x0, count, [&state, dampening](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    state.m_VelocityX[i] *= dampening;
+                    state.m_VelocityY[i] *= dampening;
+                    state.m_VelocityZ[i] *= dampening;
+                }
+            });
+        }
+
+        // Calculate the force exerted by each spring, batch by batch
+        auto accumulateForces = [this, &springs](FF::ClothState<T>& current) {
+            FF_PROFILE_SCOPE("Cloth::SpringForces");
+
+            for (std::size_t c = 0x0; c < springs.GetColorCount(); c++) {
+                this->ParallelFor(springs.m_ColorOffsets[c], springs.m_ColorOffsets[c + 0x1], [&springs, &current](std::size_t begin, std::size_t end) {
+                    springs.CalculateReactions(current, begin, end);
+                });
+            }
+            FF_PROFILE_COUNTER("Cloth::SpringsEvaluated", springs.GetSpringCount());
+        };
+
+        auto parallelFor = [this](std::size_t begin, std::size_t end, auto function) {
+            this->ParallelFor(begin, end, function);
+        };
+
+        // Update each particle.
+        {
+            FF_PROFILE_SCOPE("Cloth::Integrate");
+
+            this->m_Integrator.Integrate(state, springs, accumulateForces, parallelFor, changeInTime);
+        }
+
+        // Scatter awake particles back
+        if (isPartial) {
+            FF_PROFILE_SCOPE("Cloth::Scatter");
+
+            this->ParallelFor(0x0, this->m_AwakeParticleCount, [this, &state](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    const std::size_t p = this->m_ActiveParticles[i];
+
+                    this->m_State.SetLocation(p, state.GetLocation(i));
+                    this->m_State.SetVelocity(p, state.GetVelocity(i));
+                    this->m_State.SetForce(p, state.GetForce(i));
+                }
+            });
+        }
+
+        if (this->m_SleepVelocity > static_cast<T>(0x0)) {
+            FF_PROFILE_SCOPE("Cloth::Sleep");
+
+            this->UpdateSleep(state, springs, isPartial);
+        }
+
+        return true;
     }
 };
 
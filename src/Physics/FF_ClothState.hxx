@@ -0,0 +1,361 @@
+#include <cstdint>
+#include <vector>
+#include <cmath>
+
+#include "../Core/FF_Macros.hxx"
+#include "../Core/FF_CommonMath.hxx"
+
+#include "../Core/FF_Vector3.hxx"
+#include "FF_SpringBatch.hxx"
+
+#ifndef FF_CLOTHSTATE_HXX_
+#define FF_CLOTHSTATE_HXX_
+
+namespace FF {
+    /**
+     * @brief [Structure-of-arrays storage of cloth particles]
+     * @details [Each field of particle is stored in its own contiguous array, particle (row, column)
+     *           of cloth has index row * columns + column in every array]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    struct ClothState {
+        std::vector<T>            m_LocationX;
+        std::vector<T>            m_LocationY;
+        std::vector<T>            m_LocationZ;
+
+        std::vector<T>            m_VelocityX;
+        std::vector<T>            m_VelocityY;
+        std::vector<T>            m_VelocityZ;
+
+        std::vector<T>            m_InvertMass;
+
+        std::vector<T>            m_ForceX;                 // Accumulated (impulse) force, cleared after integration
+        std::vector<T>            m_ForceY;
+        std::vector<T>            m_ForceZ;
+
+        std::vector<T>            m_ConstantForceX;
+        std::vector<T>            m_ConstantForceY;
+        std::vector<T>            m_ConstantForceZ;
+
+        std::vector<std::uint8_t> m_StaticMask;
+
+        inline void        Resize(const std::size_t __FF_IN count);
+        inline std::size_t GetParticleCount(void) const;
+
+        inline FF::Vector3<T> GetLocation(const std::size_t __FF_IN index) const;
+        inline void           SetLocation(const std::size_t __FF_IN index, const FF::Vector3<T>& __FF_IN location);
+
+        inline FF::Vector3<T> GetVelocity(const std::size_t __FF_IN index) const;
+        inline void           SetVelocity(const std::size_t __FF_IN index, const FF::Vector3<T>& __FF_IN velocity);
+
+        inline FF::Vector3<T> GetForce(const std::size_t __FF_IN index) const;
+        inline void           SetForce(const std::size_t __FF_IN index, const FF::Vector3<T>& __FF_IN force);
+
+        inline FF::Vector3<T> GetConstantForce(const std::size_t __FF_IN index) const;
+        inline void           SetConstantForce(const std::size_t __FF_IN index, const FF::Vector3<T>& __FF_IN force);
+    };
+
+    /**
+     * @brief [Flat spring topology of cloth]
+     * @details [Spring I connects particles M_FIRST[I] and M_SECOND[I] of FF::ClothState,
+     *           all properties of springs are stored in parallel arrays]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    struct ClothSprings {
+        std::vector<std::uint32_t> m_First;
+        std::vector<std::uint32_t> m_Second;
+
+        std::vector<T>             m_RestLength;
+        std::vector<T>             m_Stiffness;
+        std::vector<T>             m_Dampening;
+
+        std::vector<std::size_t>   m_ColorOffsets;          // Springs of color C are [M_COLOROFFSETS[C], M_COLOROFFSETS[C + 1])
+
+        inline void        Reserve(const std::size_t __FF_IN count);
+        inline void        Clear(void);
+        inline std::size_t GetSpringCount(void) const;
+        inline std::size_t GetColorCount(void) const;
+
+        inline std::vector<std::size_t> SortByColor(const std::size_t __FF_IN particleCount);
+
+        inline std::size_t AddSpring( const std::size_t __FF_IN first,
+                                      const std::size_t __FF_IN second,
+                                      const T           __FF_IN restLength,
+                                      const T           __FF_IN stiffness,
+                                      const T           __FF_IN dampening );
+
+        inline void CalculateReactions( FF::ClothState<T>& __FF_OUT state,
+                                        const std::size_t  __FF_IN  begin,
+                                        const std::size_t  __FF_IN  end ) const;
+    };
+
+    /**
+     * @brief [Method that resize every array of state]
+     * @details [New particles are at origin, at rest, have zero invert mass and aren't static]
+     *
+     * @param count [Count of particles]
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    inline void FF::ClothState<T>::Resize(const std::size_t __FF_IN count){
+        this->m_LocationX.resize(count, static_cast<T>(0x0));
+        this->m_LocationY.resize(count, static_cast<T>(0x0));
+        this->m_LocationZ.resize(count, static_cast<T>(0x0));
+
+        this->m_VelocityX.resize(count, static_cast<T>(0x0));
+        this->m_VelocityY.resize(count, static_cast<T>(0x0));
+        this->m_VelocityZ.resize(count, static_cast<T>(0x0));
+
+        this->m_InvertMass.resize(count, static_cast<T>(0x0));
+
+        this->m_ForceX.resize(count, static_cast<T>(0x0));
+        this->m_ForceY.resize(count, static_cast<T>(0x0));
+        this->m_ForceZ.resize(count, static_cast<T>(0x0));
+
+        this->m_ConstantForceX.resize(count, static_cast<T>(0x0));
+        this->m_ConstantForceY.resize(count, static_cast<T>(0x0));
+        this->m_ConstantForceZ.resize(count, static_cast<T>(0x0));
+
+        this->m_StaticMask.resize(count, 0x0);
+    }
+
+    template<typename T>
+    inline std::size_t FF::ClothState<T>::GetParticleCount(void) const {
+        return this->m_LocationX.size();
+    }
+
+    template<typename T>
+    inline FF::Vector3<T> FF::ClothState<T>::GetLocation(const std::size_t __FF_IN index) const {
+        return FF::Vector3<T>(this->m_LocationX[index], this->m_LocationY[index], this->m_LocationZ[index]);
+    }
+
+    template<typename T>
+    inline void FF::ClothState<T>::SetLocation(const std::size_t __FF_IN index, const FF::Vector3<T>& __FF_IN location){
+        this->m_LocationX[index] = location.GetXComponent();
+        this->m_LocationY[index] = location.GetYComponent();
+        this->m_LocationZ[index] = location.GetZComponent();
+    }
+
+    template<typename T>
+    inline FF::Vector3<T> FF::ClothState<T>::GetVelocity(const std::size_t __FF_IN index) const {
+        return FF::Vector3<T>(this->m_VelocityX[index], this->m_VelocityY[index], this->m_VelocityZ[index]);
+    }
+
+    template<typename T>
+    inline void FF::ClothState<T>::SetVelocity(const std::size_t __FF_IN index, const FF::Vector3<T>& __FF_IN velocity){
+        this->m_VelocityX[index] = velocity.GetXComponent();
+        this->m_VelocityY[index] = velocity.GetYComponent();
+        this->m_VelocityZ[index] = velocity.GetZComponent();
+    }
+
+    template<typename T>
+    inline FF::Vector3<T> FF::ClothState<T>::GetForce(const std::size_t __FF_IN index) const {
+        return FF::Vector3<T>(this->m_ForceX[index], this->m_ForceY[index], this->m_ForceZ[index]);
+    }
+
+    template<typename T>
+    inline void FF::ClothState<T>::SetForce(const std::size_t __FF_IN index, const FF::Vector3<T>& __FF_IN force){
+        this->m_ForceX[index] = force.GetXComponent();
+        this->m_ForceY[index] = force.GetYComponent();
+        this->m_ForceZ[index] = force.GetZComponent();
+    }
+
+    template<typename T>
+    inline FF::Vector3<T> FF::ClothState<T>::GetConstantForce(const std::size_t __FF_IN index) const {
+        return FF::Vector3<T>(this->m_ConstantForceX[index], this->m_ConstantForceY[index], this->m_ConstantForceZ[index]);
+    }
+
+    template<typename T>
+    inline void FF::ClothState<T>::SetConstantForce(const std::size_t __FF_IN index, const FF::Vector3<T>& __FF_IN force){
+        this->m_ConstantForceX[index] = force.GetXComponent();
+        this->m_ConstantForceY[index] = force.GetYComponent();
+        this->m_ConstantForceZ[index] = force.GetZComponent();
+    }
+
+    template<typename T>
+    inline void FF::ClothSprings<T>::Reserve(const std::size_t __FF_IN count){
+        this->m_First.reserve(count);
+        this->m_Second.reserve(count);
+        this->m_RestLength.reserve(count);
+        this->m_Stiffness.reserve(count);
+        this->m_Dampening.reserve(count);
+    }
+
+    template<typename T>
+    inline void FF::ClothSprings<T>::Clear(void){
+        this->m_First.clear();
+        this->m_Second.clear();
+        this->m_RestLength.clear();
+        this->m_Stiffness.clear();
+        this->m_Dampening.clear();
+        this->m_ColorOffsets.clear();
+    }
+
+    template<typename T>
+    inline std::size_t FF::ClothSprings<T>::GetSpringCount(void) const {
+        return this->m_First.size();
+    }
+
+    template<typename T>
+    inline std::size_t FF::ClothSprings<T>::GetColorCount(void) const {
+        return (this->m_ColorOffsets.empty() ? 0x0 : this->m_ColorOffsets.size() - 0x1);
+    }
+
+    /**
+     * @brief [Method that group springs into batches that don't share particles]
+     * @details [Springs are colored greedily so that two springs of one color never touch the same particle,
+     *           then springs are stably sorted by color. Springs of one batch can be evaluated in parallel
+     *           without synchronization, and the forces of each particle are accumulated in the same order
+     *           whatever the count of threads is]
+     *
+     * @param particleCount [Count of particles that springs connect]
+     * @tparam T [Generic type]
+     *
+     * @return [Return new index of every spring]
+     */
+    template<typename T>
+    inline std::vector<std::size_t> FF::ClothSprings<T>::SortByColor(const std::size_t __FF_IN particleCount){
+        const std::size_t count = this->GetSpringCount();
+
+        std::vector<std::uint64_t> usedColors(particleCount, 0x0);
+        std::vector<std::uint8_t>  color(count);
+        std::size_t                totalColors = 0x0;
+
+        for (std::size_t s = 0x0; s < count; s++) {
+            const std::uint64_t used = usedColors[this->m_First[s]] | usedColors[this->m_Second[s]];
+
+            std::size_t c = 0x0;
+            while (used & (static_cast<std::uint64_t>(0x1) << c)) {
+                c++;
+            }
+            FF_ASSERT_MESSAGE(c < 0x40, "Particle is connected to too many springs to color them!");
+
+            color[s] = static_cast<std::uint8_t>(c);
+            usedColors[this->m_First[s]]  |= (static_cast<std::uint64_t>(0x1) << c);
+            usedColors[this->m_Second[s]] |= (static_cast<std::uint64_t>(0x1) << c);
+
+            totalColors = FF::max(totalColors, c + 0x1);
+        }
+
+        this->m_ColorOffsets.assign(totalColors + 0x1, 0x0);
+        for (std::size_t s = 0x0; s < count; s++) {
+            this->m_ColorOffsets[color[s] + 0x1]++;
+        }
+        for (std::size_t c = 0x1; c <= totalColors; c++) {
+            this->m_ColorOffsets[c] += this->m_ColorOffsets[c - 0x1];
+        }
+
+        std::vector<std::size_t> cursor(this->m_ColorOffsets.begin(), this->m_ColorOffsets.end() - 0x1);
+        std::vector<std::size_t> newIndex(count);
+        for (std::size_t s = 0x0; s < count; s++) {
+            newIndex[s] = cursor[color[s]]++;
+        }
+
+        FF::ClothSprings<T> sorted;
+        sorted.m_First.resize(count);
+        sorted.m_Second.resize(count);
+        sorted.m_RestLength.resize(count);
+        sorted.m_Stiffness.resize(count);
+        sorted.m_Dampening.resize(count);
+
+        for (std::size_t s = 0x0; s < count; s++) {
+            sorted.m_First[newIndex[s]]      = this->m_First[s];
+            sorted.m_Second[newIndex[s]]     = this->m_Second[s];
+            sorted.m_RestLength[newIndex[s]] = this->m_RestLength[s];
+            sorted.m_Stiffness[newIndex[s]]  = this->m_Stiffness[s];
+            sorted.m_Dampening[newIndex[s]]  = this->m_Dampening[s];
+        }
+
+        this->m_First.swap(sorted.m_First);
+        this->m_Second.swap(sorted.m_Second);
+        this->m_RestLength.swap(sorted.m_RestLength);
+        this->m_Stiffness.swap(sorted.m_Stiffness);
+        this->m_Dampening.swap(sorted.m_Dampening);
+
+        return newIndex;
+    }
+
+    /**
+     * @brief [Method that add spring between two particles]
+     * @details [-]
+     *
+     * @param first [Index of first particle]
+     * @param second [Index of second particle]
+     * @param restLength [Length of spring at rest]
+     * @param stiffness [Hooke coefficient]
+     * @param dampening [Dampening coefficient]
+     * @tparam T [Generic type]
+     *
+     * @return [Return index of new spring]
+     */
+    template<typename T>
+    inline std::size_t FF::ClothSprings<T>::AddSpring( const std::size_t __FF_IN first,
+                                                       const std::size_t __FF_IN second,
+                                                       const T           __FF_IN restLength,
+                                                       const T           __FF_IN stiffness,
+                                                       const T           __FF_IN dampening ){
+        FF_ASSERT_MESSAGE(first != second, "Spring must connect two different particles!");
+
+        this->m_First.push_back(static_cast<std::uint32_t>(first));
+        this->m_Second.push_back(static_cast<std::uint32_t>(second));
+        this->m_RestLength.push_back(restLength);
+        this->m_Stiffness.push_back(stiffness);
+        this->m_Dampening.push_back(dampening);
+
+        return (this->m_First.size() - 0x1);
+    }
+
+    /**
+     * @brief [Method that accumulate forces of springs in range [BEGIN, END) to particles]
+     * @details [Forces are calculated by FF::SpringBatch chunk by chunk, then the force of spring is
+     *           subtracted from force of first particle and added to second particle]
+     *
+     * @param state [State of particles, forces are accumulated to M_FORCE arrays]
+     * @param begin [First spring]
+     * @param end [Spring after last]
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    inline void FF::ClothSprings<T>::CalculateReactions( FF::ClothState<T>& __FF_OUT state,
+                                                         const std::size_t  __FF_IN  begin,
+                                                         const std::size_t  __FF_IN  end ) const {
+        FF_ASSERT(end <= this->GetSpringCount());
+
+        constexpr std::size_t CHUNK_SIZE = 0x100;
+
+        alignas(0x20) T fx[CHUNK_SIZE];
+        alignas(0x20) T fy[CHUNK_SIZE];
+        alignas(0x20) T fz[CHUNK_SIZE];
+
+        for (std::size_t chunk = begin; chunk < end; chunk += CHUNK_SIZE) {
+            const std::size_t count = FF::min(CHUNK_SIZE, end - chunk);
+
+            FF::SpringBatch<T>::CalculateForces( state.m_LocationX.data(), state.m_LocationY.data(), state.m_LocationZ.data(),
+                                                 state.m_VelocityX.data(), state.m_VelocityY.data(), state.m_VelocityZ.data(),
+                                                 this->m_First.data() + chunk, this->m_Second.data() + chunk,
+                                                 this->m_RestLength.data() + chunk, this->m_Stiffness.data() + chunk, this->m_Dampening.data() + chunk,
+                                                 fx, fy, fz,
+                                                 count );
+
+            // Apply the response force to the particles
+            for (std::size_t s = 0x0; s < count; s++) {
+                const std::uint32_t a = this->m_First[chunk + s];
+                const std::uint32_t b = this->m_Second[chunk + s];
+
+                state.m_ForceX[a] -= fx[s];
+                state.m_ForceY[a] -= fy[s];
+                state.m_ForceZ[a] -= fz[s];
+
+                state.m_ForceX[b] += fx[s];
+                state.m_ForceY[b] += fy[s];
+                state.m_ForceZ[b] += fz[s];
+            }
+        }
+    }
+};
+
+#endif // FF_CLOTHSTATE_HXX_
@@ -1,4 +1,4 @@
-#include "..\Core\FF_Vector3.hxx"
+#include "../Core/FF_Vector3.hxx"
 
 #ifndef FF_FORCE_HXX_
 #define FF_FORCE_HXX_
@@ -12,8 +12,8 @@ namespace FF {
 	public:
 		explicit Force(void) = delete;
 
-		explicit Force( T v11 = static_cast<T>(0.0f), v12 = static_cast<T>(0.0f), v13 = static_cast<T>(0.0f),
-				 		  v21 = static_cast<T>(0.0f), v22 = static_cast<T>(0.0f), v23 = static_cast<T>(0.0f) )
+		explicit Force( T v11 = static_cast<T>(0.0f), T v12 = static_cast<T>(0.0f), T v13 = static_cast<T>(0.0f),
+				 		T v21 = static_cast<T>(0.0f), T v22 = static_cast<T>(0.0f), T v23 = static_cast<T>(0.0f) )
 		: m_Direction{v11, v12, v13}, m_Location{v21, v22, v23} {}
 
 		explicit Force( FF::Vector3<T> vec1,
@@ -25,33 +25,32 @@ namespace FF {
 		inline FF::Vector3<T> GetDirection(void) const;
 		inline void 		  SetDirection(const FF::Vector3<T>& __FF_IN direction);
 
-		~Force(void);
+		~Force(void) = default;
 	};
 
 	template<typename T>
 	FF::Force<T>::Force( FF::Vector3<T> vec1,
-			             FF::Vector3<T> vec2 ){
-		this->m_Direction = vec1;
-		this->m_Location  = vec2;
-	}
+			             FF::Vector3<T> vec2 )
+	: m_Direction(vec1),
+	  m_Location(vec2) {}
 
 	template<typename T>
-	inline FF::Vector3<T> GetLocation(void) const {
+	inline FF::Vector3<T> FF::Force<T>::GetLocation(void) const {
 		return this->m_Location;
 	}
 
 	template<typename T>
-	inline void 		  SetLocation(const FF::Vector3<T>& __FF_IN location){
+	inline void 		  FF::Force<T>::SetLocation(const FF::Vector3<T>& __FF_IN location){
 		this->m_Location = location;
 	}
 
 	template<typename T>
-	inline FF::Vector3<T> GetDirection(void) const {
+	inline FF::Vector3<T> FF::Force<T>::GetDirection(void) const {
 		return this->m_Direction;
 	}
 
 	template<typename T>
-	inline void 		  SetDirection(const FF::Vector3<T>& __FF_IN direction){
+	inline void 		  FF::Force<T>::SetDirection(const FF::Vector3<T>& __FF_IN direction){
 		this->m_Direction = direction;
 	}
 };
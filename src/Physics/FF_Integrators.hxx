@@ -0,0 +1,727 @@
+#include <cstdint>
+#include <vector>
+#include <cmath>
+
+#include "../Core/FF_Macros.hxx"
+#include "../Core/FF_CommonMath.hxx"
+
+#include "../Core/FF_Vector3.hxx"
+#include "FF_ClothState.hxx"
+
+#ifndef FF_INTEGRATORS_HXX_
+#define FF_INTEGRATORS_HXX_
+
+/**
+ * Integrators are policies that passed as template parameter to FF::MaterialPointBase, FF::RigidBody and FF::Cloth.
+ *
+ * Point interface (static):
+ *     Integrate(location, velocity, acceleration, changeInTime)
+ *     ACCELERATION is FF::Vector3<T>(const FF::Vector3<T>& location, const FF::Vector3<T>& velocity)
+ *
+ * Cloth interface:
+ *     Integrate(state, springs, accumulateForces, parallelFor, changeInTime)
+ *     ACCUMULATEFORCES is void(FF::ClothState<T>&), it adds internal forces of current locations and velocities to M_FORCE*.
+ *     On input M_FORCE* of state keeps impulse forces, on output it is cleared. Static particles are never moved.
+ *     PARALLELFOR is void(std::size_t begin, std::size_t end, void(std::size_t chunkBegin, std::size_t chunkEnd)),
+ *     chunks must not write the same particle.
+ */
+namespace FF {
+    /**
+     * @brief   [Semi-implicit (symplectic) Euler integrator]
+     * @details [Velocity is updated first and the new velocity moves location. One force evaluation per step,
+     *           energy of conservative system oscillates but doesn't drift]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    class SymplecticEuler {
+    public:
+        template<typename Acceleration>
+        static inline void Integrate( FF::Vector3<T>& __FF_OUT location,
+                                      FF::Vector3<T>& __FF_OUT velocity,
+                                      Acceleration    __FF_IN  acceleration,
+                                      const T         __FF_IN  changeInTime );
+
+        template<typename ForceFunction, typename ParallelFunction>
+        inline void Integrate( FF::ClothState<T>&         __FF_OUT state,
+                               const FF::ClothSprings<T>& __FF_IN  springs,
+                               ForceFunction              __FF_IN  accumulateForces,
+                               ParallelFunction           __FF_IN  parallelFor,
+                               const T                    __FF_IN  changeInTime );
+    };
+
+    /**
+     * @brief   [Position Verlet (drift-kick-drift leapfrog) integrator]
+     * @details [Location is moved by half step, velocity is kicked by force at middle location, then location is
+     *           moved by second half step. One force evaluation per step, second order and symplectic]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    class PositionVerlet {
+    public:
+        template<typename Acceleration>
+        static inline void Integrate( FF::Vector3<T>& __FF_OUT location,
+                                      FF::Vector3<T>& __FF_OUT velocity,
+                                      Acceleration    __FF_IN  acceleration,
+                                      const T         __FF_IN  changeInTime );
+
+        template<typename ForceFunction, typename ParallelFunction>
+        inline void Integrate( FF::ClothState<T>&         __FF_OUT state,
+                               const FF::ClothSprings<T>& __FF_IN  springs,
+                               ForceFunction              __FF_IN  accumulateForces,
+                               ParallelFunction           __FF_IN  parallelFor,
+                               const T                    __FF_IN  changeInTime );
+    };
+
+    /**
+     * @brief   [Classic fourth order Runge-Kutta integrator]
+     * @details [Four force evaluations per step. It is the most accurate for smooth forces,
+     *           but it isn't symplectic and has the same stability limit as explicit methods]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    class RungeKutta4 {
+    private:
+        std::vector<T> m_StartLocationX;
+        std::vector<T> m_StartLocationY;
+        std::vector<T> m_StartLocationZ;
+
+        std::vector<T> m_StartVelocityX;
+        std::vector<T> m_StartVelocityY;
+        std::vector<T> m_StartVelocityZ;
+
+        std::vector<T> m_ImpulseForceX;
+        std::vector<T> m_ImpulseForceY;
+        std::vector<T> m_ImpulseForceZ;
+
+        std::vector<T> m_SumVelocityX;                      // Weighted sum of stage velocities (derivatives of location)
+        std::vector<T> m_SumVelocityY;
+        std::vector<T> m_SumVelocityZ;
+
+        std::vector<T> m_SumAccelerationX;                  // Weighted sum of stage accelerations (derivatives of velocity)
+        std::vector<T> m_SumAccelerationY;
+        std::vector<T> m_SumAccelerationZ;
+    public:
+        template<typename Acceleration>
+        static inline void Integrate( FF::Vector3<T>& __FF_OUT location,
+                                      FF::Vector3<T>& __FF_OUT velocity,
+                                      Acceleration    __FF_IN  acceleration,
+                                      const T         __FF_IN  changeInTime );
+
+        template<typename ForceFunction, typename ParallelFunction>
+        inline void Integrate( FF::ClothState<T>&         __FF_OUT state,
+                               const FF::ClothSprings<T>& __FF_IN  springs,
+                               ForceFunction              __FF_IN  accumulateForces,
+                               ParallelFunction           __FF_IN  parallelFor,
+                               const T                    __FF_IN  changeInTime );
+    };
+
+    /**
+     * @brief   [Implicit (backward) Euler cloth solver]
+     * @details [One Newton step of backward Euler is taken as in "Large Steps in Cloth Simulation" (Baraff, Witkin):
+     *           (M - h * df/dv - h^2 * df/dx) * dv = h * (f + h * df/dx * v).
+     *           Jacobians of springs are never assembled, the system is solved by Jacobi preconditioned conjugate
+     *           gradient with matrix-free product over colored batches of springs. Stiffness of compressed springs
+     *           is clamped, so the matrix stays positive definite. It is stable for any stiffness and step,
+     *           but it dissipates energy. It has only cloth interface, because it needs spring Jacobians]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    class BackwardEuler {
+    private:
+        std::size_t    m_MaxIterations;
+        T              m_Tolerance;
+        std::size_t    m_LastIterationCount;
+
+        std::vector<T> m_SystemMatrix;                      // Symmetric 3x3 block of each spring: XX, XY, XZ, YY, YZ, ZZ
+
+        std::vector<T> m_RightSideX;
+        std::vector<T> m_RightSideY;
+        std::vector<T> m_RightSideZ;
+
+        std::vector<T> m_InvertDiagonalX;
+        std::vector<T> m_InvertDiagonalY;
+        std::vector<T> m_InvertDiagonalZ;
+
+        std::vector<T> m_DeltaVelocityX;
+        std::vector<T> m_DeltaVelocityY;
+        std::vector<T> m_DeltaVelocityZ;
+
+        std::vector<T> m_ResidualX;
+        std::vector<T> m_ResidualY;
+        std::vector<T> m_ResidualZ;
+
+        std::vector<T> m_DirectionX;
+        std::vector<T> m_DirectionY;
+        std::vector<T> m_DirectionZ;
+
+        std::vector<T> m_ProductX;
+        std::vector<T> m_ProductY;
+        std::vector<T> m_ProductZ;
+
+        template<typename ParallelFunction>
+        inline void Multiply( const FF::ClothState<T>&   __FF_IN  state,
+                              const FF::ClothSprings<T>& __FF_IN  springs,
+                              ParallelFunction           __FF_IN  parallelFor );
+    public:
+        /**
+         * @brief [Constructor with parameters]
+         *
+         * @param maxIterations [Upper bound of conjugate gradient iterations per step]
+         * @param tolerance [Relative residual at which conjugate gradient stops]
+         */
+        explicit BackwardEuler( const std::size_t __FF_IN maxIterations = 0x40,
+                                const T           __FF_IN tolerance     = static_cast<T>(1E-4) );
+
+        inline std::size_t GetMaxIterations(void) const;
+        inline void        SetMaxIterations(const std::size_t __FF_IN maxIterations);
+
+        inline T           GetTolerance(void) const;
+        inline void        SetTolerance(const T __FF_IN tolerance);
+
+        inline std::size_t GetLastIterationCount(void) const;
+
+        template<typename ForceFunction, typename ParallelFunction>
+        inline void Integrate( FF::ClothState<T>&         __FF_OUT state,
+                               const FF::ClothSprings<T>& __FF_IN  springs,
+                               ForceFunction              __FF_IN  accumulateForces,
+                               ParallelFunction           __FF_IN  parallelFor,
+                               const T                    __FF_IN  changeInTime );
+    };
+
+    // Semi-implicit Euler
+
+    template<typename T>
+    template<typename Acceleration>
+    inline void FF::SymplecticEuler<T>::Integrate( FF::Vector3<T>& __FF_OUT location,
+                                                   FF::Vector3<T>& __FF_OUT velocity,
+                                                   Acceleration    __FF_IN  acceleration,
+                                                   const T         __FF_IN  changeInTime ){
+        velocity += acceleration(location, velocity) * changeInTime;
+        location += velocity * changeInTime;
+    }
+
+    template<typename T>
+    template<typename ForceFunction, typename ParallelFunction>
+    inline void FF::SymplecticEuler<T>::Integrate( FF::ClothState<T>&         __FF_OUT state,
+                                                   const FF::ClothSprings<T>& __FF_IN  /*springs*/,
+                                                   ForceFunction              __FF_IN  accumulateForces,
+                                                   ParallelFunction           __FF_IN  parallelFor,
+                                                   const T                    __FF_IN  changeInTime ){
+        accumulateForces(state);
+
+        parallelFor(0x0, state.GetParticleCount(), [&state, changeInTime](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                if (!state.m_StaticMask[i]) {
+                    state.m_VelocityX[i] += (state.m_ForceX[i] + state.m_ConstantForceX[i]) * state.m_InvertMass[i] * changeInTime;
+                    state.m_VelocityY[i] += (state.m_ForceY[i] + state.m_ConstantForceY[i]) * state.m_InvertMass[i] * changeInTime;
+                    state.m_VelocityZ[i] += (state.m_ForceZ[i] + state.m_ConstantForceZ[i]) * state.m_InvertMass[i] * changeInTime;
+
+                    state.m_LocationX[i] += state.m_VelocityX[i] * changeInTime;
+                    state.m_LocationY[i] += state.m_VelocityY[i] * changeInTime;
+                    state.m_LocationZ[i] += state.m_VelocityZ[i] * changeInTime;
+                }
+
+                state.m_ForceX[i] = static_cast<T>(0x0);
+                state.m_ForceY[i] = static_cast<T>(0x0);
+                state.m_ForceZ[i] = static_cast<T>(0x0);
+            }
+        });
+    }
+
+    // Position Verlet
+
+    template<typename T>
+    template<typename Acceleration>
+    inline void FF::PositionVerlet<T>::Integrate( FF::Vector3<T>& __FF_OUT location,
+                                                  FF::Vector3<T>& __FF_OUT velocity,
+                                                  Acceleration    __FF_IN  acceleration,
+                                                  const T         __FF_IN  changeInTime ){
+        const T halfTime = changeInTime / static_cast<T>(0x2);
+
+        location += velocity * halfTime;
+        velocity += acceleration(location, velocity) * changeInTime;
+        location += velocity * halfTime;
+    }
+
+    template<typename T>
+    template<typename ForceFunction, typename ParallelFunction>
+    inline void FF::PositionVerlet<T>::Integrate( FF::ClothState<T>&         __FF_OUT state,
+                                                  const FF::ClothSprings<T>& __FF_IN  /*springs*/,
+                                                  ForceFunction              __FF_IN  accumulateForces,
+                                                  ParallelFunction           __FF_IN  parallelFor,
+                                                  const T                    __FF_IN  changeInTime ){
+        const T halfTime = changeInTime / static_cast<T>(0x2);
+
+        // Drift to the middle of step
+        parallelFor(0x0, state.GetParticleCount(), [&state, halfTime](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                if (!state.m_StaticMask[i]) {
+                    state.m_LocationX[i] += state.m_VelocityX[i] * halfTime;
+                    state.m_LocationY[i] += state.m_VelocityY[i] * halfTime;
+                    state.m_LocationZ[i] += state.m_VelocityZ[i] * halfTime;
+                }
+            }
+        });
+
+        accumulateForces(state);
+
+        // Kick by the force at the middle and drift to the end of step
+        parallelFor(0x0, state.GetParticleCount(), [&state, changeInTime, halfTime](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                if (!state.m_StaticMask[i]) {
+                    state.m_VelocityX[i] += (state.m_ForceX[i] + state.m_ConstantForceX[i]) * state.m_InvertMass[i] * changeInTime;
+                    state.m_VelocityY[i] += (state.m_ForceY[i] + state.m_ConstantForceY[i]) * state.m_InvertMass[i] * changeInTime;
+                    state.m_VelocityZ[i] += (state.m_ForceZ[i] + state.m_ConstantForceZ[i]) * state.m_InvertMass[i] * changeInTime;
+
+                    state.m_LocationX[i] += state.m_VelocityX[i] * halfTime;
+                    state.m_LocationY[i] += state.m_VelocityY[i] * halfTime;
+                    state.m_LocationZ[i] += state.m_VelocityZ[i] * halfTime;
+                }
+
+                state.m_ForceX[i] = static_cast<T>(0x0);
+                state.m_ForceY[i] = static_cast<T>(0x0);
+                state.m_ForceZ[i] = static_cast<T>(0x0);
+            }
+        });
+    }
+
+    // Runge-Kutta 4
+
+    template<typename T>
+    template<typename Acceleration>
+    inline void FF::RungeKutta4<T>::Integrate( FF::Vector3<T>& __FF_OUT location,
+                                               FF::Vector3<T>& __FF_OUT velocity,
+                                               Acceleration    __FF_IN  acceleration,
+                                               const T         __FF_IN  changeInTime ){
+        const T halfTime = changeInTime / static_cast<T>(0x2);
+
+        FF::Vector3<T> firstVelocity(velocity);
+        FF::Vector3<T> firstAcceleration  = acceleration(location, velocity);
+
+        FF::Vector3<T> secondVelocity     = velocity + firstAcceleration * halfTime;
+        FF::Vector3<T> secondAcceleration = acceleration(location + firstVelocity * halfTime, secondVelocity);
+
+        FF::Vector3<T> thirdVelocity      = velocity + secondAcceleration * halfTime;
+        FF::Vector3<T> thirdAcceleration  = acceleration(location + secondVelocity * halfTime, thirdVelocity);
+
+        FF::Vector3<T> fourthVelocity     = velocity + thirdAcceleration * changeInTime;
+        FF::Vector3<T> fourthAcceleration = acceleration(location + thirdVelocity * changeInTime, fourthVelocity);
+
+        const T sixthTime = changeInTime / static_cast<T>(0x6);
+
+        location += (firstVelocity + (secondVelocity + thirdVelocity) * static_cast<T>(0x2) + fourthVelocity) * sixthTime;
+        velocity += (firstAcceleration + (secondAcceleration + thirdAcceleration) * static_cast<T>(0x2) + fourthAcceleration) * sixthTime;
+    }
+
+    template<typename T>
+    template<typename ForceFunction, typename ParallelFunction>
+    inline void FF::RungeKutta4<T>::Integrate( FF::ClothState<T>&         __FF_OUT state,
+                                               const FF::ClothSprings<T>& __FF_IN  /*springs*/,
+                                               ForceFunction              __FF_IN  accumulateForces,
+                                               ParallelFunction           __FF_IN  parallelFor,
+                                               const T                    __FF_IN  changeInTime ){
+        const std::size_t count = state.GetParticleCount();
+
+        this->m_StartLocationX.assign(state.m_LocationX.begin(), state.m_LocationX.end());
+        this->m_StartLocationY.assign(state.m_LocationY.begin(), state.m_LocationY.end());
+        this->m_StartLocationZ.assign(state.m_LocationZ.begin(), state.m_LocationZ.end());
+
+        this->m_StartVelocityX.assign(state.m_VelocityX.begin(), state.m_VelocityX.end());
+        this->m_StartVelocityY.assign(state.m_VelocityY.begin(), state.m_VelocityY.end());
+        this->m_StartVelocityZ.assign(state.m_VelocityZ.begin(), state.m_VelocityZ.end());
+
+        this->m_ImpulseForceX.assign(state.m_ForceX.begin(), state.m_ForceX.end());
+        this->m_ImpulseForceY.assign(state.m_ForceY.begin(), state.m_ForceY.end());
+        this->m_ImpulseForceZ.assign(state.m_ForceZ.begin(), state.m_ForceZ.end());
+
+        this->m_SumVelocityX.assign(count, static_cast<T>(0x0));
+        this->m_SumVelocityY.assign(count, static_cast<T>(0x0));
+        this->m_SumVelocityZ.assign(count, static_cast<T>(0x0));
+
+        this->m_SumAccelerationX.assign(count, static_cast<T>(0x0));
+        this->m_SumAccelerationY.assign(count, static_cast<T>(0x0));
+        this->m_SumAccelerationZ.assign(count, static_cast<T>(0x0));
+
+        // Stage S is evaluated at start + STAGETIME[S] * derivatives of stage S - 1, its derivatives have weight STAGEWEIGHT[S]
+        const T stageTime[0x4]   = { static_cast<T>(0x0), changeInTime / static_cast<T>(0x2), changeInTime / static_cast<T>(0x2), changeInTime };
+        const T stageWeight[0x4] = { static_cast<T>(0x1), static_cast<T>(0x2), static_cast<T>(0x2), static_cast<T>(0x1) };
+        const T sixthTime        = changeInTime / static_cast<T>(0x6);
+
+        for (std::size_t stage = 0x0; stage < 0x4; stage++) {
+            accumulateForces(state);
+
+            const bool isLastStage = (stage == 0x3);
+            const T    weight      = stageWeight[stage];
+            const T    nextTime    = isLastStage ? static_cast<T>(0x0) : stageTime[stage + 0x1];
+
+            parallelFor(0x0, count, [this, &state, isLastStage, weight, nextTime, sixthTime](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    if (!state.m_StaticMask[i]) {
+                        const T accelerationX = (state.m_ForceX[i] + state.m_ConstantForceX[i]) * state.m_InvertMass[i];
+                        const T accelerationY = (state.m_ForceY[i] + state.m_ConstantForceY[i]) * state.m_InvertMass[i];
+                        const T accelerationZ = (state.m_ForceZ[i] + state.m_ConstantForceZ[i]) * state.m_InvertMass[i];
+
+                        this->m_SumVelocityX[i] += weight * state.m_VelocityX[i];
+                        this->m_SumVelocityY[i] += weight * state.m_VelocityY[i];
+                        this->m_SumVelocityZ[i] += weight * state.m_VelocityZ[i];
+
+                        this->m_SumAccelerationX[i] += weight * accelerationX;
+                        this->m_SumAccelerationY[i] += weight * accelerationY;
+                        this->m_SumAccelerationZ[i] += weight * accelerationZ;
+
+                        if (isLastStage) {
+                            state.m_LocationX[i] = this->m_StartLocationX[i] + this->m_SumVelocityX[i] * sixthTime;
+                            state.m_LocationY[i] = this->m_StartLocationY[i] + this->m_SumVelocityY[i] * sixthTime;
+                            state.m_LocationZ[i] = this->m_StartLocationZ[i] + this->m_SumVelocityZ[i] * sixthTime;
+
+                            state.m_VelocityX[i] = this->m_StartVelocityX[i] + this->m_SumAccelerationX[i] * sixthTime;
+                            state.m_VelocityY[i] = this->m_StartVelocityY[i] + this->m_SumAccelerationY[i] * sixthTime;
+                            state.m_VelocityZ[i] = this->m_StartVelocityZ[i] + this->m_SumAccelerationZ[i] * sixthTime;
+                        }
+                        else {
+                            // Location uses velocity of current stage, so it is moved before velocity is overwritten
+                            state.m_LocationX[i] = this->m_StartLocationX[i] + state.m_VelocityX[i] * nextTime;
+                            state.m_LocationY[i] = this->m_StartLocationY[i] + state.m_VelocityY[i] * nextTime;
+                            state.m_LocationZ[i] = this->m_StartLocationZ[i] + state.m_VelocityZ[i] * nextTime;
+
+                            state.m_VelocityX[i] = this->m_StartVelocityX[i] + accelerationX * nextTime;
+                            state.m_VelocityY[i] = this->m_StartVelocityY[i] + accelerationY * nextTime;
+                            state.m_VelocityZ[i] = this->m_StartVelocityZ[i] + accelerationZ * nextTime;
+                        }
+                    }
+
+                    state.m_ForceX[i] = isLastStage ? static_cast<T>(0x0) : this->m_ImpulseForceX[i];
+                    state.m_ForceY[i] = isLastStage ? static_cast<T>(0x0) : this->m_ImpulseForceY[i];
+                    state.m_ForceZ[i] = isLastStage ? static_cast<T>(0x0) : this->m_ImpulseForceZ[i];
+                }
+            });
+        }
+    }
+
+    // Backward Euler
+
+    template<typename T>
+    FF::BackwardEuler<T>::BackwardEuler( const std::size_t __FF_IN maxIterations,
+                                         const T           __FF_IN tolerance )
+    : m_MaxIterations(maxIterations),
+      m_Tolerance(tolerance),
+      m_LastIterationCount(0x0) {
+        FF_ASSERT_MESSAGE(maxIterations > 0x0, "Conjugate gradient must do at least one iteration!");
+    }
+
+    template<typename T>
+    inline std::size_t FF::BackwardEuler<T>::GetMaxIterations(void) const {
+        return this->m_MaxIterations;
+    }
+
+    template<typename T>
+    inline void FF::BackwardEuler<T>::SetMaxIterations(const std::size_t __FF_IN maxIterations){
+        FF_ASSERT_MESSAGE(maxIterations > 0x0, "Conjugate gradient must do at least one iteration!");
+        this->m_MaxIterations = maxIterations;
+    }
+
+    template<typename T>
+    inline T FF::BackwardEuler<T>::GetTolerance(void) const {
+        return this->m_Tolerance;
+    }
+
+    template<typename T>
+    inline void FF::BackwardEuler<T>::SetTolerance(const T __FF_IN tolerance){
+        this->m_Tolerance = tolerance;
+    }
+
+    /**
+     * @brief [Method that get count of conjugate gradient iterations of last step]
+     * @details [If it is equal to max iterations, the system wasn't solved to tolerance]
+     *
+     * @tparam T [Generic type]
+     * @return [Return count of iterations]
+     */
+    template<typename T>
+    inline std::size_t FF::BackwardEuler<T>::GetLastIterationCount(void) const {
+        return this->m_LastIterationCount;
+    }
+
+    /**
+     * @brief [Method that multiply system matrix by search direction]
+     * @details [M_PRODUCT = (M + sum of spring blocks) * M_DIRECTION, rows of static particles are zero]
+     *
+     * @param state [State of particles]
+     * @param springs [Springs of cloth]
+     * @param parallelFor [Parallel loop]
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    template<typename ParallelFunction>
+    inline void FF::BackwardEuler<T>::Multiply( const FF::ClothState<T>&   __FF_IN  state,
+                                                const FF::ClothSprings<T>& __FF_IN  springs,
+                                                ParallelFunction           __FF_IN  parallelFor ){
+        parallelFor(0x0, state.GetParticleCount(), [this, &state](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                const T mass = static_cast<T>(0x1) / state.m_InvertMass[i];
+
+                this->m_ProductX[i] = mass * this->m_DirectionX[i];
+                this->m_ProductY[i] = mass * this->m_DirectionY[i];
+                this->m_ProductZ[i] = mass * this->m_DirectionZ[i];
+            }
+        });
+
+        for (std::size_t c = 0x0; c < springs.GetColorCount(); c++) {
+            parallelFor(springs.m_ColorOffsets[c], springs.m_ColorOffsets[c + 0x1], [this, &springs](std::size_t begin, std::size_t end) {
+                for (std::size_t s = begin; s < end; s++) {
+                    const std::uint32_t a     = springs.m_First[s];
+                    const std::uint32_t b     = springs.m_Second[s];
+                    const T*            block = this->m_SystemMatrix.data() + s * 0x6;
+
+                    const T dx = this->m_DirectionX[a] - this->m_DirectionX[b];
+                    const T dy = this->m_DirectionY[a] - this->m_DirectionY[b];
+                    const T dz = this->m_DirectionZ[a] - this->m_DirectionZ[b];
+
+                    const T px = block[0x0] * dx + block[0x1] * dy + block[0x2] * dz;
+                    const T py = block[0x1] * dx + block[0x3] * dy + block[0x4] * dz;
+                    const T pz = block[0x2] * dx + block[0x4] * dy + block[0x5] * dz;
+
+                    this->m_ProductX[a] += px;
+                    this->m_ProductY[a] += py;
+                    this->m_ProductZ[a] += pz;
+
+                    this->m_ProductX[b] -= px;
+                    this->m_ProductY[b] -= py;
+                    this->m_ProductZ[b] -= pz;
+                }
+            });
+        }
+
+        for (std::size_t i = 0x0; i < state.GetParticleCount(); i++) {
+            if (state.m_StaticMask[i]) {
+                this->m_ProductX[i] = static_cast<T>(0x0);
+                this->m_ProductY[i] = static_cast<T>(0x0);
+                this->m_ProductZ[i] = static_cast<T>(0x0);
+            }
+        }
+    }
+
+    template<typename T>
+    template<typename ForceFunction, typename ParallelFunction>
+    inline void FF::BackwardEuler<T>::Integrate( FF::ClothState<T>&         __FF_OUT state,
+                                                 const FF::ClothSprings<T>& __FF_IN  springs,
+                                                 ForceFunction              __FF_IN  accumulateForces,
+                                                 ParallelFunction           __FF_IN  parallelFor,
+                                                 const T                    __FF_IN  changeInTime ){
+        const std::size_t count = state.GetParticleCount();
+        const T           time  = changeInTime;
+        const T           time2 = changeInTime * changeInTime;
+
+        this->m_SystemMatrix.resize(springs.GetSpringCount() * 0x6);
+
+        accumulateForces(state);
+
+        this->m_RightSideX.resize(count);
+        this->m_RightSideY.resize(count);
+        this->m_RightSideZ.resize(count);
+
+        this->m_InvertDiagonalX.resize(count);
+        this->m_InvertDiagonalY.resize(count);
+        this->m_InvertDiagonalZ.resize(count);
+
+        // Right side starts from h * f, mass is the diagonal of system
+        for (std::size_t i = 0x0; i < count; i++) {
+            FF_ASSERT_MESSAGE(!FF::CloseToZero(state.m_InvertMass[i]), "Backward Euler needs finite mass of every particle, use static flag instead!");
+
+            const T mass = static_cast<T>(0x1) / state.m_InvertMass[i];
+
+            this->m_RightSideX[i] = time * (state.m_ForceX[i] + state.m_ConstantForceX[i]);
+            this->m_RightSideY[i] = time * (state.m_ForceY[i] + state.m_ConstantForceY[i]);
+            this->m_RightSideZ[i] = time * (state.m_ForceZ[i] + state.m_ConstantForceZ[i]);
+
+            this->m_InvertDiagonalX[i] = mass;
+            this->m_InvertDiagonalY[i] = mass;
+            this->m_InvertDiagonalZ[i] = mass;
+        }
+
+        // Build block of each spring and add h^2 * df/dx * v to right side
+        for (std::size_t c = 0x0; c < springs.GetColorCount(); c++) {
+            parallelFor(springs.m_ColorOffsets[c], springs.m_ColorOffsets[c + 0x1], [this, &state, &springs, time, time2](std::size_t begin, std::size_t end) {
+                for (std::size_t s = begin; s < end; s++) {
+                    const std::uint32_t a     = springs.m_First[s];
+                    const std::uint32_t b     = springs.m_Second[s];
+                    T*                  block = this->m_SystemMatrix.data() + s * 0x6;
+
+                    const T dx = state.m_LocationX[a] - state.m_LocationX[b];
+                    const T dy = state.m_LocationY[a] - state.m_LocationY[b];
+                    const T dz = state.m_LocationZ[a] - state.m_LocationZ[b];
+
+                    const T length = std::sqrt((dx * dx + dy * dy) + dz * dz);
+                    if (FF::CloseToZero(length)) {
+                        for (std::size_t k = 0x0; k < 0x6; k++) {
+                            block[k] = static_cast<T>(0x0);
+                        }
+                        continue;
+                    }
+
+                    const T nx = dx / length;
+                    const T ny = dy / length;
+                    const T nz = dz / length;
+
+                    // -df/dx = k * (n * n^T + (1 - rest / length) * (I - n * n^T)), compressed springs have no transverse stiffness
+                    const T stiffness  = springs.m_Stiffness[s];
+                    const T transverse = stiffness * FF::max(static_cast<T>(0x0), static_cast<T>(0x1) - springs.m_RestLength[s] / length);
+                    const T axial      = stiffness - transverse;
+
+                    const T stiffnessXX = axial * nx * nx + transverse;
+                    const T stiffnessXY = axial * nx * ny;
+                    const T stiffnessXZ = axial * nx * nz;
+                    const T stiffnessYY = axial * ny * ny + transverse;
+                    const T stiffnessYZ = axial * ny * nz;
+                    const T stiffnessZZ = axial * nz * nz + transverse;
+
+                    // -df/dv = c * n * n^T
+                    const T dampening = time * springs.m_Dampening[s];
+
+                    block[0x0] = time2 * stiffnessXX + dampening * nx * nx;
+                    block[0x1] = time2 * stiffnessXY + dampening * nx * ny;
+                    block[0x2] = time2 * stiffnessXZ + dampening * nx * nz;
+                    block[0x3] = time2 * stiffnessYY + dampening * ny * ny;
+                    block[0x4] = time2 * stiffnessYZ + dampening * ny * nz;
+                    block[0x5] = time2 * stiffnessZZ + dampening * nz * nz;
+
+                    const T vx = state.m_VelocityX[a] - state.m_VelocityX[b];
+                    const T vy = state.m_VelocityY[a] - state.m_VelocityY[b];
+                    const T vz = state.m_VelocityZ[a] - state.m_VelocityZ[b];
+
+                    const T rx = time2 * (stiffnessXX * vx + stiffnessXY * vy + stiffnessXZ * vz);
+                    const T ry = time2 * (stiffnessXY * vx + stiffnessYY * vy + stiffnessYZ * vz);
+                    const T rz = time2 * (stiffnessXZ * vx + stiffnessYZ * vy + stiffnessZZ * vz);
+
+                    this->m_RightSideX[a] -= rx;
+                    this->m_RightSideY[a] -= ry;
+                    this->m_RightSideZ[a] -= rz;
+
+                    this->m_RightSideX[b] += rx;
+                    this->m_RightSideY[b] += ry;
+                    this->m_RightSideZ[b] += rz;
+
+                    this->m_InvertDiagonalX[a] += block[0x0];
+                    this->m_InvertDiagonalY[a] += block[0x3];
+                    this->m_InvertDiagonalZ[a] += block[0x5];
+
+                    this->m_InvertDiagonalX[b] += block[0x0];
+                    this->m_InvertDiagonalY[b] += block[0x3];
+                    this->m_InvertDiagonalZ[b] += block[0x5];
+                }
+            });
+        }
+
+        this->m_DeltaVelocityX.assign(count, static_cast<T>(0x0));
+        this->m_DeltaVelocityY.assign(count, static_cast<T>(0x0));
+        this->m_DeltaVelocityZ.assign(count, static_cast<T>(0x0));
+
+        this->m_ResidualX.resize(count);
+        this->m_ResidualY.resize(count);
+        this->m_ResidualZ.resize(count);
+
+        this->m_DirectionX.resize(count);
+        this->m_DirectionY.resize(count);
+        this->m_DirectionZ.resize(count);
+
+        this->m_ProductX.resize(count);
+        this->m_ProductY.resize(count);
+        this->m_ProductZ.resize(count);
+
+        // Preconditioned conjugate gradient, static particles are filtered out of residual
+        T rightSideNorm = static_cast<T>(0x0);
+        T residualDot   = static_cast<T>(0x0);
+
+        for (std::size_t i = 0x0; i < count; i++) {
+            const T filter = state.m_StaticMask[i] ? static_cast<T>(0x0) : static_cast<T>(0x1);
+
+            this->m_InvertDiagonalX[i] = static_cast<T>(0x1) / this->m_InvertDiagonalX[i];
+            this->m_InvertDiagonalY[i] = static_cast<T>(0x1) / this->m_InvertDiagonalY[i];
+            this->m_InvertDiagonalZ[i] = static_cast<T>(0x1) / this->m_InvertDiagonalZ[i];
+
+            this->m_ResidualX[i] = filter * this->m_RightSideX[i];
+            this->m_ResidualY[i] = filter * this->m_RightSideY[i];
+            this->m_ResidualZ[i] = filter * this->m_RightSideZ[i];
+
+            this->m_DirectionX[i] = this->m_InvertDiagonalX[i] * this->m_ResidualX[i];
+            this->m_DirectionY[i] = this->m_InvertDiagonalY[i] * this->m_ResidualY[i];
+            this->m_DirectionZ[i] = this->m_InvertDiagonalZ[i] * this->m_ResidualZ[i];
+
+            rightSideNorm += (FF::sqr(this->m_ResidualX[i]) + FF::sqr(this->m_ResidualY[i])) + FF::sqr(this->m_ResidualZ[i]);
+            residualDot   += (this->m_ResidualX[i] * this->m_DirectionX[i] + this->m_ResidualY[i] * this->m_DirectionY[i]) + this->m_ResidualZ[i] * this->m_DirectionZ[i];
+        }
+
+        const T stopNorm = FF::sqr(this->m_Tolerance) * rightSideNorm;
+
+        this->m_LastIterationCount = 0x0;
+        while (this->m_LastIterationCount < this->m_MaxIterations && !FF::CloseToZero(rightSideNorm)) {
+            this->Multiply(state, springs, parallelFor);
+            this->m_LastIterationCount++;
+
+            T directionProduct = static_cast<T>(0x0);
+            for (std::size_t i = 0x0; i < count; i++) {
+                directionProduct += (this->m_DirectionX[i] * this->m_ProductX[i] + this->m_DirectionY[i] * this->m_ProductY[i]) + this->m_DirectionZ[i] * this->m_ProductZ[i];
+            }
+
+            if (FF::CloseToZero(directionProduct)) {
+                break;
+            }
+
+            const T alpha = residualDot / directionProduct;
+
+            T residualNorm    = static_cast<T>(0x0);
+            T nextResidualDot = static_cast<T>(0x0);
+            for (std::size_t i = 0x0; i < count; i++) {
+                this->m_DeltaVelocityX[i] += alpha * this->m_DirectionX[i];
+                this->m_DeltaVelocityY[i] += alpha * this->m_DirectionY[i];
+                this->m_DeltaVelocityZ[i] += alpha * this->m_DirectionZ[i];
+
+                this->m_ResidualX[i] -= alpha * this->m_ProductX[i];
+                this->m_ResidualY[i] -= alpha * this->m_ProductY[i];
+                this->m_ResidualZ[i] -= alpha * this->m_ProductZ[i];
+
+                residualNorm    += (FF::sqr(this->m_ResidualX[i]) + FF::sqr(this->m_ResidualY[i])) + FF::sqr(this->m_ResidualZ[i]);
+                nextResidualDot += (this->m_ResidualX[i] * this->m_InvertDiagonalX[i] * this->m_ResidualX[i] +
+                                    this->m_ResidualY[i] * this->m_InvertDiagonalY[i] * this->m_ResidualY[i]) +
+                                    this->m_ResidualZ[i] * this->m_InvertDiagonalZ[i] * this->m_ResidualZ[i];
+            }
+
+            if (residualNorm <= stopNorm) {
+                break;
+            }
+
+            const T beta = nextResidualDot / residualDot;
+            residualDot  = nextResidualDot;
+
+            for (std::size_t i = 0x0; i < count; i++) {
+                this->m_DirectionX[i] = this->m_InvertDiagonalX[i] * this->m_ResidualX[i] + beta * this->m_DirectionX[i];
+                this->m_DirectionY[i] = this->m_InvertDiagonalY[i] * this->m_ResidualY[i] + beta * this->m_DirectionY[i];
+                this->m_DirectionZ[i] = this->m_InvertDiagonalZ[i] * this->m_ResidualZ[i] + beta * this->m_DirectionZ[i];
+            }
+        }
+
+        parallelFor(0x0, count, [this, &state, changeInTime](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                if (!state.m_StaticMask[i]) {
+                    state.m_VelocityX[i] += this->m_DeltaVelocityX[i];
+                    state.m_VelocityY[i] += this->m_DeltaVelocityY[i];
+                    state.m_VelocityZ[i] += this->m_DeltaVelocityZ[i];
+
+                    state.m_LocationX[i] += state.m_VelocityX[i] * changeInTime;
+                    state.m_LocationY[i] += state.m_VelocityY[i] * changeInTime;
+                    state.m_LocationZ[i] += state.m_VelocityZ[i] * changeInTime;
+                }
+
+                state.m_ForceX[i] = static_cast<T>(0x0);
+                state.m_ForceY[i] = static_cast<T>(0x0);
+                state.m_ForceZ[i] = static_cast<T>(0x0);
+            }
+        });
+    }
+};
+
+#endif // FF_INTEGRATORS_HXX_
@@ -1,13 +1,21 @@
-#include "..\Core\FF_Macros.hxx"
-#include "..\Core\FF_Vector3.hxx"
+#include "../Core/FF_Macros.hxx"
+#include "../Core/FF_Vector3.hxx"
 
 #include "FF_Force.hxx"
+#include "FF_Integrators.hxx"
 
 #ifndef FF_MATERIALPOINTBASE_HXX_
 #define FF_MATERIALPOINTBASE_HXX_
 
 namespace FF {
-    template<typename T>
+    /**
+     * @brief [Point mass without orientation]
+     * @details [Linear dampening is a force against velocity, integrator evaluates it at velocity of each stage]
+     *
+     * @tparam T [Generic type]
+     * @tparam Integrator [Point integrator from FF_Integrators.hxx]
+     */
+    template<typename T, typename Integrator = FF::SymplecticEuler<T>>
     class MaterialPointBase {
     private:
         T              m_Mass;
@@ -15,6 +23,7 @@ namespace FF {
 
         T              m_Restitution;
         T              m_BoundedSphereRadius;
+        T              m_LinearDampening;
         
         FF::Vector3<T> m_Location;
         FF::Vector3<T> m_LinearVelocity;
@@ -31,18 +40,19 @@ namespace FF {
                                     T               restitution         = static_cast<T>(0.0f),
                                     T               boundedSphereRadius = static_cast<T>(0.0f),
 
-                                    FF::Vector3<T>& location      = FF::Vector3<T>(0.0f, 0.0f, 0.0f),
-                                    FF::Vector3<T>& velocity      = FF::Vector3<T>(0.0f, 0.0f, 0.0f),
-                                    FF::Vector3<T>& acceleration  = FF::Vector3<T>(0.0f, 0.0f, 0.0f),
+                                    const FF::Vector3<T>& location      = FF::Vector3<T>(0.0f, 0.0f, 0.0f),
+                                    const FF::Vector3<T>& velocity      = FF::Vector3<T>(0.0f, 0.0f, 0.0f),
+                                    const FF::Vector3<T>& acceleration  = FF::Vector3<T>(0.0f, 0.0f, 0.0f),
 
-                                    FF::Force<T>&   constantForce = FF::Force<T>(FF::Vector3<T>(0.0f, 0.0f, 0.0f), FF::Vector3<T>(0.0f, 0.0f, 0.0f)),
-                                    FF::Force<T>&   impulseForce  = FF::Force<T>(FF::Vector3<T>(0.0f, 0.0f, 0.0f), FF::Vector3<T>(0.0f, 0.0f, 0.0f)),
+                                    const FF::Force<T>&   constantForce = FF::Force<T>(FF::Vector3<T>(0.0f, 0.0f, 0.0f), FF::Vector3<T>(0.0f, 0.0f, 0.0f)),
+                                    const FF::Force<T>&   impulseForce  = FF::Force<T>(FF::Vector3<T>(0.0f, 0.0f, 0.0f), FF::Vector3<T>(0.0f, 0.0f, 0.0f)),
 
-                                    bool            isStatic = false )
+                                    bool                  isStatic = false )
         : m_Mass(mass), 
-          m_InvertMass(0x1 / mass),
+          m_InvertMass(FF::CloseToZero(mass) ? static_cast<T>(0x0) : static_cast<T>(0x1) / mass),
           m_Restitution(restitution),
           m_BoundedSphereRadius(boundedSphereRadius),
+          m_LinearDampening(static_cast<T>(0x0)),
           m_Location(location),
           m_LinearVelocity(velocity),
           m_LinearAcceleration(acceleration),
@@ -50,7 +60,7 @@ namespace FF {
           m_ImpulseForce(impulseForce),
           m_isStatic(isStatic) {}
 
-        explicit MaterialPointBase(FF::MaterialPointBase<T>& mp);
+        explicit MaterialPointBase(FF::MaterialPointBase<T, Integrator>& mp);
 
         inline const T GetMass(void) const;
         inline void    SetMass(const T mass); 
@@ -64,6 +74,9 @@ namespace FF {
         inline const T GetBoundedSphereRadius(void) const;
         inline void    SetBoundedSphereRadius(const T radius);
 
+        inline const T GetLinearDampening(void) const;
+        inline void    SetLinearDampening(const T dampening);
+
         inline const FF::Vector3<T> GetLocation(void) const;
         inline void                 SetLocation(FF::Vector3<T>& location);
 
@@ -86,67 +99,89 @@ namespace FF {
         ~MaterialPointBase(void) = default;    
     };
 
-    template<typename T>
-    FF::MaterialPointBase<T>::MaterialPointBase(FF::MaterialPointBase<T>& mp){
-        this->m_Mass                = mp.GetMass();
-        this->m_InvertMass          = mp.GetInvertMass();
-        this->m_Restitution         = mp.GetRestitution();
-        this->m_BoundedSphereRadius = mp.GetBoundedSphereRadius();
-        this->m_Location            = mp.GetLocation();
-        this->m_LinearVelocity      = mp.GetVelocity();
-        this->m_LinearAcceleration  = mp.GetAcceleration();
-        this->m_ConstantForce       = mp.GetConstantForce();
-        this->m_ImpulseForce        = mp.GetImpulseForce();
-        this->m_isStatic            = mp.isStatic();
-    }
-
-    template<typename T>
-    inline const T FF::MaterialPointBase<T>::GetMass(void) const {
-        return 0x1 / this->m_Mass;
+    template<typename T, typename Integrator>
+    FF::MaterialPointBase<T, Integrator>::MaterialPointBase(FF::MaterialPointBase<T, Integrator>& mp)
+    : m_Mass(mp.GetMass()),
+      m_InvertMass(mp.GetInvertMass()),
+      m_Restitution(mp.GetRestitution()),
+      m_BoundedSphereRadius(mp.GetBoundedSphereRadius()),
+      m_LinearDampening(mp.GetLinearDampening()),
+      m_Location(mp.GetLocation()),
+      m_LinearVelocity(mp.GetVelocity()),
+      m_LinearAcceleration(mp.GetAcceleration()),
+      m_ConstantForce(mp.GetConstantForce()),
+      m_ImpulseForce(mp.GetImpulseForce()),
+      m_isStatic(mp.isStatic()) {}
+
+    template<typename T, typename Integrator>
+    inline const T FF::MaterialPointBase<T, Integrator>::GetMass(void) const {
+        return this->m_Mass;
     }
 
-    template<typename T>
-    inline void    FF::MaterialPointBase<T>::SetMass(const T mass){
-        this->m_Mass = 0x1 / mass;
+    template<typename T, typename Integrator>
+    inline void    FF::MaterialPointBase<T, Integrator>::SetMass(const T mass){
+        this->m_Mass       = mass;
+        this->m_InvertMass = FF::CloseToZero(mass) ? static_cast<T>(0x0) : static_cast<T>(0x1) / mass;
     }
 
-    template<typename T>
-    inline const T FF::MaterialPointBase<T>::GetInvertMass(void) const {
+    template<typename T, typename Integrator>
+    inline const T FF::MaterialPointBase<T, Integrator>::GetInvertMass(void) const {
         return this->m_InvertMass;
     }
 
-    template<typename T>
-    inline void    FF::MaterialPointBase<T>::SetInvertMass(const T mass){
+    template<typename T, typename Integrator>
+    inline void    FF::MaterialPointBase<T, Integrator>::SetInvertMass(const T mass){
         this->m_InvertMass = mass;
+        this->m_Mass       = FF::CloseToZero(mass) ? static_cast<T>(0x0) : static_cast<T>(0x1) / mass;
     }
 
-    template<typename T>
-    inline const T FF::MaterialPointBase<T>::GetRestitution(void) const {
+    template<typename T, typename Integrator>
+    inline const T FF::MaterialPointBase<T, Integrator>::GetRestitution(void) const {
         return this->m_Restitution;
     }
 
-    template<typename T>
-    inline void FF::MaterialPointBase<T>::SetRestitution(T restitution){
+    template<typename T, typename Integrator>
+    inline void FF::MaterialPointBase<T, Integrator>::SetRestitution(T restitution){
         this->m_Restitution = restitution;
     }
 
-    template<typename T>
-    inline const T FF::MaterialPointBase<T>::GetBoundedSphereRadius(void) const {
+    template<typename T, typename Integrator>
+    inline const T FF::MaterialPointBase<T, Integrator>::GetBoundedSphereRadius(void) const {
         return this->m_BoundedSphereRadius;
     }
 
-    template<typename T>
-    inline void FF::MaterialPointBase<T>::SetBoundedSphereRadius(T radius){
+    template<typename T, typename Integrator>
+    inline void FF::MaterialPointBase<T, Integrator>::SetBoundedSphereRadius(T radius){
         this->m_BoundedSphereRadius = radius;
     }
 
-    template<typename T>
-    inline const FF::Vector3<T> FF::MaterialPointBase<T>::GetVelocity(void) const {
+    template<typename T, typename Integrator>
+    inline const T FF::MaterialPointBase<T, Integrator>::GetLinearDampening(void) const {
+        return this->m_LinearDampening;
+    }
+
+    /**
+     * @brief [Method that set coefficient of force against velocity]
+     * @details [Force is -DAMPENING * velocity, zero disables dampening]
+     * 
+     * @param dampening [Dampening coefficient]
+     * @tparam T [Generic type]
+     * 
+     * @return [-]
+     */
+    template<typename T, typename Integrator>
+    inline void FF::MaterialPointBase<T, Integrator>::SetLinearDampening(T dampening){
+        FF_ASSERT_MESSAGE(dampening >= static_cast<T>(0x0), "Dampening can't be negative!");
+        this->m_LinearDampening = dampening;
+    }
+
+    template<typename T, typename Integrator>
+    inline const FF::Vector3<T> FF::MaterialPointBase<T, Integrator>::GetVelocity(void) const {
         return this->m_LinearVelocity;
     }
 
-    template<typename T>
-    inline void FF::MaterialPointBase<T>::SetVelocity(FF::Vector3<T>& velocity){
+    template<typename T, typename Integrator>
+    inline void FF::MaterialPointBase<T, Integrator>::SetVelocity(FF::Vector3<T>& velocity){
         if (m_isStatic) {
             this->m_LinearVelocity = FF::Vector3<T>(0.0f, 0.0f, 0.0f);
         } else {
@@ -154,22 +189,22 @@ namespace FF {
         }
     }
 
-    template<typename T>
-    inline const FF::Vector3<T> FF::MaterialPointBase<T>::GetLocation(void) const {
+    template<typename T, typename Integrator>
+    inline const FF::Vector3<T> FF::MaterialPointBase<T, Integrator>::GetLocation(void) const {
         return this->m_Location;
     }
-    template<typename T>
-    inline void FF::MaterialPointBase<T>::SetLocation(FF::Vector3<T>& location){
+    template<typename T, typename Integrator>
+    inline void FF::MaterialPointBase<T, Integrator>::SetLocation(FF::Vector3<T>& location){
         this->m_Location = location;
     }    
 
-    template<typename T>
-    inline const FF::Vector3<T> FF::MaterialPointBase<T>::GetAcceleration(void) const {
+    template<typename T, typename Integrator>
+    inline const FF::Vector3<T> FF::MaterialPointBase<T, Integrator>::GetAcceleration(void) const {
         return this-> m_LinearAcceleration;
     }
 
-    template<typename T>
-    inline void FF::MaterialPointBase<T>::SetAcceleration(FF::Vector3<T>& acceleration){
+    template<typename T, typename Integrator>
+    inline void FF::MaterialPointBase<T, Integrator>::SetAcceleration(FF::Vector3<T>& acceleration){
         if (m_isStatic) {
             this->m_LinearAcceleration = FF::Vector3<T>(0.0f, 0.0f, 0.0f);
         } else {
@@ -177,13 +212,13 @@ namespace FF {
         }
     }
 
-    template<typename T>
-    inline const FF::Force<T> FF::MaterialPointBase<T>::GetConstantForce(void) const {
+    template<typename T, typename Integrator>
+    inline const FF::Force<T> FF::MaterialPointBase<T, Integrator>::GetConstantForce(void) const {
         return this->m_ConstantForce;
     }
 
-    template<typename T>
-    inline void FF::MaterialPointBase<T>::SetConstantForce(FF::Force<T>& force){
+    template<typename T, typename Integrator>
+    inline void FF::MaterialPointBase<T, Integrator>::SetConstantForce(FF::Force<T>& force){
         if (m_isStatic) {
             this->m_ConstantForce = FF::Force<T>(FF::Vector3<T>(0.0f, 0.0f, 0.0f), FF::Vector3<T>(0.0f, 0.0f, 0.0f));
         } else {
@@ -191,34 +226,53 @@ namespace FF {
         }
     }
 
-    template<typename T>
-    inline const FF::Force<T> FF::MaterialPointBase<T>::GetImpulseForce(void) const {
-        return this->m_ImpulseForces;
+    template<typename T, typename Integrator>
+    inline const FF::Force<T> FF::MaterialPointBase<T, Integrator>::GetImpulseForce(void) const {
+        return this->m_ImpulseForce;
     }
 
-    template<typename T>
-    inline void FF::MaterialPointBase<T>::SetImpulseForce(FF::Force<T>& force){
+    template<typename T, typename Integrator>
+    inline void FF::MaterialPointBase<T, Integrator>::SetImpulseForce(FF::Force<T>& force){
         if (m_isStatic) {
-            this->m_ImpulseForces = FF::Force<T>(FF::Vector3<T>(0.0f, 0.0f, 0.0f), FF::Vector3<T>(0.0f, 0.0f, 0.0f));
+            this->m_ImpulseForce = FF::Force<T>(FF::Vector3<T>(0.0f, 0.0f, 0.0f), FF::Vector3<T>(0.0f, 0.0f, 0.0f));
         } else {
-            this->m_ImpulseForces = force;
+            this->m_ImpulseForce = force;
         }
     }
 
-    template<typename T>
-    inline const bool FF::MaterialPointBase<T>::isStatic(void){
+    template<typename T, typename Integrator>
+    inline const bool FF::MaterialPointBase<T, Integrator>::isStatic(void){
         return this->m_isStatic;
     }
 
-    template<typename T>
-    inline const bool FF::MaterialPointBase<T>::Update(const T changeInTime) {
-        /*FF_ASSERT(m_Mass != 0x0);
-        m_LinearAcceleration = (m_ConstantForce + m_ImpulseForce) / m_Mass;
+    /**
+     * @brief [Method that move material point by constant and impulse forces]
+     * @details [Impulse force acts during one step only. Point is moved by INTEGRATOR, zero invert mass means infinite mass.
+     *           Dampening force is evaluated at velocity of each stage, so integrators of higher order are more accurate]
+     * 
+     * @param changeInTime [Frame of time]
+     * @tparam T [Generic type]
+     * @tparam Integrator [Point integrator]
+     * 
+     * @return [Return true if point is updated]
+     */
+    template<typename T, typename Integrator>
+    inline const bool FF::MaterialPointBase<T, Integrator>::Update(const T changeInTime) {
+        if (this->m_isStatic) {
+            return true;
+        }
+
+        // Constant and impulse forces don't change during the step, only dampening depends on state of the stage
+        const FF::Vector3<T> force = this->m_ConstantForce.GetDirection() + this->m_ImpulseForce.GetDirection();
+
+        auto acceleration = [this, &force](const FF::Vector3<T>&, const FF::Vector3<T>& velocity) {
+            return (force - velocity * this->m_LinearDampening) * this->m_InvertMass;
+        };
 
-        m_ImpulseForce = FF::Vector3<T>(0.0f, 0.0f, 0.0f);
+        this->m_LinearAcceleration = acceleration(this->m_Location, this->m_LinearVelocity);
+        Integrator::Integrate(this->m_Location, this->m_LinearVelocity, acceleration, changeInTime);
 
-        m_LinearVelocity += m_LinearAcceleration   * changeInTime;
-        m_Location       += m_LinearVelocity       * changeInTime;*/
+        this->m_ImpulseForce = FF::Force<T>(FF::Vector3<T>(0.0f, 0.0f, 0.0f), FF::Vector3<T>(0.0f, 0.0f, 0.0f));
 
         // to-do: create matrix translation
         return true;
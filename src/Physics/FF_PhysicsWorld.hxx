@@ -0,0 +1,792 @@
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#include "../Core/FF_Macros.hxx"
+#include "../Core/FF_CommonMath.hxx"
+#include "../Core/FF_Profiler.hxx"
+
+#include "../Core/FF_Vector3.hxx"
+#include "FF_RigidBody.hxx"
+#include "FF_Integrators.hxx"
+#include "Collision/FF_AABB.hxx"
+#include "Collision/FF_BoundedSphere.hxx"
+#include "Collision/FF_Collision.hxx"
+#include "Collision/FF_DynamicAABBTree.hxx"
+#include "Collision/FF_SpatialHash.hxx"
+
+#ifndef FF_PHYSICSWORLD_HXX_
+#define FF_PHYSICSWORLD_HXX_
+
+namespace FF {
+	/**
+	 * @brief [World of rigid bodies with dynamic AABB tree broad phase]
+	 * @details [Bodies live in a pool and are addressed by handles, handles of destroyed bodies are reused.
+	 *           Each body is bounded by sphere of its radius and has a proxy in FF::DynamicAABBTree.
+	 *           Only bodies that left their fat box are reinserted and queried for new pairs, pairs of other
+	 *           bodies are kept from previous steps. Each body knows its pairs, so cost of pair update grows
+	 *           with count of moving bodies.
+	 *           Contact pairs are overlaps of fat boxes, narrow phase must test the real shapes.
+	 *           Bodies which bounding spheres touch form islands. Island falls asleep when all its bodies stay
+	 *           slower than sleep velocity for sleep step count of steps, sleeping bodies are not integrated and
+	 *           not queried, so cost of Step() grows with count of awake bodies. Island wakes up when any its
+	 *           body gets force or velocity, or when awake body touches it. Sleeping is disabled until positive
+	 *           sleep velocity is set]
+	 *
+	 * @tparam T [Generic type]
+	 * @tparam Integrator [Point integrator from FF_Integrators.hxx]
+	 */
+	template<typename T, typename Integrator = FF::SymplecticEuler<T>>
+	class PhysicsWorld {
+	public:
+		using BodyHandle = std::size_t;
+
+		struct RayCastHit {
+			BodyHandle m_Body;
+			T          m_Distance;
+		};
+	private:
+		std::vector<FF::RigidBody<T, Integrator>> m_Bodies;
+		std::vector<T>                            m_Radius;
+		std::vector<std::int32_t>                 m_Proxy;				// NULL_NODE for destroyed bodies
+		std::vector<std::uint8_t>                 m_isMoved;
+		std::vector<BodyHandle>                   m_FreeBodies;
+
+		FF::DynamicAABBTree<T>                    m_Tree;
+		T                                         m_PredictionMultiplier;
+
+		std::vector<BodyHandle>                   m_MoveBuffer;
+		std::vector<FF::CollisionPair>            m_Pairs;
+		std::vector<std::vector<std::size_t>>     m_BodyPairs;			// Indices of pairs of each body in M_PAIRS
+
+		T                                         m_SleepVelocity;
+		std::size_t                               m_SleepStepCount;
+
+		std::vector<BodyHandle>                   m_AwakeBodies;
+		std::vector<std::uint8_t>                 m_isListed;			// Body is in M_AWAKEBODIES
+		std::vector<std::uint8_t>                 m_isAsleep;
+		std::size_t                               m_SleepingBodyCount;
+		std::vector<std::size_t>                  m_SleepCounter;
+		std::vector<BodyHandle>                   m_IslandParent;		// Union-find of awake bodies
+		std::vector<BodyHandle>                   m_IslandNext;			// Ring of bodies of sleeping island
+		std::vector<std::uint8_t>                 m_isIslandBlocked;	// Island touches body that can't sleep
+		std::vector<BodyHandle>                   m_TouchedBodies;		// Sleeping bodies returned by non-const GetBody()
+		std::vector<std::uint8_t>                 m_isTouched;
+
+		inline FF::AABB<T> BodyAABB(const BodyHandle __FF_IN body) const;
+		inline void        MarkMoved(const BodyHandle __FF_IN body);
+		inline void        AddPair(const BodyHandle __FF_IN first, const BodyHandle __FF_IN second);
+		inline void        RemovePair(const std::size_t __FF_IN pair);
+		inline void        UpdatePairs(void);
+
+		inline BodyHandle  FindIsland(BodyHandle body);
+		inline void        WakeIsland(const BodyHandle __FF_IN body);
+		inline void        WakeNeighbours(const BodyHandle __FF_IN body);
+		inline void        UpdateIslands(void);
+	public:
+		/**
+		 * @brief [Constructor with parameters]
+		 *
+		 * @param margin [Distance that fat boxes are enlarged by]
+		 * @param predictionMultiplier [Fat boxes are extended by velocity * step * predictionMultiplier]
+		 */
+		explicit PhysicsWorld( const T __FF_IN margin               = static_cast<T>(0.1f),
+							   const T __FF_IN predictionMultiplier = static_cast<T>(2.0f) );
+
+		inline BodyHandle CreateBody( const T               __FF_IN mass,
+									  const FF::Vector3<T>& __FF_IN location,
+									  const T               __FF_IN radius,
+									  const bool            __FF_IN staticFlag = false );
+		inline void       DestroyBody(const BodyHandle __FF_IN body);
+		inline const bool isBodyValid(const BodyHandle __FF_IN body) const;
+
+		inline FF::RigidBody<T, Integrator>&       GetBody(const BodyHandle __FF_IN body);
+		inline const FF::RigidBody<T, Integrator>& GetBody(const BodyHandle __FF_IN body) const;
+		inline const T                             GetBodyRadius(const BodyHandle __FF_IN body) const;
+		inline void                                SetBodyLocation(const BodyHandle __FF_IN body, const FF::Vector3<T>& __FF_IN location);
+
+		inline void       WakeBody(const BodyHandle __FF_IN body);
+		inline const bool isBodyAwake(const BodyHandle __FF_IN body) const;
+
+		inline const T           GetSleepVelocity(void) const;
+		inline void              SetSleepVelocity(const T __FF_IN sleepVelocity);
+		inline const std::size_t GetSleepStepCount(void) const;
+		inline void              SetSleepStepCount(const std::size_t __FF_IN sleepStepCount);
+
+		inline std::size_t                   GetBodyCount(void) const;
+		inline std::size_t                   GetAwakeBodyCount(void) const;
+		inline const FF::DynamicAABBTree<T>& GetBroadPhase(void) const;
+
+		inline void Step(const T __FF_IN changeInTime);
+
+		inline const std::vector<FF::CollisionPair>& GetContactPairs(void) const;
+
+		template<typename Callback>
+		inline void QueryAABB(const FF::AABB<T>& __FF_IN box, Callback __FF_IN callback) const;
+
+		template<typename Callback>
+		inline void QuerySphere(const FF::BoundedSphere<T>& __FF_IN sphere, Callback __FF_IN callback) const;
+
+		inline const bool RayCast( const FF::Vector3<T>& __FF_IN  origin,
+								   const FF::Vector3<T>& __FF_IN  direction,
+								   const T               __FF_IN  maxDistance,
+								   RayCastHit&           __FF_OUT hit ) const;
+
+		~PhysicsWorld(void) = default;
+	};
+
+	template<typename T, typename Integrator>
+	FF::PhysicsWorld<T, Integrator>::PhysicsWorld( const T __FF_IN margin,
+												   const T __FF_IN predictionMultiplier )
+	: m_Tree(margin),
+	  m_PredictionMultiplier(predictionMultiplier),
+	  m_SleepVelocity(static_cast<T>(0x0)),
+	  m_SleepStepCount(0x3C),
+	  m_SleepingBodyCount(0x0) {}
+
+	template<typename T, typename Integrator>
+	inline FF::AABB<T> FF::PhysicsWorld<T, Integrator>::BodyAABB(const BodyHandle __FF_IN body) const {
+		const FF::Vector3<T> location = this->m_Bodies[body].GetLocation();
+		const FF::Vector3<T> extent(this->m_Radius[body], this->m_Radius[body], this->m_Radius[body]);
+
+		return FF::AABB<T>(location - extent, location + extent);
+	}
+
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::MarkMoved(const BodyHandle __FF_IN body){
+		if (!this->m_isMoved[body]) {
+			this->m_isMoved[body] = 0x1;
+			this->m_MoveBuffer.push_back(body);
+		}
+	}
+
+	/**
+	 * @brief [Method that add body to the world]
+	 * @details [Pairs of body are found by the next Step()]
+	 *
+	 * @param mass [Mass of body, zero means infinite mass]
+	 * @param location [Location of center of mass]
+	 * @param radius [Radius of bounding sphere]
+	 * @param staticFlag [Static bodies are never moved by Step()]
+	 * @tparam T [Generic type]
+	 * @return [Return handle of body]
+	 */
+	template<typename T, typename Integrator>
+	inline typename FF::PhysicsWorld<T, Integrator>::BodyHandle FF::PhysicsWorld<T, Integrator>::CreateBody( const T               __FF_IN mass,
+																												 const FF::Vector3<T>& __FF_IN location,
+																												 const T               __FF_IN radius,
+																												 const bool            __FF_IN staticFlag ){
+		FF_ASSERT_MESSAGE(radius >= static_cast<T>(0x0), "Radius of body can't be negative!");
+
+		const FF::RigidBody<T, Integrator> rigidBody( mass, location, FF::Vector3<T>(0.0f, 0.0f, 0.0f), FF::Vector3<T>(0.0f, 0.0f, 0.0f),
+													  FF::Vector3<T>(0.0f, 0.0f, 0.0f), FF::Vector3<T>(0.0f, 0.0f, 0.0f),
+													  FF::Vector3<T>(0.0f, 0.0f, 0.0f), staticFlag );
+
+		BodyHandle body;
+		if (!this->m_FreeBodies.empty()) {
+			body = this->m_FreeBodies.back();
+			this->m_FreeBodies.pop_back();
+
+			this->m_Bodies[body] = rigidBody;
+			this->m_Radius[body] = radius;
+		} else {
+			body = this->m_Bodies.size();
+
+			this->m_Bodies.push_back(rigidBody);
+			this->m_Radius.push_back(radius);
+			this->m_Proxy.push_back(FF::DynamicAABBTree<T>::NULL_NODE);
+			this->m_isMoved.push_back(0x0);
+			this->m_isListed.push_back(0x0);
+			this->m_isAsleep.push_back(0x0);
+			this->m_SleepCounter.push_back(0x0);
+			this->m_IslandParent.push_back(body);
+			this->m_IslandNext.push_back(body);
+			this->m_isIslandBlocked.push_back(0x0);
+			this->m_BodyPairs.emplace_back();
+			this->m_isTouched.push_back(0x0);
+		}
+
+		this->m_Proxy[body] = this->m_Tree.CreateProxy(this->BodyAABB(body), body);
+		this->MarkMoved(body);
+
+		this->m_SleepCounter[body] = 0x0;
+		this->m_IslandParent[body] = body;
+		this->m_IslandNext[body]   = body;
+
+		if (!staticFlag && !this->m_isListed[body]) {
+			this->m_isListed[body] = 0x1;
+			this->m_AwakeBodies.push_back(body);
+		}
+
+		return body;
+	}
+
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::DestroyBody(const BodyHandle __FF_IN body){
+		FF_ASSERT_MESSAGE(this->isBodyValid(body), "Invalid body handle!");
+
+		// Bodies that lay on destroyed one must fall
+		this->WakeIsland(body);
+		this->WakeNeighbours(body);
+
+		while (!this->m_BodyPairs[body].empty()) {
+			this->RemovePair(this->m_BodyPairs[body].back());
+		}
+
+		this->m_Tree.DestroyProxy(this->m_Proxy[body]);
+		this->m_Proxy[body] = FF::DynamicAABBTree<T>::NULL_NODE;
+
+		this->m_FreeBodies.push_back(body);
+	}
+
+	template<typename T, typename Integrator>
+	inline const bool FF::PhysicsWorld<T, Integrator>::isBodyValid(const BodyHandle __FF_IN body) const {
+		return body < this->m_Proxy.size() && this->m_Proxy[body] != FF::DynamicAABBTree<T>::NULL_NODE;
+	}
+
+	template<typename T, typename Integrator>
+	inline FF::RigidBody<T, Integrator>& FF::PhysicsWorld<T, Integrator>::GetBody(const BodyHandle __FF_IN body){
+		FF_ASSERT_MESSAGE(this->isBodyValid(body), "Invalid body handle!");
+
+		// Sleeping body can be woken by AddForce(), so its island is checked by the next Step()
+		if (!this->m_isListed[body] && !this->m_isTouched[body]) {
+			this->m_isTouched[body] = 0x1;
+			this->m_TouchedBodies.push_back(body);
+		}
+
+		return this->m_Bodies[body];
+	}
+
+	template<typename T, typename Integrator>
+	inline const FF::RigidBody<T, Integrator>& FF::PhysicsWorld<T, Integrator>::GetBody(const BodyHandle __FF_IN body) const {
+		FF_ASSERT_MESSAGE(this->isBodyValid(body), "Invalid body handle!");
+		return this->m_Bodies[body];
+	}
+
+	template<typename T, typename Integrator>
+	inline const T FF::PhysicsWorld<T, Integrator>::GetBodyRadius(const BodyHandle __FF_IN body) const {
+		return this->m_Radius[body];
+	}
+
+	/**
+	 * @brief [Method that move body to LOCATION]
+	 * @details [Proxy of body is updated immediately, pairs are updated by the next Step(). Bodies that
+	 *           touched the body before the move and bodies that it touches after the move are woken]
+	 *
+	 * @param body [Handle of body]
+	 * @param location [New location]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::SetBodyLocation(const BodyHandle __FF_IN body, const FF::Vector3<T>& __FF_IN location){
+		FF_ASSERT_MESSAGE(this->isBodyValid(body), "Invalid body handle!");
+
+		this->WakeIsland(body);
+		this->WakeNeighbours(body);
+
+		this->m_Bodies[body].SetLocation(location);
+
+		if (this->m_Tree.MoveProxy(this->m_Proxy[body], this->BodyAABB(body), FF::Vector3<T>(0.0f, 0.0f, 0.0f))) {
+			this->MarkMoved(body);
+		}
+
+		// New pairs are found by the next Step(), but sleeping bodies don't look for them
+		this->m_Tree.Query(this->BodyAABB(body), [this, body](std::int32_t proxy) {
+			const BodyHandle other = this->m_Tree.GetUserData(proxy);
+			if (other != body) {
+				this->WakeIsland(other);
+			}
+
+			return true;
+		});
+	}
+
+	template<typename T, typename Integrator>
+	inline std::size_t FF::PhysicsWorld<T, Integrator>::GetBodyCount(void) const {
+		return this->m_Bodies.size() - this->m_FreeBodies.size();
+	}
+
+	template<typename T, typename Integrator>
+	inline const FF::DynamicAABBTree<T>& FF::PhysicsWorld<T, Integrator>::GetBroadPhase(void) const {
+		return this->m_Tree;
+	}
+
+	/**
+	 * @brief [Method that get count of bodies updated by Step()]
+	 * @details [Static bodies are not counted]
+	 *
+	 * @tparam T [Generic type]
+	 * @return [Return count of awake bodies]
+	 */
+	template<typename T, typename Integrator>
+	inline std::size_t FF::PhysicsWorld<T, Integrator>::GetAwakeBodyCount(void) const {
+		return this->m_AwakeBodies.size();
+	}
+
+	/**
+	 * @brief [Method that wake island of body]
+	 *
+	 * @param body [Handle of body]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::WakeBody(const BodyHandle __FF_IN body){
+		FF_ASSERT_MESSAGE(this->isBodyValid(body), "Invalid body handle!");
+		this->WakeIsland(body);
+	}
+
+	template<typename T, typename Integrator>
+	inline const bool FF::PhysicsWorld<T, Integrator>::isBodyAwake(const BodyHandle __FF_IN body) const {
+		return this->isBodyValid(body) && this->m_isListed[body];
+	}
+
+	template<typename T, typename Integrator>
+	inline const T FF::PhysicsWorld<T, Integrator>::GetSleepVelocity(void) const {
+		return this->m_SleepVelocity;
+	}
+
+	/**
+	 * @brief [Method that set speed below which islands fall asleep]
+	 * @details [Zero velocity disables sleeping, it is the default]
+	 *
+	 * @param sleepVelocity [Sleep velocity]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::SetSleepVelocity(const T __FF_IN sleepVelocity){
+		FF_ASSERT_MESSAGE(sleepVelocity >= static_cast<T>(0x0), "Sleep velocity can't be negative!");
+		this->m_SleepVelocity = sleepVelocity;
+	}
+
+	template<typename T, typename Integrator>
+	inline const std::size_t FF::PhysicsWorld<T, Integrator>::GetSleepStepCount(void) const {
+		return this->m_SleepStepCount;
+	}
+
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::SetSleepStepCount(const std::size_t __FF_IN sleepStepCount){
+		FF_ASSERT_MESSAGE(sleepStepCount > 0x0, "Island must rest at least one step before sleeping!");
+		this->m_SleepStepCount = sleepStepCount;
+	}
+
+	template<typename T, typename Integrator>
+	inline typename FF::PhysicsWorld<T, Integrator>::BodyHandle FF::PhysicsWorld<T, Integrator>::FindIsland(BodyHandle body){
+		while (this->m_IslandParent[body] != body) {
+			this->m_IslandParent[body] = this->m_IslandParent[this->m_IslandParent[body]];
+			body                       = this->m_IslandParent[body];
+		}
+
+		return body;
+	}
+
+	/**
+	 * @brief [Method that wake all bodies of sleeping island that contains BODY]
+	 * @details [Woken bodies are appended to awake bodies as islands of one body]
+	 *
+	 * @param body [Handle of body]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::WakeIsland(const BodyHandle __FF_IN body){
+		if (this->m_Bodies[body].isStatic()) {
+			return;
+		}
+
+		if (this->m_isListed[body]) {
+			this->m_SleepCounter[body] = 0x0;
+			return;
+		}
+
+		BodyHandle current = body;
+		do {
+			const BodyHandle next = this->m_IslandNext[current];
+
+			this->m_IslandNext[current]   = current;
+			this->m_IslandParent[current] = current;
+			this->m_SleepCounter[current] = 0x0;
+
+			if (this->m_isAsleep[current]) {
+				this->m_isAsleep[current] = 0x0;
+				this->m_SleepingBodyCount--;
+			}
+
+			if (this->isBodyValid(current) && !this->m_isListed[current]) {
+				this->m_Bodies[current].SetAwake(true);
+				this->m_isListed[current] = 0x1;
+				this->m_AwakeBodies.push_back(current);
+			}
+
+			current = next;
+		} while (current != body);
+	}
+
+	/**
+	 * @brief [Method that wake islands of all bodies paired with BODY]
+	 * @details [Static body is never part of island, so bodies that rest on it are reached only by its pairs]
+	 *
+	 * @param body [Handle of body]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::WakeNeighbours(const BodyHandle __FF_IN body){
+		for (const std::size_t pair : this->m_BodyPairs[body]) {
+			const BodyHandle other = (this->m_Pairs[pair].m_First == body) ? this->m_Pairs[pair].m_Second : this->m_Pairs[pair].m_First;
+			this->WakeIsland(other);
+		}
+	}
+
+	/**
+	 * @brief [Method that join touching resting bodies into islands and put them to sleep]
+	 * @details [Only bodies that rested for sleep step count of steps are joined, island that touches other
+	 *           awake body can't sleep. Body that moves faster than sleep velocity wakes sleeping bodies it touches.
+	 *           Sleeping island is linked into a ring, so it is woken without search. Contact pairs must be updated before]
+	 *
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::UpdateIslands(void){
+		FF_PROFILE_SCOPE("PhysicsWorld::UpdateIslands");
+
+		const T sleepVelocity2 = FF::sqr(this->m_SleepVelocity);
+
+		for (const BodyHandle body : this->m_AwakeBodies) {
+			this->m_IslandParent[body]    = body;
+			this->m_IslandNext[body]      = body;
+			this->m_isIslandBlocked[body] = 0x0;
+		}
+
+		auto isTouching = [this](const BodyHandle first, const BodyHandle second) {
+			return FF::SquaredDistance(this->m_Bodies[first].GetLocation(), this->m_Bodies[second].GetLocation()) <
+				   FF::sqr(this->m_Radius[first] + this->m_Radius[second]);
+		};
+
+		// Bodies woken here are appended, they don't move, so they don't wake others
+		for (std::size_t i = 0x0; i < this->m_AwakeBodies.size(); i++) {
+			const BodyHandle body = this->m_AwakeBodies[i];
+			if (!this->isBodyValid(body) || !this->m_isListed[body]) {
+				continue;
+			}
+
+			const FF::Vector3<T> velocity    = this->m_Bodies[body].GetLinearVelocity();
+			const bool           isMoving    = this->m_SleepingBodyCount > 0x0 && FF::DotProduct(velocity, velocity) >= sleepVelocity2;
+			const bool           isCandidate = this->m_SleepCounter[body] >= this->m_SleepStepCount;
+
+			if (!isMoving && !isCandidate) {
+				continue;
+			}
+
+			// Touching bodies are among pairs, because bounding spheres lie inside fat boxes
+			for (const std::size_t pair : this->m_BodyPairs[body]) {
+				const BodyHandle other = (this->m_Pairs[pair].m_First == body) ? this->m_Pairs[pair].m_Second : this->m_Pairs[pair].m_First;
+
+				// Flags are tested before the body is loaded, moving body looks only for sleeping ones
+				const bool isListed = this->m_isListed[other] != 0x0;
+				if ((isListed && !isCandidate) || (!isListed && !isMoving)) {
+					continue;
+				}
+
+				if (this->m_Bodies[other].isStatic() || !isTouching(body, other)) {
+					continue;
+				}
+
+				if (!isListed) {
+					this->WakeIsland(other);
+				} else {
+					if (this->m_SleepCounter[other] < this->m_SleepStepCount) {
+						this->m_isIslandBlocked[body] = 0x1;
+					} else {
+						const BodyHandle first  = this->FindIsland(body);
+						const BodyHandle second = this->FindIsland(other);
+						if (first != second) {
+							this->m_IslandParent[FF::max(first, second)] = FF::min(first, second);
+						}
+					}
+				}
+			}
+		}
+
+		for (const BodyHandle body : this->m_AwakeBodies) {
+			if (this->m_isIslandBlocked[body]) {
+				this->m_isIslandBlocked[this->FindIsland(body)] = 0x1;
+			}
+		}
+
+		for (const BodyHandle body : this->m_AwakeBodies) {
+			if (!this->isBodyValid(body) || !this->m_isListed[body] || this->m_SleepCounter[body] < this->m_SleepStepCount) {
+				continue;
+			}
+
+			const BodyHandle island = this->FindIsland(body);
+			if (this->m_isIslandBlocked[island]) {
+				continue;
+			}
+
+			this->m_Bodies[body].SetAwake(false);
+			this->m_isListed[body] = 0x0;
+			this->m_isAsleep[body] = 0x1;
+			this->m_SleepingBodyCount++;
+
+			if (body != island) {
+				this->m_IslandNext[body]   = this->m_IslandNext[island];
+				this->m_IslandNext[island] = body;
+			}
+		}
+	}
+
+	/**
+	 * @brief [Method that move bodies and update contact pairs]
+	 *
+	 * @param changeInTime [Frame of time]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::Step(const T __FF_IN changeInTime){
+		FF_PROFILE_SCOPE("PhysicsWorld::Step");
+
+		for (const BodyHandle body : this->m_TouchedBodies) {
+			if (this->isBodyValid(body) && this->m_Bodies[body].isAwake()) {
+				this->WakeIsland(body);
+			}
+
+			this->m_isTouched[body] = 0x0;
+		}
+		this->m_TouchedBodies.clear();
+
+		{
+			FF_PROFILE_SCOPE("PhysicsWorld::Integrate");
+
+			const T sleepVelocity2 = FF::sqr(this->m_SleepVelocity);
+
+			for (const BodyHandle body : this->m_AwakeBodies) {
+				if (!this->isBodyValid(body) || !this->m_isListed[body]) {
+					continue;
+				}
+
+				FF::RigidBody<T, Integrator>& rigidBody = this->m_Bodies[body];
+				rigidBody.Update(changeInTime);
+
+				const FF::Vector3<T> displacement = rigidBody.GetLinearVelocity() * (changeInTime * this->m_PredictionMultiplier);
+				if (this->m_Tree.MoveProxy(this->m_Proxy[body], this->BodyAABB(body), displacement)) {
+					this->MarkMoved(body);
+				}
+
+				const bool isResting = FF::DotProduct(rigidBody.GetLinearVelocity(), rigidBody.GetLinearVelocity()) < sleepVelocity2 &&
+									   FF::DotProduct(rigidBody.GetAngularVelocity(), rigidBody.GetAngularVelocity()) < sleepVelocity2;
+
+				this->m_SleepCounter[body] = isResting ? this->m_SleepCounter[body] + 0x1 : 0x0;
+			}
+		}
+
+		this->UpdatePairs();
+		FF_PROFILE_COUNTER("PhysicsWorld::ContactPairs", this->m_Pairs.size());
+
+		if (this->m_SleepVelocity > static_cast<T>(0x0)) {
+			this->UpdateIslands();
+		}
+
+		// Keep only bodies that are still awake
+		this->m_AwakeBodies.erase(std::remove_if(this->m_AwakeBodies.begin(), this->m_AwakeBodies.end(), [this](const BodyHandle body) {
+			if (this->isBodyValid(body) && this->m_isListed[body] && !this->m_Bodies[body].isStatic()) {
+				return false;
+			}
+
+			this->m_isListed[body] = 0x0;
+			return true;
+		}), this->m_AwakeBodies.end());
+		FF_PROFILE_COUNTER("PhysicsWorld::AwakeBodies", this->m_AwakeBodies.size());
+	}
+
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::AddPair(const BodyHandle __FF_IN first, const BodyHandle __FF_IN second){
+		this->m_BodyPairs[first].push_back(this->m_Pairs.size());
+		this->m_BodyPairs[second].push_back(this->m_Pairs.size());
+		this->m_Pairs.push_back(FF::CollisionPair{ first, second });
+	}
+
+	/**
+	 * @brief [Method that remove pair from the list]
+	 * @details [The last pair takes place of removed one, so indices of the last pair are updated in its bodies]
+	 *
+	 * @param pair [Index of pair in M_PAIRS]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::RemovePair(const std::size_t __FF_IN pair){
+		auto replace = [](std::vector<std::size_t>& pairs, const std::size_t oldPair, const std::size_t newPair) {
+			for (std::size_t& current : pairs) {
+				if (current == oldPair) {
+					current = newPair;
+					return;
+				}
+			}
+		};
+
+		auto erase = [](std::vector<std::size_t>& pairs, const std::size_t oldPair) {
+			for (std::size_t& current : pairs) {
+				if (current == oldPair) {
+					current = pairs.back();
+					pairs.pop_back();
+					return;
+				}
+			}
+		};
+
+		erase(this->m_BodyPairs[this->m_Pairs[pair].m_First], pair);
+		erase(this->m_BodyPairs[this->m_Pairs[pair].m_Second], pair);
+
+		const std::size_t last = this->m_Pairs.size() - 0x1;
+		if (pair != last) {
+			this->m_Pairs[pair] = this->m_Pairs[last];
+
+			replace(this->m_BodyPairs[this->m_Pairs[pair].m_First], last, pair);
+			replace(this->m_BodyPairs[this->m_Pairs[pair].m_Second], last, pair);
+		}
+
+		this->m_Pairs.pop_back();
+	}
+
+	/**
+	 * @brief [Method that replace pairs of moved bodies]
+	 * @details [Pairs of moved bodies are removed and found again by querying the tree with their fat boxes,
+	 *           pair of two moved bodies is reported by the body with smaller handle]
+	 *
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	inline void FF::PhysicsWorld<T, Integrator>::UpdatePairs(void){
+		FF_PROFILE_SCOPE("PhysicsWorld::UpdatePairs");
+
+		for (const BodyHandle body : this->m_MoveBuffer) {
+			while (!this->m_BodyPairs[body].empty()) {
+				this->RemovePair(this->m_BodyPairs[body].back());
+			}
+		}
+
+		for (const BodyHandle body : this->m_MoveBuffer) {
+			if (!this->isBodyValid(body)) {
+				continue;
+			}
+
+			const bool isStatic = this->m_Bodies[body].isStatic();
+
+			this->m_Tree.Query(this->m_Tree.GetFatAABB(this->m_Proxy[body]), [this, body, isStatic](std::int32_t proxy) {
+				const BodyHandle other = this->m_Tree.GetUserData(proxy);
+
+				if (other == body || (this->m_isMoved[other] && other < body) || (isStatic && this->m_Bodies[other].isStatic())) {
+					return true;
+				}
+
+				this->AddPair(FF::min(body, other), FF::max(body, other));
+				return true;
+			});
+		}
+
+		for (const BodyHandle body : this->m_MoveBuffer) {
+			this->m_isMoved[body] = 0x0;
+		}
+		this->m_MoveBuffer.clear();
+	}
+
+	/**
+	 * @brief [Method that return pairs of bodies which fat boxes overlap]
+	 * @details [Pairs of two static bodies are not reported, M_FIRST is always less than M_SECOND.
+	 *           Order of pairs changes when pairs are added or removed]
+	 *
+	 * @tparam T [Generic type]
+	 * @return [Return pairs]
+	 */
+	template<typename T, typename Integrator>
+	inline const std::vector<FF::CollisionPair>& FF::PhysicsWorld<T, Integrator>::GetContactPairs(void) const {
+		return this->m_Pairs;
+	}
+
+	/**
+	 * @brief [Method that find all bodies which AABB overlap BOX]
+	 * @details [CALLBACK(body) is called for each found body, query stops when it returns false]
+	 *
+	 * @param box [AABB of query]
+	 * @param callback [Function bool(BodyHandle)]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	template<typename Callback>
+	inline void FF::PhysicsWorld<T, Integrator>::QueryAABB(const FF::AABB<T>& __FF_IN box, Callback __FF_IN callback) const {
+		const FF::Collision<T> collision;
+
+		this->m_Tree.Query(box, [this, &collision, &box, &callback](std::int32_t proxy) {
+			const BodyHandle body = this->m_Tree.GetUserData(proxy);
+
+			if (!collision.AABBIntersectAABB(this->BodyAABB(body), box)) {
+				return true;
+			}
+
+			return static_cast<bool>(callback(body));
+		});
+	}
+
+	/**
+	 * @brief [Method that find all bodies which bounding spheres overlap SPHERE]
+	 * @details [CALLBACK(body) is called for each found body, query stops when it returns false]
+	 *
+	 * @param sphere [Sphere of query]
+	 * @param callback [Function bool(BodyHandle)]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	template<typename Callback>
+	inline void FF::PhysicsWorld<T, Integrator>::QuerySphere(const FF::BoundedSphere<T>& __FF_IN sphere, Callback __FF_IN callback) const {
+		const FF::Collision<T> collision;
+		const FF::Vector3<T>   extent(sphere.GetRadius(), sphere.GetRadius(), sphere.GetRadius());
+		const FF::AABB<T>      box(sphere.GetLocation() - extent, sphere.GetLocation() + extent);
+
+		this->m_Tree.Query(box, [this, &collision, &sphere, &callback](std::int32_t proxy) {
+			const BodyHandle body = this->m_Tree.GetUserData(proxy);
+
+			if (!collision.BSphereIntersectBSphere(FF::BoundedSphere<T>(this->m_Bodies[body].GetLocation(), this->m_Radius[body]), sphere)) {
+				return true;
+			}
+
+			return static_cast<bool>(callback(body));
+		});
+	}
+
+	/**
+	 * @brief [Method that find the closest body hit by ray]
+	 *
+	 * @param origin [Origin of ray]
+	 * @param direction [Normalized direction of ray]
+	 * @param maxDistance [Length of ray]
+	 * @param hit [The closest hit]
+	 * @tparam T [Generic type]
+	 * @return [Return true if any body is hit]
+	 */
+	template<typename T, typename Integrator>
+	inline const bool FF::PhysicsWorld<T, Integrator>::RayCast( const FF::Vector3<T>& __FF_IN  origin,
+																const FF::Vector3<T>& __FF_IN  direction,
+																const T               __FF_IN  maxDistance,
+																RayCastHit&           __FF_OUT hit ) const {
+		const FF::Collision<T> collision;
+		bool                   isHit = false;
+
+		this->m_Tree.RayCast(origin, direction, maxDistance, [this, &collision, &origin, &direction, &hit, &isHit](std::int32_t proxy, T distance) {
+			const BodyHandle body = this->m_Tree.GetUserData(proxy);
+			T                bodyDistance;
+
+			if (!collision.RayIntersectBSphere(origin, direction, FF::BoundedSphere<T>(this->m_Bodies[body].GetLocation(), this->m_Radius[body]), bodyDistance) ||
+					bodyDistance > distance) {
+				return distance;
+			}
+
+			hit.m_Body     = body;
+			hit.m_Distance = bodyDistance;
+			isHit          = true;
+
+			// Clip the ray, zero distance stops the search
+			return bodyDistance;
+		});
+
+		return isHit;
+	}
+};
+
+#endif // FF_PHYSICSWORLD_HXX_
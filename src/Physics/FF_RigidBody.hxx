@@ -1,19 +1,29 @@
-#include "..\Core\FF_Macros.hxx"
-#include "..\Core\FF_Vector3.hxx"
-#include "..\Core\FF_Quaternion.hxx"
+#include "../Core/FF_Macros.hxx"
+#include "../Core/FF_Vector3.hxx"
+#include "../Core/FF_Quaternion.hxx"
 
 #include "FF_Force.hxx"
+#include "FF_Integrators.hxx"
 
 #ifndef FF_RIGIDBODY_HXX_
 #define FF_RIGIDBODY_HXX_
 
 namespace FF {
-	template<typename T>
+	/**
+	 * @brief [Rigid body]
+	 * @details [Linear motion is integrated by INTEGRATOR, zero invert mass means infinite mass.
+	 *           Linear dampening is a force against velocity, integrator evaluates it at velocity of each stage]
+	 *
+	 * @tparam T [Generic type]
+	 * @tparam Integrator [Point integrator from FF_Integrators.hxx]
+	 */
+	template<typename T, typename Integrator = FF::SymplecticEuler<T>>
 	class RigidBody {
 	private:
 		T m_InvertMass;
 		T m_Restitution;
 		T m_Friction;
+		T m_LinearDampening;
 
 		FF::Vector3<T>    m_Location;
 		FF::Quaternion<T> m_Orientation;
@@ -24,13 +34,14 @@ namespace FF {
 		FF::Vector3<T> 	  m_AngularVelocity;
 		FF::Vector3<T> 	  m_AngularAcceleration;
 
-		FF::Force<T>	  m_SumForces;
+		FF::Vector3<T>	  m_SumForces;
 
 		bool 			  m_isStatic;
+		bool 			  m_isAwake;
 	public:
-		explicit MaterialPoint(void) = delete;
+		explicit RigidBody(void) = delete;
 
-		explicit MaterialPoint( T 			   __FF_IN mass 	  	 = static_cast<T>(0.0f),
+		explicit RigidBody( T 			   __FF_IN mass 	  	 = static_cast<T>(0.0f),
 								FF::Vector3<T> __FF_IN massCenter 	 = FF::Vector3<T>(0.0f, 0.0f, 0.0f),
 								FF::Vector3<T> __FF_IN lVelocity 	 = FF::Vector3<T>(0.0f, 0.0f, 0.0f),
 								FF::Vector3<T> __FF_IN lAcceleration = FF::Vector3<T>(0.0f, 0.0f, 0.0f),
@@ -38,14 +49,19 @@ namespace FF {
 								FF::Vector3<T> __FF_IN aAcceleration = FF::Vector3<T>(0.0f, 0.0f, 0.0f),
 								FF::Vector3<T> __FF_IN sumForce      = FF::Vector3<T>(0.0f, 0.0f, 0.0f),
 								bool 		   __FF_IN staticFlag	 = false )
-		: m_InverseMass(0x1 / mass),
+		: m_InvertMass(FF::CloseToZero(mass) ? static_cast<T>(0x0) : static_cast<T>(0x1) / mass),
+		  m_Restitution(static_cast<T>(0x0)),
+		  m_Friction(static_cast<T>(0x0)),
+		  m_LinearDampening(static_cast<T>(0x0)),
 		  m_Location(massCenter),
+		  m_Orientation(static_cast<T>(0x0), static_cast<T>(0x0), static_cast<T>(0x0), static_cast<T>(0x1)),
 		  m_LinearVelocity(lVelocity),
 		  m_LinearAcceleration(lAcceleration),
 		  m_AngularVelocity(aVelocity),
 		  m_AngularAcceleration(aAcceleration),
 		  m_SumForces(sumForce),
-		  m_isStatic(staticFlag) {};
+		  m_isStatic(staticFlag),
+		  m_isAwake(true) {};
 
 		inline const T GetMass(void) const;
 		inline const T GetInvertMass(void) const;
@@ -55,6 +71,9 @@ namespace FF {
 		inline const FF::Vector3<T> GetLocation(void) const;
 		inline void    				SetLocation(const FF::Vector3<T>& __FF_IN location);	
 
+		inline const FF::Quaternion<T> GetOrientation(void) const;
+		inline void    				   SetOrientation(const FF::Quaternion<T>& __FF_IN orientation);
+
 		inline const FF::Vector3<T> GetLinearVelocity(void) const;
 		inline void 		   		SetLinearVelocity(const FF::Vector3<T>& __FF_IN velocity);
 
@@ -69,104 +88,191 @@ namespace FF {
 
 		inline const FF::Vector3<T> GetForce(void) const;
 		inline void 		   		SetForce(const FF::Vector3<T>& __FF_IN force);
-		inline void 				AddForce(const FF::Vector3<T>& __FF_IN force)		
+		inline void 				AddForce(const FF::Vector3<T>& __FF_IN force);
+
+		inline const T GetLinearDampening(void) const;
+		inline void    SetLinearDampening(const T __FF_IN dampening);
+
+		inline const bool isStatic(void) const;
+		inline void       SetStaticFlag(const bool __FF_IN staticFlag);
+
+		inline const bool isAwake(void) const;
+		inline void       SetAwake(const bool __FF_IN awakeFlag);
 
 		inline const bool Update(const T __FF_IN changeInTime);
 
-		~MaterialPoint(void) = default;	
+		~RigidBody(void) = default;	
 	};
 
-	template<typename T>
-	inline const T GetMass(void) const {
+	template<typename T, typename Integrator>
+	inline const T FF::RigidBody<T, Integrator>::GetMass(void) const {
 		return (0x1 / this->m_InvertMass);
 	}
 
-	template<typename T>
-	inline const T GetInvertMass(void) const {
+	template<typename T, typename Integrator>
+	inline const T FF::RigidBody<T, Integrator>::GetInvertMass(void) const {
 		return this->m_InvertMass;
 	}
 
-	template<typename T>
-	void SetMass(T __FF_IN mass){
-		this->m_InvertMass = 0x1 / mass;
+	template<typename T, typename Integrator>
+	inline void FF::RigidBody<T, Integrator>::SetMass(const T __FF_IN mass){
+		this->m_InvertMass = FF::CloseToZero(mass) ? static_cast<T>(0x0) : static_cast<T>(0x1) / mass;
 	}
 
-	template<typename T>
-	void SetInvertMass(T __FF_IN mass){
+	template<typename T, typename Integrator>
+	inline void FF::RigidBody<T, Integrator>::SetInvertMass(const T __FF_IN mass){
 		this->m_InvertMass = mass;
 	}
 
-	template<typename T>
-	inline const FF::Vector3<T> GetLocation(void) const {
+	template<typename T, typename Integrator>
+	inline const FF::Vector3<T> FF::RigidBody<T, Integrator>::GetLocation(void) const {
 		return this->m_Location;
 	}
 
-	template<typename T>
-	inline void    				SetLocation(const FF::Vector3<T>& __FF_IN location){
+	template<typename T, typename Integrator>
+	inline void    				FF::RigidBody<T, Integrator>::SetLocation(const FF::Vector3<T>& __FF_IN location){
 		this->m_Location = location;
+	}
+
+	template<typename T, typename Integrator>
+	inline const FF::Quaternion<T> FF::RigidBody<T, Integrator>::GetOrientation(void) const {
+		return this->m_Orientation;
+	}
+
+	template<typename T, typename Integrator>
+	inline void    				   FF::RigidBody<T, Integrator>::SetOrientation(const FF::Quaternion<T>& __FF_IN orientation){
+		this->m_Orientation = orientation;
 	}	
 
-	template<typename T>
-	inline const FF::Vector3<T> GetLinearVelocity(void) const {
+	template<typename T, typename Integrator>
+	inline const FF::Vector3<T> FF::RigidBody<T, Integrator>::GetLinearVelocity(void) const {
 		return this->m_LinearVelocity;
 	}
 
-	template<typename T>
-	inline void 		   		SetLinearVelocity(const FF::Vector3<T>& __FF_IN velocity){
+	template<typename T, typename Integrator>
+	inline void 		   		FF::RigidBody<T, Integrator>::SetLinearVelocity(const FF::Vector3<T>& __FF_IN velocity){
 		this->m_LinearVelocity = velocity;
+
+		if (!FF::CloseToZero(FF::DotProduct(velocity, velocity))) {
+			this->m_isAwake = true;
+		}
 	}
 
-	template<typename T>
-	inline const FF::Vector3<T> GetLinearAcceleration(void) const {
+	template<typename T, typename Integrator>
+	inline const FF::Vector3<T> FF::RigidBody<T, Integrator>::GetLinearAcceleration(void) const {
 		return this->m_LinearAcceleration;
 	}
 
-	template<typename T>
-	inline void 		   		SetLinearAcceleration(const FF::Vector3<T>& __FF_IN acceleration){
+	template<typename T, typename Integrator>
+	inline void 		   		FF::RigidBody<T, Integrator>::SetLinearAcceleration(const FF::Vector3<T>& __FF_IN acceleration){
 		this->m_LinearAcceleration = acceleration;
 	}
 
-	template<typename T>
-	inline const FF::Vector3<T> GetAngularVelocity(void) const {
+	template<typename T, typename Integrator>
+	inline const FF::Vector3<T> FF::RigidBody<T, Integrator>::GetAngularVelocity(void) const {
 		return this->m_AngularVelocity;
 	}
 
-	template<typename T>
-	inline void 		   		SetAngularVelocity(const FF::Vector3<T>& __FF_IN velocity){
+	template<typename T, typename Integrator>
+	inline void 		   		FF::RigidBody<T, Integrator>::SetAngularVelocity(const FF::Vector3<T>& __FF_IN velocity){
 		this->m_AngularVelocity = velocity;
 	}
 
-	template<typename T>
-	inline const FF::Vector3<T> GetAngularAcceleration(void) const {
+	template<typename T, typename Integrator>
+	inline const FF::Vector3<T> FF::RigidBody<T, Integrator>::GetAngularAcceleration(void) const {
 		return this->m_AngularAcceleration;
 	}
 
-	template<typename T>
-	inline void 		   		SetAngularAcceleration(const FF::Vector3<T>& __FF_IN acceleration){
+	template<typename T, typename Integrator>
+	inline void 		   		FF::RigidBody<T, Integrator>::SetAngularAcceleration(const FF::Vector3<T>& __FF_IN acceleration){
 		this->m_AngularAcceleration = acceleration;
 	}
 
-	template<typename T>
-	inline const FF::Force<T> GetForce(void) const {
+	template<typename T, typename Integrator>
+	inline const FF::Vector3<T> FF::RigidBody<T, Integrator>::GetForce(void) const {
 		return this->m_SumForces;
 	}
 
-	template<typename T>
-	inline void 		   		SetForce(const FF::Force<T>& __FF_IN force){
+	template<typename T, typename Integrator>
+	inline void 		   		FF::RigidBody<T, Integrator>::SetForce(const FF::Vector3<T>& __FF_IN force){
 		this->m_SumForces = force;
 	}
 
-	template<typename T>
-	inline void 				AddForce(const FF::Force<T>& __FF_IN force){
+	template<typename T, typename Integrator>
+	inline void 				FF::RigidBody<T, Integrator>::AddForce(const FF::Vector3<T>& __FF_IN force){
 		this->m_SumForces += force;
+		this->m_isAwake    = true;
+	}
+
+	template<typename T, typename Integrator>
+	inline const T FF::RigidBody<T, Integrator>::GetLinearDampening(void) const {
+		return this->m_LinearDampening;
+	}
+
+	/**
+	 * @brief [Method that set coefficient of force against linear velocity]
+	 * @details [Force is -DAMPENING * velocity, zero disables dampening]
+	 *
+	 * @param dampening [Dampening coefficient]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	inline void FF::RigidBody<T, Integrator>::SetLinearDampening(const T __FF_IN dampening){
+		FF_ASSERT_MESSAGE(dampening >= static_cast<T>(0x0), "Dampening can't be negative!");
+		this->m_LinearDampening = dampening;
+	}
+
+	template<typename T, typename Integrator>
+	inline const bool FF::RigidBody<T, Integrator>::isStatic(void) const {
+		return this->m_isStatic;
+	}
+
+	template<typename T, typename Integrator>
+	inline void FF::RigidBody<T, Integrator>::SetStaticFlag(const bool __FF_IN staticFlag){
+		this->m_isStatic = staticFlag;
+	}
+
+	template<typename T, typename Integrator>
+	inline const bool FF::RigidBody<T, Integrator>::isAwake(void) const {
+		return this->m_isAwake;
+	}
+
+	/**
+	 * @brief [Method that wake body or put it to sleep]
+	 * @details [Sleeping body isn't moved by Update(), velocities and forces of it are zeroed.
+	 *           AddForce() and nonzero SetLinearVelocity() wake body]
+	 *
+	 * @param awakeFlag [False puts body to sleep]
+	 * @tparam T [Generic type]
+	 */
+	template<typename T, typename Integrator>
+	inline void FF::RigidBody<T, Integrator>::SetAwake(const bool __FF_IN awakeFlag){
+		this->m_isAwake = awakeFlag;
+
+		if (!awakeFlag) {
+			this->m_LinearVelocity  = FF::Vector3<T>(0.0f, 0.0f, 0.0f);
+			this->m_AngularVelocity = FF::Vector3<T>(0.0f, 0.0f, 0.0f);
+			this->m_SumForces       = FF::Vector3<T>(0.0f, 0.0f, 0.0f);
+		}
 	}
 
-	template<typename T>
-	inline const bool Update(const T __FF_IN changeInTime){
-		m_LinearAcceleration = m_SumForces / m_InvertMass;
+	template<typename T, typename Integrator>
+	inline const bool FF::RigidBody<T, Integrator>::Update(const T __FF_IN changeInTime){
+		if (this->m_isStatic || !this->m_isAwake) {
+			return true;
+		}
+
+		// Forces are accumulated by AddForce() during one step, only dampening depends on state of the stage
+		auto acceleration = [this](const FF::Vector3<T>&, const FF::Vector3<T>& velocity) {
+			return (this->m_SumForces - velocity * this->m_LinearDampening) * this->m_InvertMass;
+		};
+
+		this->m_LinearAcceleration = acceleration(this->m_Location, this->m_LinearVelocity);
+		Integrator::Integrate(this->m_Location, this->m_LinearVelocity, acceleration, changeInTime);
+
+		this->m_SumForces = FF::Vector3<T>(0.0f, 0.0f, 0.0f);
 
-		m_LinearVelocity += m_LinearAcceleration   * changeInTime;
-		m_Location += m_LinearVelocity * changeInTime;
+		return true;
 	}
 };
 
@@ -1,6 +1,8 @@
-#include "..\Core\FF_Macros.hxx"
-#include "..\Core\FF_CommonMath.hxx"
+#include "../Core/FF_Macros.hxx"
+#include "../Core/FF_CommonMath.hxx"
+#include "../Core/FF_Vector3.hxx"
 
+#include "FF_Force.hxx"
 #include "FF_MaterialPointBase.hxx"
 
 #ifndef FF_SPRING_HXX_
@@ -19,6 +21,12 @@ namespace FF {
     public:
         explicit Spring(void) = default;
 
+        explicit Spring( const T                   __FF_IN restLength,
+                         const T                   __FF_IN forceConstant,
+                         const T                   __FF_IN dampeningFactor,
+                         FF::MaterialPointBase<T>& __FF_IN pm1,
+                         FF::MaterialPointBase<T>& __FF_IN pm2 );
+
         inline T    GetLength(void) const;
         inline void SetLength(const T __FF_IN length);
 
@@ -29,18 +37,30 @@ namespace FF {
         inline void SetDampening(const T __FF_IN dampening);
 
         inline FF::MaterialPointBase<T>& GetEndpointMassFirst(void) const;
-        inline void                      SetEndpointMassFirst(const FF::MaterialPointBase<T>& __FF_IN pm);
+        inline void                      SetEndpointMassFirst(FF::MaterialPointBase<T>& __FF_IN pm);
 
         inline FF::MaterialPointBase<T>& GetEndpointMassSecond(void) const;
-        inline void                      SetEndpointMassSecond(const FF::MaterialPointBase<T>& __FF_IN pm);
+        inline void                      SetEndpointMassSecond(FF::MaterialPointBase<T>& __FF_IN pm);
 
         inline bool isDisplaced(void);
 
         void CalculateReactions(const T __FF_IN changeInTime);
 
-        ~Spring(void);
+        ~Spring(void) = default;
     };
 
+    template<typename T>
+    FF::Spring<T>::Spring( const T                   __FF_IN restLength,
+                           const T                   __FF_IN forceConstant,
+                           const T                   __FF_IN dampeningFactor,
+                           FF::MaterialPointBase<T>& __FF_IN pm1,
+                           FF::MaterialPointBase<T>& __FF_IN pm2 )
+    : m_RestLength(restLength),
+      m_ForceConstant(forceConstant),
+      m_DampeningFactor(dampeningFactor),
+      m_pm_1(&pm1),
+      m_pm_2(&pm2) {}
+
     template<typename T>
     inline T    FF::Spring<T>::GetLength(void) const {
         return this->m_RestLength;
@@ -73,21 +93,21 @@ namespace FF {
 
     template<typename T>
     inline FF::MaterialPointBase<T>& FF::Spring<T>::GetEndpointMassFirst(void) const {
-        return this->m_pm_1;;
+        return *this->m_pm_1;
     }
 
     template<typename T>
-    inline void                      FF::Spring<T>::SetEndpointMassFirst(const FF::MaterialPointBase<T>& __FF_IN pm){
+    inline void                      FF::Spring<T>::SetEndpointMassFirst(FF::MaterialPointBase<T>& __FF_IN pm){
         this->m_pm_1 = &pm;
     }
 
     template<typename T>
     inline FF::MaterialPointBase<T>& FF::Spring<T>::GetEndpointMassSecond(void) const {
-        return this->m_pm_2;
+        return *this->m_pm_2;
     }
 
     template<typename T>
-    inline void                      FF::Spring<T>::SetEndpointMassSecond(const FF::MaterialPointBase<T>& __FF_IN pm){
+    inline void                      FF::Spring<T>::SetEndpointMassSecond(FF::MaterialPointBase<T>& __FF_IN pm){
         this->m_pm_2 = &pm;
     }
 
@@ -97,12 +117,12 @@ namespace FF {
         FF_ASSERT(m_pm_2 != nullptr);
 
         // Find the distance above points which attached spring
-        FF::Vector3<T> CurrentLength = m_pm_1->Location() - m_pm_2->Location();
+        FF::Vector3<T> CurrentLength = m_pm_1->GetLocation() - m_pm_2->GetLocation();
 
         // Find the subdiv above current length and rest length
-        T DistanceDifference = CurrentLength.SquaredDistance() - FF::sqr(this->GetLength());
+        T DistanceDifference = CurrentLength.SquaredMagnitude() - FF::sqr(this->GetLength());
 
-        return (!CloseToZero(DistanceDifference)) ? true : false ;
+        return (!FF::CloseToZero(DistanceDifference)) ? true : false ;
     }
 
     template<typename T>
@@ -111,13 +131,13 @@ namespace FF {
         FF_ASSERT(m_pm_2 != nullptr);
 
         // Find the distance above points which attached spring
-        FF::Vector3<T> CurrentLength = m_pm_1->Location() - m_pm_2->Location();
+        FF::Vector3<T> CurrentLength = m_pm_1->GetLocation() - m_pm_2->GetLocation();
 
         // Find the subdiv above current length and rest length
-        T DistanceDifference = CurrentLength.SquaredDistance() - FF::sqr(this->GetLength());
+        T DistanceDifference = CurrentLength.SquaredMagnitude() - FF::sqr(this->GetLength());
 
-        if (!CloseToZero(DistanceDifference)) {
-            DistanceDifference = static_cast<T>(0.0);
+        if (FF::CloseToZero(DistanceDifference)) {
+            return;
         }
 
         // Find magnitude of force that hav a spring
@@ -134,11 +154,16 @@ namespace FF {
         T ResponseForceMagnitude = SpringForceMagnitude - DampeningForceMagnitude;
 
         // Change the response force to a vector
-        FF::Vector3<T> ResponseForce = ResponseForceMagnitude * FF::Normalize(CurrentLength);
+        FF::Vector3<T> ResponseForce = FF::Normalize(CurrentLength) * ResponseForceMagnitude;
 
         // Apply the response force to the particles
-        m_pm_1->SetImpulseForce(m_pm_1->GetImpulseForce() + -0x1 * ResponseForce);
-        m_pm_2->SetImpulseForce(m_pm_2->GetImpulseForce() + ResponseForce);
+        FF::Force<T> FirstImpulse = m_pm_1->GetImpulseForce();
+        FirstImpulse.SetDirection(FirstImpulse.GetDirection() - ResponseForce);
+        m_pm_1->SetImpulseForce(FirstImpulse);
+
+        FF::Force<T> SecondImpulse = m_pm_2->GetImpulseForce();
+        SecondImpulse.SetDirection(SecondImpulse.GetDirection() + ResponseForce);
+        m_pm_2->SetImpulseForce(SecondImpulse);
     }
 };
 
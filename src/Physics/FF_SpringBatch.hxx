@@ -0,0 +1,177 @@
+#include <cmath>
+#include <cstdint>
+
+#include "../Core/FF_Macros.hxx"
+#include "../Core/FF_CommonMath.hxx"
+
+#include "../Core/FF_VectorBatch.hxx"
+
+#ifndef FF_SPRINGBATCH_HXX_
+#define FF_SPRINGBATCH_HXX_
+
+namespace FF {
+    /**
+     * @brief   [Scalar Hooke and dampening force of array of springs]
+     * @details [Spring I connects particles FIRST[I] and SECOND[I]. Force F[I] acts on the second particle,
+     *           the first particle gets -F[I]. Force is (stiffness * (length - restLength) + dampening * relative velocity
+     *           along spring) along the spring, spring which length is close to zero has no force.
+     *           It is the reference implementation of SimdSpringBatch]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    class ScalarSpringBatch {
+    public:
+        explicit ScalarSpringBatch(void) = delete;
+
+        static inline void CalculateForces( const T*             __FF_IN  x,
+                                            const T*             __FF_IN  y,
+                                            const T*             __FF_IN  z,
+                                            const T*             __FF_IN  vx,
+                                            const T*             __FF_IN  vy,
+                                            const T*             __FF_IN  vz,
+                                            const std::uint32_t* __FF_IN  first,
+                                            const std::uint32_t* __FF_IN  second,
+                                            const T*             __FF_IN  restLength,
+                                            const T*             __FF_IN  stiffness,
+                                            const T*             __FF_IN  dampening,
+                                            T*                   __FF_OUT fx,
+                                            T*                   __FF_OUT fy,
+                                            T*                   __FF_OUT fz,
+                                            const std::size_t    __FF_IN  count );
+
+        ~ScalarSpringBatch(void) = delete;
+    };
+
+    template<typename T>
+    inline void FF::ScalarSpringBatch<T>::CalculateForces( const T*             __FF_IN  x,
+                                                           const T*             __FF_IN  y,
+                                                           const T*             __FF_IN  z,
+                                                           const T*             __FF_IN  vx,
+                                                           const T*             __FF_IN  vy,
+                                                           const T*             __FF_IN  vz,
+                                                           const std::uint32_t* __FF_IN  first,
+                                                           const std::uint32_t* __FF_IN  second,
+                                                           const T*             __FF_IN  restLength,
+                                                           const T*             __FF_IN  stiffness,
+                                                           const T*             __FF_IN  dampening,
+                                                           T*                   __FF_OUT fx,
+                                                           T*                   __FF_OUT fy,
+                                                           T*                   __FF_OUT fz,
+                                                           const std::size_t    __FF_IN  count ){
+        for (std::size_t s = 0x0; s < count; s++) {
+            const std::uint32_t a = first[s];
+            const std::uint32_t b = second[s];
+
+            const T dx = x[a] - x[b];
+            const T dy = y[a] - y[b];
+            const T dz = z[a] - z[b];
+
+            const T length       = std::sqrt((dx * dx + dy * dy) + dz * dz);
+            const T invertLength = FF::CloseToZero(length) ? static_cast<T>(0x0) : static_cast<T>(0x1) / length;
+
+            const T nx = dx * invertLength;
+            const T ny = dy * invertLength;
+            const T nz = dz * invertLength;
+
+            const T relativeVelocity = ((vx[a] - vx[b]) * nx + (vy[a] - vy[b]) * ny) + (vz[a] - vz[b]) * nz;
+            const T forceMagnitude   = stiffness[s] * (length - restLength[s]) + dampening[s] * relativeVelocity;
+
+            fx[s] = forceMagnitude * nx;
+            fy[s] = forceMagnitude * ny;
+            fz[s] = forceMagnitude * nz;
+        }
+    }
+
+#if defined(__FF_SIMD_AVX2) || defined(__FF_SIMD_SSE2)
+    /**
+     * @brief   [SIMD Hooke and dampening force of array of springs]
+     * @details [Endpoints are gathered by indices, SimdLane<T>::WIDTH springs are processed per instruction.
+     *           Forces are not scattered to particles here, because two springs of one register can share a particle]
+     *
+     * @tparam T [float or double]
+     */
+    template<typename T>
+    class SimdSpringBatch {
+    private:
+        using Lane     = FF::SimdLane<T>;
+        using Register = typename Lane::Register;
+    public:
+        explicit SimdSpringBatch(void) = delete;
+
+        static inline void CalculateForces( const T*             __FF_IN  x,
+                                            const T*             __FF_IN  y,
+                                            const T*             __FF_IN  z,
+                                            const T*             __FF_IN  vx,
+                                            const T*             __FF_IN  vy,
+                                            const T*             __FF_IN  vz,
+                                            const std::uint32_t* __FF_IN  first,
+                                            const std::uint32_t* __FF_IN  second,
+                                            const T*             __FF_IN  restLength,
+                                            const T*             __FF_IN  stiffness,
+                                            const T*             __FF_IN  dampening,
+                                            T*                   __FF_OUT fx,
+                                            T*                   __FF_OUT fy,
+                                            T*                   __FF_OUT fz,
+                                            const std::size_t    __FF_IN  count ){
+            const Register one     = Lane::Set(static_cast<T>(0x1));
+            const Register epsilon = Lane::Epsilon();
+
+            std::size_t s = 0x0;
+            for (; s + Lane::WIDTH <= count; s += Lane::WIDTH) {
+                const std::uint32_t* a = first  + s;
+                const std::uint32_t* b = second + s;
+
+                Register dx = Lane::Sub(Lane::Gather(x, a), Lane::Gather(x, b));
+                Register dy = Lane::Sub(Lane::Gather(y, a), Lane::Gather(y, b));
+                Register dz = Lane::Sub(Lane::Gather(z, a), Lane::Gather(z, b));
+
+                Register length       = Lane::Sqrt(Lane::Add(Lane::Add(Lane::Mul(dx, dx), Lane::Mul(dy, dy)), Lane::Mul(dz, dz)));
+                Register invertLength = Lane::And(Lane::Greater(length, epsilon), Lane::Div(one, length));
+
+                Register nx = Lane::Mul(dx, invertLength);
+                Register ny = Lane::Mul(dy, invertLength);
+                Register nz = Lane::Mul(dz, invertLength);
+
+                Register relativeVelocity = Lane::Add(Lane::Add(Lane::Mul(Lane::Sub(Lane::Gather(vx, a), Lane::Gather(vx, b)), nx),
+                                                                Lane::Mul(Lane::Sub(Lane::Gather(vy, a), Lane::Gather(vy, b)), ny)),
+                                                      Lane::Mul(Lane::Sub(Lane::Gather(vz, a), Lane::Gather(vz, b)), nz));
+
+                Register forceMagnitude = Lane::Add(Lane::Mul(Lane::Load(stiffness + s), Lane::Sub(length, Lane::Load(restLength + s))),
+                                                    Lane::Mul(Lane::Load(dampening + s), relativeVelocity));
+
+                Lane::Store(fx + s, Lane::Mul(forceMagnitude, nx));
+                Lane::Store(fy + s, Lane::Mul(forceMagnitude, ny));
+                Lane::Store(fz + s, Lane::Mul(forceMagnitude, nz));
+            }
+
+            FF::ScalarSpringBatch<T>::CalculateForces( x, y, z, vx, vy, vz,
+                                                       first + s, second + s,
+                                                       restLength + s, stiffness + s, dampening + s,
+                                                       fx + s, fy + s, fz + s,
+                                                       count - s );
+        }
+
+        ~SimdSpringBatch(void) = delete;
+    };
+#endif
+
+    /**
+     * @brief   [Spring force kernel]
+     * @details [Scalar for generic type, SimdSpringBatch for float and double if SIMD is enabled]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    class SpringBatch : public FF::ScalarSpringBatch<T> {};
+
+#if defined(__FF_SIMD_AVX2) || defined(__FF_SIMD_SSE2)
+    template<>
+    class SpringBatch<float>  : public FF::SimdSpringBatch<float>  {};
+
+    template<>
+    class SpringBatch<double> : public FF::SimdSpringBatch<double> {};
+#endif
+};
+
+#endif // FF_SPRINGBATCH_HXX_
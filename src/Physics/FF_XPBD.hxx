@@ -0,0 +1,196 @@
+#include <cstdint>
+#include <vector>
+#include <cmath>
+
+#include "../Core/FF_Macros.hxx"
+#include "../Core/FF_CommonMath.hxx"
+#include "../Core/FF_Profiler.hxx"
+
+#include "FF_ClothState.hxx"
+
+#ifndef FF_XPBD_HXX_
+#define FF_XPBD_HXX_
+
+namespace FF {
+    /**
+     * @brief   [Extended position based dynamics (XPBD) cloth solver]
+     * @details [Springs of cloth are solved as distance constraints |a - b| = restLength with compliance
+     *           1 / stiffness, see "XPBD: Position-Based Simulation of Compliant Constrained Dynamics"
+     *           (Macklin, Muller, Chentanez). Only impulse and constant forces are integrated explicitly,
+     *           so stiffness doesn't limit the step. Stiffness that is reached depends on count of iterations,
+     *           not on the step. Static particles have zero invert mass and are never moved by constraints.
+     *           Spring dampening is not used, cloth is dampened by linear dampening only.
+     *           It has the cloth interface of integrators from FF_Integrators.hxx, so it is selected per cloth
+     *           as FF::Cloth<T, FF::XPBD<T>>. Constraints of one color are projected in parallel, colors one by one
+     *           (Gauss-Seidel between colors), so result doesn't depend on count of threads]
+     *
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    class XPBD {
+    private:
+        std::size_t    m_IterationCount;
+
+        std::vector<T> m_PreviousLocationX;
+        std::vector<T> m_PreviousLocationY;
+        std::vector<T> m_PreviousLocationZ;
+
+        std::vector<T> m_InvertMass;                        // Invert mass, zero for static particles
+
+        std::vector<T> m_Lambda;                            // Accumulated Lagrange multiplier of each constraint
+    public:
+        /**
+         * @brief [Constructor with parameters]
+         *
+         * @param iterationCount [Count of passes over all constraints per step]
+         */
+        explicit XPBD(const std::size_t __FF_IN iterationCount = 0x8);
+
+        inline std::size_t GetIterationCount(void) const;
+        inline void        SetIterationCount(const std::size_t __FF_IN iterationCount);
+
+        template<typename ForceFunction, typename ParallelFunction>
+        inline void Integrate( FF::ClothState<T>&         __FF_OUT state,
+                               const FF::ClothSprings<T>& __FF_IN  springs,
+                               ForceFunction              __FF_IN  accumulateForces,
+                               ParallelFunction           __FF_IN  parallelFor,
+                               const T                    __FF_IN  changeInTime );
+
+        ~XPBD(void) = default;
+    };
+
+    template<typename T>
+    FF::XPBD<T>::XPBD(const std::size_t __FF_IN iterationCount)
+    : m_IterationCount(iterationCount) {
+        FF_ASSERT_MESSAGE(iterationCount > 0x0, "XPBD must do at least one iteration!");
+    }
+
+    template<typename T>
+    inline std::size_t FF::XPBD<T>::GetIterationCount(void) const {
+        return this->m_IterationCount;
+    }
+
+    template<typename T>
+    inline void FF::XPBD<T>::SetIterationCount(const std::size_t __FF_IN iterationCount){
+        FF_ASSERT_MESSAGE(iterationCount > 0x0, "XPBD must do at least one iteration!");
+        this->m_IterationCount = iterationCount;
+    }
+
+    /**
+     * @brief [Method that move particles and project them on spring constraints]
+     * @details [ACCUMULATEFORCES isn't called, because springs are constraints here.
+     *           Velocity is taken from the change of location after projection]
+     *
+     * @param state [State of particles]
+     * @param springs [Springs of cloth, sorted by color]
+     * @param accumulateForces [Not used]
+     * @param parallelFor [Parallel loop]
+     * @param changeInTime [Frame of time]
+     * @tparam T [Generic type]
+     */
+    template<typename T>
+    template<typename ForceFunction, typename ParallelFunction>
+    inline void FF::XPBD<T>::Integrate( FF::ClothState<T>&         __FF_OUT state,
+                                        const FF::ClothSprings<T>& __FF_IN  springs,
+                                        ForceFunction              __FF_IN  /*accumulateForces*/,
+                                        ParallelFunction           __FF_IN  parallelFor,
+                                        const T                    __FF_IN  changeInTime ){
+        const std::size_t count = state.GetParticleCount();
+
+        this->m_PreviousLocationX.resize(count);
+        this->m_PreviousLocationY.resize(count);
+        this->m_PreviousLocationZ.resize(count);
+        this->m_InvertMass.resize(count);
+
+        this->m_Lambda.assign(springs.GetSpringCount(), static_cast<T>(0x0));
+
+        // Predict locations by external forces
+        parallelFor(0x0, count, [this, &state, changeInTime](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                this->m_PreviousLocationX[i] = state.m_LocationX[i];
+                this->m_PreviousLocationY[i] = state.m_LocationY[i];
+                this->m_PreviousLocationZ[i] = state.m_LocationZ[i];
+
+                this->m_InvertMass[i] = state.m_StaticMask[i] ? static_cast<T>(0x0) : state.m_InvertMass[i];
+
+                if (!state.m_StaticMask[i]) {
+                    state.m_VelocityX[i] += (state.m_ForceX[i] + state.m_ConstantForceX[i]) * state.m_InvertMass[i] * changeInTime;
+                    state.m_VelocityY[i] += (state.m_ForceY[i] + state.m_ConstantForceY[i]) * state.m_InvertMass[i] * changeInTime;
+                    state.m_VelocityZ[i] += (state.m_ForceZ[i] + state.m_ConstantForceZ[i]) * state.m_InvertMass[i] * changeInTime;
+
+                    state.m_LocationX[i] += state.m_VelocityX[i] * changeInTime;
+                    state.m_LocationY[i] += state.m_VelocityY[i] * changeInTime;
+                    state.m_LocationZ[i] += state.m_VelocityZ[i] * changeInTime;
+                }
+
+                state.m_ForceX[i] = static_cast<T>(0x0);
+                state.m_ForceY[i] = static_cast<T>(0x0);
+                state.m_ForceZ[i] = static_cast<T>(0x0);
+            }
+        });
+
+        // Compliance is scaled by the step, so the constraint behaves as spring of the same stiffness
+        const T invertTime2 = static_cast<T>(0x1) / (changeInTime * changeInTime);
+
+        {
+            FF_PROFILE_SCOPE("XPBD::Project");
+
+            for (std::size_t iteration = 0x0; iteration < this->m_IterationCount; iteration++) {
+                for (std::size_t c = 0x0; c < springs.GetColorCount(); c++) {
+                    parallelFor(springs.m_ColorOffsets[c], springs.m_ColorOffsets[c + 0x1], [this, &state, &springs, invertTime2](std::size_t begin, std::size_t end) {
+                        for (std::size_t s = begin; s < end; s++) {
+                            const std::uint32_t a = springs.m_First[s];
+                            const std::uint32_t b = springs.m_Second[s];
+
+                            const T sumInvertMass = this->m_InvertMass[a] + this->m_InvertMass[b];
+                            if (FF::CloseToZero(sumInvertMass) || FF::CloseToZero(springs.m_Stiffness[s])) {
+                                continue;
+                            }
+
+                            const T dx = state.m_LocationX[a] - state.m_LocationX[b];
+                            const T dy = state.m_LocationY[a] - state.m_LocationY[b];
+                            const T dz = state.m_LocationZ[a] - state.m_LocationZ[b];
+
+                            const T length = std::sqrt((dx * dx + dy * dy) + dz * dz);
+                            if (FF::CloseToZero(length)) {
+                                continue;
+                            }
+
+                            const T compliance  = invertTime2 / springs.m_Stiffness[s];
+                            const T constraint  = length - springs.m_RestLength[s];
+                            const T deltaLambda = -(constraint + compliance * this->m_Lambda[s]) / (sumInvertMass + compliance);
+
+                            this->m_Lambda[s] += deltaLambda;
+
+                            const T impulse = deltaLambda / length;
+
+                            state.m_LocationX[a] += this->m_InvertMass[a] * impulse * dx;
+                            state.m_LocationY[a] += this->m_InvertMass[a] * impulse * dy;
+                            state.m_LocationZ[a] += this->m_InvertMass[a] * impulse * dz;
+
+                            state.m_LocationX[b] -= this->m_InvertMass[b] * impulse * dx;
+                            state.m_LocationY[b] -= this->m_InvertMass[b] * impulse * dy;
+                            state.m_LocationZ[b] -= this->m_InvertMass[b] * impulse * dz;
+                        }
+                    });
+                }
+            }
+            FF_PROFILE_COUNTER("Cloth::SpringsEvaluated", this->m_IterationCount * springs.GetSpringCount());
+        }
+
+        // Velocity is the change of location
+        const T invertTime = static_cast<T>(0x1) / changeInTime;
+
+        parallelFor(0x0, count, [this, &state, invertTime](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                if (!state.m_StaticMask[i]) {
+                    state.m_VelocityX[i] = (state.m_LocationX[i] - this->m_PreviousLocationX[i]) * invertTime;
+                    state.m_VelocityY[i] = (state.m_LocationY[i] - this->m_PreviousLocationY[i]) * invertTime;
+                    state.m_VelocityZ[i] = (state.m_LocationZ[i] - this->m_PreviousLocationZ[i]) * invertTime;
+                }
+            }
+        });
+    }
+};
+
+#endif // FF_XPBD_HXX_
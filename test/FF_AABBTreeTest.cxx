@@ -0,0 +1,350 @@
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Physics/Collision/FF_Collision.hxx"
+#include "../src/Physics/Collision/FF_DynamicAABBTree.hxx"
+#include "../src/Physics/FF_PhysicsWorld.hxx"
+
+/**
+ * @brief [Test of dynamic AABB tree and rigid body world]
+ * @details [Random sequences of insertions, moves and removals are applied to FF::DynamicAABBTree, after each
+ *           of them the structure, balance and containment of the tree are checked, queries and ray casts are
+ *           compared with brute force over fat boxes. Then FF::PhysicsWorld is stepped with bodies created,
+ *           destroyed and teleported: contact pairs must be exactly the overlapping fat boxes, pairs of bodies
+ *           that kept their fat boxes must survive the step, ray casts and sphere queries must match brute force]
+ */
+namespace {
+    constexpr unsigned     SEED             = 0x1234u;
+    constexpr std::size_t  TREE_STEP_COUNT  = 0xFA0;
+    constexpr std::size_t  WORLD_STEP_COUNT = 0xC8;
+
+    // Single rotation per level of Refit() doesn't restore AVL balance after every removal
+    constexpr std::int32_t MAX_BALANCE      = 0x2;
+
+    using Pair    = std::pair<std::size_t, std::size_t>;
+    using PairSet = std::multiset<Pair>;
+
+    std::size_t g_FailureCount = 0x0;
+
+    void Check(bool condition, const char* scenario, std::size_t step, const char* message){
+        if (!condition) {
+            std::printf("FAIL %s step %zu: %s\n", scenario, step, message);
+            g_FailureCount++;
+        }
+    }
+
+    FF::AABB<float> Box(const FF::Vector3<float>& center, float extent){
+        const FF::Vector3<float> half(extent, extent, extent);
+        return FF::AABB<float>(center - half, center + half);
+    }
+
+    FF::Vector3<float> InvertDirection(const FF::Vector3<float>& direction){
+        return FF::Vector3<float>(1.0f / direction.GetXComponent(), 1.0f / direction.GetYComponent(), 1.0f / direction.GetZComponent());
+    }
+
+    // Height of balanced tree of N leaves is about log2(N), rotations keep it within a small factor
+    bool isShallow(std::int32_t height, std::size_t leafCount){
+        return static_cast<double>(height) <= 2.0 * std::log2(static_cast<double>(leafCount) + 1.0) + 2.0;
+    }
+
+    void TestTree(void){
+        std::mt19937 generator(SEED);
+        std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+        std::uniform_real_distribution<float> extent(0.1f, 2.0f);
+        std::uniform_real_distribution<float> small(-0.15f, 0.15f);
+        std::uniform_real_distribution<float> large(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_int_distribution<int>    operation(0x0, 0x9);
+
+        const FF::Collision<float> collision;
+
+        FF::DynamicAABBTree<float> tree(0.2f);
+
+        // Proxy of each object and its tight box
+        std::map<std::int32_t, FF::AABB<float>> objects;
+        std::map<std::int32_t, std::size_t>     userData;
+        std::size_t                             nextUserData = 0x0;
+
+        for (std::size_t step = 0x0; step < TREE_STEP_COUNT; step++) {
+            const int kind = operation(generator);
+
+            // Mostly insertions at first, later the count of objects changes slowly
+            if (objects.empty() || kind < ((step < TREE_STEP_COUNT / 0x4) ? 0x6 : 0x3)) {
+                const FF::AABB<float> box = Box(FF::Vector3<float>(coordinate(generator), coordinate(generator), coordinate(generator)), extent(generator));
+                const std::int32_t proxy  = tree.CreateProxy(box, nextUserData);
+
+                Check(objects.count(proxy) == 0x0, "Tree", step, "proxy of living object is reused");
+                objects.emplace(proxy, box);
+                userData[proxy]   = nextUserData++;
+            } else if (kind < 0x5) {
+                auto object = objects.begin();
+                std::advance(object, std::uniform_int_distribution<std::size_t>(0x0, objects.size() - 0x1)(generator));
+
+                tree.DestroyProxy(object->first);
+                userData.erase(object->first);
+                objects.erase(object);
+            } else {
+                auto object = objects.begin();
+                std::advance(object, std::uniform_int_distribution<std::size_t>(0x0, objects.size() - 0x1)(generator));
+
+                // Small moves stay inside of fat box, large ones leave it
+                const bool               isLarge = (kind == 0x9);
+                const FF::Vector3<float> displacement = isLarge ? FF::Vector3<float>(large(generator), large(generator), large(generator))
+                                                                : FF::Vector3<float>(small(generator), small(generator), small(generator));
+                const FF::AABB<float>    box(object->second.GetBottomBound() + displacement, object->second.GetTopBound() + displacement);
+
+                const bool isContained  = FF::Contains(tree.GetFatAABB(object->first), box);
+                const bool isReinserted = tree.MoveProxy(object->first, box, displacement);
+
+                Check(isReinserted != isContained, "Tree", step, "proxy is reinserted although box is inside of fat box or isn't");
+                object->second = box;
+            }
+
+            Check(tree.Validate(), "Tree", step, "links, heights or boxes of nodes are broken");
+            Check(tree.GetProxyCount() == objects.size(), "Tree", step, "count of proxies differs");
+            Check(tree.GetMaxBalance() <= MAX_BALANCE, "Tree", step, "tree is not balanced");
+            Check(isShallow(tree.GetHeight(), objects.size()), "Tree", step, "tree is too high");
+
+            for (const auto& object : objects) {
+                if (!FF::Contains(tree.GetFatAABB(object.first), object.second) || tree.GetUserData(object.first) != userData[object.first]) {
+                    Check(false, "Tree", step, "fat box doesn't contain object or user data is lost");
+                    break;
+                }
+            }
+
+            if (step % 0x10 != 0x0) {
+                continue;
+            }
+
+            // Query of random box against brute force
+            const FF::AABB<float> queryBox = Box(FF::Vector3<float>(coordinate(generator), coordinate(generator), coordinate(generator)), 8.0f);
+
+            std::set<std::int32_t> found, expected;
+            tree.Query(queryBox, [&found](std::int32_t proxy) {
+                found.insert(proxy);
+                return true;
+            });
+            for (const auto& object : objects) {
+                if (collision.AABBIntersectAABB(tree.GetFatAABB(object.first), queryBox)) {
+                    expected.insert(object.first);
+                }
+            }
+            Check(found == expected, "TreeQuery", step, "proxies differ from brute force");
+
+            // Ray cast which doesn't clip the segment reports every crossed fat box, ray along axis has infinite inverse
+            FF::Vector3<float> direction(unit(generator), unit(generator), unit(generator));
+            if (step % 0x40 == 0x0) {
+                direction.SetXYZ(1.0f, 0.0f, 0.0f);
+            }
+            direction = direction.Normalize();
+
+            const FF::Vector3<float> origin(coordinate(generator), coordinate(generator), coordinate(generator));
+            const float              maxDistance = 80.0f;
+
+            found.clear();
+            expected.clear();
+            tree.RayCast(origin, direction, maxDistance, [&found](std::int32_t proxy, float distance) {
+                found.insert(proxy);
+                return distance;
+            });
+            for (const auto& object : objects) {
+                if (collision.RayIntersectAABB(origin, InvertDirection(direction), maxDistance, tree.GetFatAABB(object.first))) {
+                    expected.insert(object.first);
+                }
+            }
+            Check(found == expected, "TreeRayCast", step, "proxies differ from brute force");
+        }
+
+        std::printf("Tree     %zu operations, %zu proxies, height %d\n", TREE_STEP_COUNT, objects.size(), tree.GetHeight());
+    }
+
+    using World = FF::PhysicsWorld<float>;
+
+    // Fat box of body is found by querying the tree with its tight box
+    FF::AABB<float> FatAABB(const World& world, World::BodyHandle body){
+        const FF::DynamicAABBTree<float>& tree   = world.GetBroadPhase();
+        const FF::Vector3<float>          center = world.GetBody(body).GetLocation();
+
+        FF::AABB<float> fatBox = Box(center, 0.0f);
+        tree.Query(Box(center, world.GetBodyRadius(body)), [&tree, &fatBox, body](std::int32_t proxy) {
+            if (tree.GetUserData(proxy) != body) {
+                return true;
+            }
+
+            fatBox = tree.GetFatAABB(proxy);
+            return false;
+        });
+
+        return fatBox;
+    }
+
+    void TestWorld(void){
+        constexpr std::size_t MAX_BODY_COUNT = 0x190;
+
+        std::mt19937 generator(SEED);
+        std::uniform_real_distribution<float> coordinate(0.0f, 12.0f);
+        std::uniform_real_distribution<float> velocity(-2.0f, 2.0f);
+        std::uniform_real_distribution<float> radius(0.1f, 0.6f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_int_distribution<int>    operation(0x0, 0x9);
+
+        const FF::Collision<float> collision;
+
+        World                          world(0.1f);
+        const World&                   view = world;
+        std::vector<World::BodyHandle> bodies;
+
+        // Bodies created or teleported before the step, their pairs are found again
+        std::set<World::BodyHandle>    changed;
+
+        auto createBody = [&]() {
+            const bool isStatic = (operation(generator) == 0x0);
+            const World::BodyHandle body = world.CreateBody(1.0f, FF::Vector3<float>(coordinate(generator), coordinate(generator), coordinate(generator)),
+                                                            radius(generator), isStatic);
+
+            // A third of dynamic bodies rest, so their pairs must survive steps
+            if (!isStatic && operation(generator) > 0x2) {
+                world.GetBody(body).SetLinearVelocity(FF::Vector3<float>(velocity(generator), velocity(generator), velocity(generator)));
+            }
+            bodies.push_back(body);
+            changed.insert(body);
+        };
+
+        for (std::size_t i = 0x0; i < MAX_BODY_COUNT / 0x2; i++) {
+            createBody();
+        }
+
+        for (std::size_t step = 0x0; step < WORLD_STEP_COUNT; step++) {
+            for (std::size_t change = 0x0; change < 0x4; change++) {
+                const int kind = operation(generator);
+
+                if (kind < 0x3 && bodies.size() < MAX_BODY_COUNT) {
+                    createBody();
+                } else if (kind < 0x5 && !bodies.empty()) {
+                    const std::size_t index = std::uniform_int_distribution<std::size_t>(0x0, bodies.size() - 0x1)(generator);
+
+                    world.DestroyBody(bodies[index]);
+                    bodies[index] = bodies.back();
+                    bodies.pop_back();
+                } else if (kind < 0x7 && !bodies.empty()) {
+                    const World::BodyHandle body = bodies[std::uniform_int_distribution<std::size_t>(0x0, bodies.size() - 0x1)(generator)];
+                    world.SetBodyLocation(body, FF::Vector3<float>(coordinate(generator), coordinate(generator), coordinate(generator)));
+                    changed.insert(body);
+                }
+            }
+
+            std::map<World::BodyHandle, FF::AABB<float>> fatBoxes;
+            for (const World::BodyHandle body : bodies) {
+                fatBoxes.emplace(body, FatAABB(view, body));
+            }
+            const std::vector<FF::CollisionPair> oldPairs = world.GetContactPairs();
+
+            world.Step(0.01f);
+
+            Check(world.GetBroadPhase().Validate(), "World", step, "tree is broken");
+            Check(world.GetBroadPhase().GetProxyCount() == bodies.size(), "World", step, "count of proxies differs from count of bodies");
+
+            // Bodies which fat box is the same weren't reinserted, their pairs must be kept
+            std::set<World::BodyHandle> moved(changed);
+            changed.clear();
+            for (const World::BodyHandle body : bodies) {
+                const FF::AABB<float>  fatBox = FatAABB(view, body);
+                const FF::AABB<float>& oldBox = fatBoxes.at(body);
+
+                Check(FF::Contains(fatBox, Box(view.GetBody(body).GetLocation(), view.GetBodyRadius(body))), "World", step,
+                      "fat box doesn't contain body");
+
+                if (!FF::Contains(fatBox, oldBox) || !FF::Contains(oldBox, fatBox)) {
+                    moved.insert(body);
+                }
+                fatBoxes.at(body) = fatBox;
+            }
+
+            PairSet pairs, expected, oldKept, kept;
+            for (const FF::CollisionPair& pair : world.GetContactPairs()) {
+                pairs.insert(Pair(pair.m_First, pair.m_Second));
+                if (!moved.count(pair.m_First) && !moved.count(pair.m_Second)) {
+                    kept.insert(Pair(pair.m_First, pair.m_Second));
+                }
+            }
+            for (const FF::CollisionPair& pair : oldPairs) {
+                if (fatBoxes.count(pair.m_First) && fatBoxes.count(pair.m_Second) && !moved.count(pair.m_First) && !moved.count(pair.m_Second)) {
+                    oldKept.insert(Pair(pair.m_First, pair.m_Second));
+                }
+            }
+
+            for (std::size_t i = 0x0; i < bodies.size(); i++) {
+                for (std::size_t j = i + 0x1; j < bodies.size(); j++) {
+                    const World::BodyHandle first  = FF::min(bodies[i], bodies[j]);
+                    const World::BodyHandle second = FF::max(bodies[i], bodies[j]);
+
+                    if ((view.GetBody(first).isStatic() && view.GetBody(second).isStatic()) ||
+                            !collision.AABBIntersectAABB(fatBoxes.at(first), fatBoxes.at(second))) {
+                        continue;
+                    }
+
+                    expected.insert(Pair(first, second));
+                }
+            }
+
+            Check(pairs == expected, "WorldPairs", step, "contact pairs differ from overlaps of fat boxes");
+            Check(kept == oldKept, "WorldPairs", step, "pairs of bodies that didn't move are changed");
+
+            // The closest body hit by ray and bodies overlapped by sphere
+            const FF::Vector3<float> origin(coordinate(generator), coordinate(generator), coordinate(generator));
+            const FF::Vector3<float> direction = FF::Vector3<float>(unit(generator), unit(generator), unit(generator)).Normalize();
+            const float              maxDistance = 10.0f;
+
+            World::RayCastHit hit{ 0x0, 0.0f };
+            const bool        isHit = world.RayCast(origin, direction, maxDistance, hit);
+
+            bool  isExpectedHit   = false;
+            float closestDistance = maxDistance;
+            for (const World::BodyHandle body : bodies) {
+                float distance;
+                if (collision.RayIntersectBSphere(origin, direction, FF::BoundedSphere<float>(view.GetBody(body).GetLocation(), view.GetBodyRadius(body)), distance) &&
+                        distance <= closestDistance) {
+                    closestDistance = distance;
+                    isExpectedHit   = true;
+                }
+            }
+
+            Check(isHit == isExpectedHit && (!isHit || hit.m_Distance == closestDistance), "WorldRayCast", step, "hit differs from brute force");
+
+            const FF::BoundedSphere<float> sphere(origin, 1.5f);
+
+            std::set<World::BodyHandle> found, expectedBodies;
+            world.QuerySphere(sphere, [&found](World::BodyHandle body) {
+                found.insert(body);
+                return true;
+            });
+            for (const World::BodyHandle body : bodies) {
+                if (collision.BSphereIntersectBSphere(FF::BoundedSphere<float>(view.GetBody(body).GetLocation(), view.GetBodyRadius(body)), sphere)) {
+                    expectedBodies.insert(body);
+                }
+            }
+            Check(found == expectedBodies, "WorldQuery", step, "bodies differ from brute force");
+        }
+
+        std::printf("World    %zu steps, %zu bodies, %zu pairs\n", WORLD_STEP_COUNT, bodies.size(), world.GetContactPairs().size());
+    }
+};
+
+int main(void){
+    TestTree();
+    TestWorld();
+
+    if (g_FailureCount != 0x0) {
+        std::printf("%zu failures\n", g_FailureCount);
+        return 0x1;
+    }
+
+    std::printf("DynamicAABBTree and PhysicsWorld match brute force\n");
+    return 0x0;
+}
@@ -0,0 +1,260 @@
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../src/Core/FF_AlignedAllocator.hxx"
+#include "../src/Core/FF_TransformBatch.hxx"
+#include "../src/Core/FF_VectorBatch.hxx"
+#include "../src/Physics/FF_SpringBatch.hxx"
+
+#if !defined(__FF_SIMD_AVX2) && !defined(__FF_SIMD_SSE2)
+    #error "FF_BatchTest compares SIMD kernels with scalar ones, compile it with SSE2 or AVX2"
+#endif
+
+/**
+ * @brief [Test of SIMD batch kernels]
+ * @details [SimdVectorBatch, SimdSpringBatch and SimdTransformBatch run on random input and their results are
+ *           compared bit to bit with the scalar kernels. Counts are not multiples of WIDTH, so the scalar tail
+ *           is covered, input has zero vectors and zero-length springs of one particle and of two particles at
+ *           one location, matrices are followed by guard elements that must stay untouched. Built once with AVX2
+ *           and once with SSE2, the AVX2 build is skipped on CPU without it]
+ */
+namespace {
+    constexpr int         SKIP_CODE   = 77;
+    constexpr std::size_t MAX_COUNT   = 1003;
+    constexpr unsigned    SEED        = 0x1234u;
+
+    template<typename T>
+    using Array = FF::AlignedVector<T>;
+
+    template<typename T>
+    struct Vectors {
+        Array<T> m_X;
+        Array<T> m_Y;
+        Array<T> m_Z;
+
+        explicit Vectors(std::size_t count, T value = static_cast<T>(0x0))
+        : m_X(count, value), m_Y(count, value), m_Z(count, value) {}
+    };
+
+    std::size_t g_FailureCount = 0x0;
+
+    template<typename T>
+    void Compare(const char* kernel, const char* type, std::size_t count, const Array<T>& simd, const Array<T>& scalar){
+        for (std::size_t i = 0x0; i < simd.size(); i++) {
+            if (std::memcmp(&simd[i], &scalar[i], sizeof(T)) != 0x0) {
+                std::printf("FAIL %s<%s> count %zu: element %zu is %.17g, scalar is %.17g\n", kernel, type, count, i,
+                            static_cast<double>(simd[i]), static_cast<double>(scalar[i]));
+                g_FailureCount++;
+                return;
+            }
+        }
+    }
+
+    template<typename T>
+    void Compare(const char* kernel, const char* type, std::size_t count, const Vectors<T>& simd, const Vectors<T>& scalar){
+        Compare(kernel, type, count, simd.m_X, scalar.m_X);
+        Compare(kernel, type, count, simd.m_Y, scalar.m_Y);
+        Compare(kernel, type, count, simd.m_Z, scalar.m_Z);
+    }
+
+    template<typename T>
+    void TestVectors(const char* type, std::size_t count, std::mt19937& generator){
+        std::uniform_real_distribution<T> component(static_cast<T>(-10.0f), static_cast<T>(10.0f));
+
+        Vectors<T> a(count), b(count);
+        Array<T>   scale(count);
+        for (std::size_t i = 0x0; i < count; i++) {
+            a.m_X[i] = component(generator); a.m_Y[i] = component(generator); a.m_Z[i] = component(generator);
+            b.m_X[i] = component(generator); b.m_Y[i] = component(generator); b.m_Z[i] = component(generator);
+            scale[i] = component(generator);
+        }
+
+        // Zero vectors, Normalize() must return zero vector instead of NaN
+        for (std::size_t i = 0x0; i < count; i += 0x7) {
+            a.m_X[i] = a.m_Y[i] = a.m_Z[i] = static_cast<T>(0x0);
+        }
+
+        Vectors<T> simd(count, static_cast<T>(0x1)), scalar(count, static_cast<T>(0x1));
+        Array<T>   simdScalar(count), scalarScalar(count);
+
+        FF::SimdVectorBatch<T>::Subtract(a.m_X.data(), a.m_Y.data(), a.m_Z.data(), b.m_X.data(), b.m_Y.data(), b.m_Z.data(),
+                                         simd.m_X.data(), simd.m_Y.data(), simd.m_Z.data(), count);
+        FF::ScalarVectorBatch<T>::Subtract(a.m_X.data(), a.m_Y.data(), a.m_Z.data(), b.m_X.data(), b.m_Y.data(), b.m_Z.data(),
+                                           scalar.m_X.data(), scalar.m_Y.data(), scalar.m_Z.data(), count);
+        Compare("Subtract", type, count, simd, scalar);
+
+        FF::SimdVectorBatch<T>::DotProduct(a.m_X.data(), a.m_Y.data(), a.m_Z.data(), b.m_X.data(), b.m_Y.data(), b.m_Z.data(),
+                                           simdScalar.data(), count);
+        FF::ScalarVectorBatch<T>::DotProduct(a.m_X.data(), a.m_Y.data(), a.m_Z.data(), b.m_X.data(), b.m_Y.data(), b.m_Z.data(),
+                                             scalarScalar.data(), count);
+        Compare("DotProduct", type, count, simdScalar, scalarScalar);
+
+        FF::SimdVectorBatch<T>::Magnitude(a.m_X.data(), a.m_Y.data(), a.m_Z.data(), simdScalar.data(), count);
+        FF::ScalarVectorBatch<T>::Magnitude(a.m_X.data(), a.m_Y.data(), a.m_Z.data(), scalarScalar.data(), count);
+        Compare("Magnitude", type, count, simdScalar, scalarScalar);
+
+        FF::SimdVectorBatch<T>::Normalize(a.m_X.data(), a.m_Y.data(), a.m_Z.data(), simd.m_X.data(), simd.m_Y.data(), simd.m_Z.data(), count);
+        FF::ScalarVectorBatch<T>::Normalize(a.m_X.data(), a.m_Y.data(), a.m_Z.data(), scalar.m_X.data(), scalar.m_Y.data(), scalar.m_Z.data(), count);
+        Compare("Normalize", type, count, simd, scalar);
+
+        // Accumulates into result of Normalize(), which is equal in both
+        FF::SimdVectorBatch<T>::ScaleAccumulate(scale.data(), b.m_X.data(), b.m_Y.data(), b.m_Z.data(),
+                                                simd.m_X.data(), simd.m_Y.data(), simd.m_Z.data(), count);
+        FF::ScalarVectorBatch<T>::ScaleAccumulate(scale.data(), b.m_X.data(), b.m_Y.data(), b.m_Z.data(),
+                                                  scalar.m_X.data(), scalar.m_Y.data(), scalar.m_Z.data(), count);
+        Compare("ScaleAccumulate", type, count, simd, scalar);
+    }
+
+    template<typename T>
+    void TestSprings(const char* type, std::size_t count, std::mt19937& generator){
+        std::uniform_real_distribution<T> component(static_cast<T>(-2.0f), static_cast<T>(2.0f));
+        std::uniform_real_distribution<T> positive(static_cast<T>(0.1f), static_cast<T>(100.0f));
+
+        const std::size_t particleCount = count + 0x2;
+        std::uniform_int_distribution<std::uint32_t> particle(0x0, static_cast<std::uint32_t>(particleCount - 0x1));
+
+        Vectors<T> location(particleCount), velocity(particleCount);
+        for (std::size_t i = 0x0; i < particleCount; i++) {
+            location.m_X[i] = component(generator); location.m_Y[i] = component(generator); location.m_Z[i] = component(generator);
+            velocity.m_X[i] = component(generator); velocity.m_Y[i] = component(generator); velocity.m_Z[i] = component(generator);
+        }
+
+        // The last two particles lie at one location
+        location.m_X[particleCount - 0x1] = location.m_X[particleCount - 0x2];
+        location.m_Y[particleCount - 0x1] = location.m_Y[particleCount - 0x2];
+        location.m_Z[particleCount - 0x1] = location.m_Z[particleCount - 0x2];
+
+        std::vector<std::uint32_t> first(count), second(count);
+        Array<T>                   restLength(count), stiffness(count), dampening(count);
+        for (std::size_t s = 0x0; s < count; s++) {
+            first[s]      = particle(generator);
+            second[s]     = particle(generator);
+            restLength[s] = positive(generator) * static_cast<T>(0.01f);
+            stiffness[s]  = positive(generator);
+            dampening[s]  = positive(generator) * static_cast<T>(0.01f);
+        }
+
+        // Zero-length springs: both ends at one particle and ends at two particles with equal location
+        for (std::size_t s = 0x0; s < count; s += 0x5) {
+            second[s] = first[s];
+        }
+        for (std::size_t s = 0x3; s < count; s += 0xB) {
+            first[s]  = static_cast<std::uint32_t>(particleCount - 0x2);
+            second[s] = static_cast<std::uint32_t>(particleCount - 0x1);
+        }
+
+        Vectors<T> simd(count, static_cast<T>(0x1)), scalar(count, static_cast<T>(0x1));
+
+        FF::SimdSpringBatch<T>::CalculateForces( location.m_X.data(), location.m_Y.data(), location.m_Z.data(),
+                                                 velocity.m_X.data(), velocity.m_Y.data(), velocity.m_Z.data(),
+                                                 first.data(), second.data(), restLength.data(), stiffness.data(), dampening.data(),
+                                                 simd.m_X.data(), simd.m_Y.data(), simd.m_Z.data(), count );
+        FF::ScalarSpringBatch<T>::CalculateForces( location.m_X.data(), location.m_Y.data(), location.m_Z.data(),
+                                                   velocity.m_X.data(), velocity.m_Y.data(), velocity.m_Z.data(),
+                                                   first.data(), second.data(), restLength.data(), stiffness.data(), dampening.data(),
+                                                   scalar.m_X.data(), scalar.m_Y.data(), scalar.m_Z.data(), count );
+        Compare("SpringBatch", type, count, simd, scalar);
+    }
+
+    template<typename T>
+    void TestTransforms(const char* type, std::size_t count, std::mt19937& generator){
+        constexpr std::size_t GUARD_COUNT = FF::SimdLane<T>::WIDTH;
+
+        std::uniform_real_distribution<T> component(static_cast<T>(-1.0f), static_cast<T>(1.0f));
+        std::uniform_real_distribution<T> coordinate(static_cast<T>(-100.0f), static_cast<T>(100.0f));
+
+        Vectors<T> quaternion(count), location(count);
+        Array<T>   w(count);
+        for (std::size_t i = 0x0; i < count; i++) {
+            quaternion.m_X[i] = component(generator); quaternion.m_Y[i] = component(generator); quaternion.m_Z[i] = component(generator);
+            w[i]              = component(generator);
+            location.m_X[i]   = coordinate(generator); location.m_Y[i] = coordinate(generator); location.m_Z[i] = coordinate(generator);
+        }
+
+        // Matrices are written by Transpose() blocks, 3x4 float matrices of AVX2 end by StoreHalf()
+        Array<T> simdMatrices(count * 0x10 + GUARD_COUNT, static_cast<T>(0x1)), scalarMatrices(count * 0x10 + GUARD_COUNT, static_cast<T>(0x1));
+
+        FF::SimdTransformBatch<T>::BuildMatrices4x4(quaternion.m_X.data(), quaternion.m_Y.data(), quaternion.m_Z.data(), w.data(),
+                                                    location.m_X.data(), location.m_Y.data(), location.m_Z.data(), simdMatrices.data(), count);
+        FF::ScalarTransformBatch<T>::BuildMatrices4x4(quaternion.m_X.data(), quaternion.m_Y.data(), quaternion.m_Z.data(), w.data(),
+                                                      location.m_X.data(), location.m_Y.data(), location.m_Z.data(), scalarMatrices.data(), count);
+        Compare("BuildMatrices4x4", type, count, simdMatrices, scalarMatrices);
+
+        simdMatrices.assign(count * 0xC + GUARD_COUNT, static_cast<T>(0x1));
+        scalarMatrices.assign(count * 0xC + GUARD_COUNT, static_cast<T>(0x1));
+
+        FF::SimdTransformBatch<T>::BuildMatrices3x4(quaternion.m_X.data(), quaternion.m_Y.data(), quaternion.m_Z.data(), w.data(),
+                                                    location.m_X.data(), location.m_Y.data(), location.m_Z.data(), simdMatrices.data(), count);
+        FF::ScalarTransformBatch<T>::BuildMatrices3x4(quaternion.m_X.data(), quaternion.m_Y.data(), quaternion.m_Z.data(), w.data(),
+                                                      location.m_X.data(), location.m_Y.data(), location.m_Z.data(), scalarMatrices.data(), count);
+        Compare("BuildMatrices3x4", type, count, simdMatrices, scalarMatrices);
+
+        T matrix[0x10];
+        for (T& element : matrix) {
+            element = component(generator);
+        }
+
+        Vectors<T> simd(count, static_cast<T>(0x1)), scalar(count, static_cast<T>(0x1));
+        Array<T>   simdW(count, static_cast<T>(0x1)), scalarW(count, static_cast<T>(0x1));
+
+        FF::SimdTransformBatch<T>::TransformPoints(matrix, location.m_X.data(), location.m_Y.data(), location.m_Z.data(),
+                                                   simd.m_X.data(), simd.m_Y.data(), simd.m_Z.data(), count);
+        FF::ScalarTransformBatch<T>::TransformPoints(matrix, location.m_X.data(), location.m_Y.data(), location.m_Z.data(),
+                                                     scalar.m_X.data(), scalar.m_Y.data(), scalar.m_Z.data(), count);
+        Compare("TransformPoints", type, count, simd, scalar);
+
+        FF::SimdTransformBatch<T>::TransformVectors(matrix, location.m_X.data(), location.m_Y.data(), location.m_Z.data(), w.data(),
+                                                    simd.m_X.data(), simd.m_Y.data(), simd.m_Z.data(), simdW.data(), count);
+        FF::ScalarTransformBatch<T>::TransformVectors(matrix, location.m_X.data(), location.m_Y.data(), location.m_Z.data(), w.data(),
+                                                      scalar.m_X.data(), scalar.m_Y.data(), scalar.m_Z.data(), scalarW.data(), count);
+        Compare("TransformVectors", type, count, simd, scalar);
+        Compare("TransformVectors", type, count, simdW, scalarW);
+    }
+
+    template<typename T>
+    void Test(const char* type){
+        constexpr std::size_t WIDTH = FF::SimdLane<T>::WIDTH;
+
+        // Empty, shorter than one register, one register, one register and tail, several registers and tail
+        const std::size_t counts[] = { 0x0, 0x1, WIDTH - 0x1, WIDTH, WIDTH + 0x1, 0x3 * WIDTH + 0x2, MAX_COUNT };
+
+        std::mt19937 generator(SEED);
+        for (std::size_t count : counts) {
+            TestVectors<T>(type, count, generator);
+            TestSprings<T>(type, count, generator);
+            TestTransforms<T>(type, count, generator);
+        }
+
+        std::printf("%-8s WIDTH %zu, counts up to %zu\n", type, WIDTH, MAX_COUNT);
+    }
+};
+
+int main(void){
+#if defined(__FF_SIMD_AVX2)
+    const char* instructionSet = "AVX2";
+
+    #if defined(__GNUC__) || defined(__clang__)
+        if (!__builtin_cpu_supports("avx2")) {
+            std::printf("CPU doesn't support AVX2, test is skipped\n");
+            return SKIP_CODE;
+        }
+    #endif
+#else
+    const char* instructionSet = "SSE2";
+#endif
+
+    std::printf("%s kernels\n", instructionSet);
+
+    Test<float>("float");
+    Test<double>("double");
+
+    if (g_FailureCount != 0x0) {
+        std::printf("%zu mismatches\n", g_FailureCount);
+        return 0x1;
+    }
+
+    std::printf("SIMD and scalar kernels match\n");
+    return 0x0;
+}
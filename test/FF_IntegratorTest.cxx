@@ -0,0 +1,194 @@
+#include <cmath>
+#include <cstdio>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Physics/FF_Cloth.hxx"
+#include "../src/Physics/FF_Integrators.hxx"
+
+/**
+ * @brief [Test of integrators]
+ * @details [Point interface of SymplecticEuler, PositionVerlet and RungeKutta4 is compared with analytic free fall
+ *           and analytic undamped spring, the error of the spring must fall with halved step by the order of the
+ *           method. Cloth stiff enough to blow SymplecticEuler up must stay bounded with BackwardEuler, and
+ *           conjugate gradient of BackwardEuler must converge on a small cloth before its iteration limit]
+ */
+namespace {
+    constexpr double GRAVITY        = -9.81;
+    constexpr double FREQUENCY      = 2.0;                  // Angular frequency of spring, acceleration is -FREQUENCY^2 * x
+    constexpr double DURATION       = 1.0;
+    constexpr double ORDER_EPSILON  = 0.2;
+
+    std::size_t g_FailureCount = 0x0;
+
+    void Check(bool condition, const char* scenario, const char* message){
+        if (!condition) {
+            std::printf("FAIL %s: %s\n", scenario, message);
+            g_FailureCount++;
+        }
+    }
+
+    bool isFinite(const FF::Vector3<double>& vec){
+        return std::isfinite(vec.GetXComponent()) && std::isfinite(vec.GetYComponent()) && std::isfinite(vec.GetZComponent());
+    }
+
+    // Location after DURATION of free fall from origin with initial velocity (1, 2, 0)
+    template<typename Integrator>
+    FF::Vector3<double> FreeFall(std::size_t stepCount){
+        const double changeInTime = DURATION / static_cast<double>(stepCount);
+
+        FF::Vector3<double> location(0.0, 0.0, 0.0);
+        FF::Vector3<double> velocity(1.0, 2.0, 0.0);
+        for (std::size_t step = 0x0; step < stepCount; step++) {
+            Integrator::Integrate(location, velocity, [](const FF::Vector3<double>&, const FF::Vector3<double>&) {
+                return FF::Vector3<double>(0.0, GRAVITY, 0.0);
+            }, changeInTime);
+        }
+
+        return location;
+    }
+
+    // Error of location after DURATION of spring released from x = 1, analytic location is cos(FREQUENCY * t)
+    template<typename Integrator>
+    double SpringError(std::size_t stepCount){
+        const double changeInTime = DURATION / static_cast<double>(stepCount);
+
+        FF::Vector3<double> location(1.0, 0.0, 0.0);
+        FF::Vector3<double> velocity(0.0, 0.0, 0.0);
+        for (std::size_t step = 0x0; step < stepCount; step++) {
+            Integrator::Integrate(location, velocity, [](const FF::Vector3<double>& x, const FF::Vector3<double>&) {
+                return x * (-FREQUENCY * FREQUENCY);
+            }, changeInTime);
+        }
+
+        return std::fabs(location.GetXComponent() - std::cos(FREQUENCY * DURATION));
+    }
+
+    template<typename Integrator>
+    void TestPoint(const char* scenario, double order){
+        constexpr std::size_t STEP_COUNT = 0x40;
+
+        // Verlet and Runge-Kutta are exact for constant acceleration, semi-implicit Euler is late by g * dt * t / 2
+        const double changeInTime = DURATION / static_cast<double>(STEP_COUNT);
+        const double exactY       = 2.0 * DURATION + 0.5 * GRAVITY * DURATION * DURATION;
+        const double expectedY    = (order == 1.0) ? (exactY + 0.5 * GRAVITY * changeInTime * DURATION) : exactY;
+
+        const FF::Vector3<double> location = FreeFall<Integrator>(STEP_COUNT);
+        Check(std::fabs(location.GetXComponent() - DURATION) < 1E-12, scenario, "free fall moves wrong with constant velocity");
+        Check(std::fabs(location.GetYComponent() - expectedY) < 1E-12, scenario, "free fall differs from analytic solution");
+        Check(location.GetZComponent() == 0.0, scenario, "free fall leaves its plane");
+
+        const double coarse = SpringError<Integrator>(STEP_COUNT);
+        const double fine   = SpringError<Integrator>(STEP_COUNT * 0x2);
+        Check(coarse < 0.1, scenario, "spring differs from analytic solution");
+
+        const double observed = std::log2(coarse / fine);
+        if (std::fabs(observed - order) > ORDER_EPSILON) {
+            std::printf("FAIL %s: spring converges with order %f, expected %f\n", scenario, observed, order);
+            g_FailureCount++;
+        }
+    }
+
+    // Hanging cloth pinned at two corners, soft spring steps are small enough for any integrator
+    template<typename Integrator>
+    struct HangingCloth {
+        static constexpr std::size_t SIDE = 0x8;
+
+        FF::Cloth<double, Integrator> m_Cloth;
+
+        explicit HangingCloth(double stiffness)
+        : m_Cloth(SIDE, SIDE, 0.1, 0.02, 0.2, 0.1, stiffness, 0.0, 0.0, FF::Vector3<double>(0.0, 0.0, 0.0)) {
+            this->m_Cloth.SetParticleStaticFlag(0x0, 0x0, true);
+            this->m_Cloth.SetParticleStaticFlag(0x0, SIDE - 0x1, true);
+            for (std::size_t row = 0x0; row < SIDE; row++) {
+                for (std::size_t column = 0x0; column < SIDE; column++) {
+                    this->m_Cloth.SetParticleConstantForce(row, column, FF::Vector3<double>(0.0, 0.1 * GRAVITY, 0.0));
+                }
+            }
+        }
+
+        // Largest distance of particle from its initial location, infinite if any particle is not finite
+        double GetLargestDisplacement(void) const {
+            double largest = 0.0;
+            for (std::size_t row = 0x0; row < SIDE; row++) {
+                for (std::size_t column = 0x0; column < SIDE; column++) {
+                    const FF::Vector3<double> location = this->m_Cloth.GetParticleLocation(row, column);
+                    if (!isFinite(location)) {
+                        return INFINITY;
+                    }
+
+                    const FF::Vector3<double> displacement = location - FF::Vector3<double>(static_cast<double>(column) * 0.1,
+                                                                                            -static_cast<double>(row) * 0.1, 0.0);
+                    largest = std::fmax(largest, displacement.Magnitude());
+                }
+            }
+
+            return largest;
+        }
+    };
+
+    void TestStiffCloth(void){
+        constexpr double      STIFFNESS  = 1E5;
+        constexpr double      TIME_STEP  = 0.01;
+        constexpr std::size_t STEP_COUNT = 0x64;
+
+        // Spring frequency sqrt(k / m) is 1000, step far beyond 2 / 1000 where explicit step is stable
+        HangingCloth<FF::SymplecticEuler<double>> explicitCloth(STIFFNESS);
+        HangingCloth<FF::BackwardEuler<double>>   implicitCloth(STIFFNESS);
+        for (std::size_t step = 0x0; step < STEP_COUNT; step++) {
+            explicitCloth.m_Cloth.Update(TIME_STEP);
+            implicitCloth.m_Cloth.Update(TIME_STEP);
+        }
+
+        Check(!(explicitCloth.GetLargestDisplacement() < 1.0), "StiffCloth", "symplectic Euler stays stable, step is too small for the test");
+        Check(implicitCloth.GetLargestDisplacement() < 0.1, "StiffCloth", "backward Euler blows up on stiff cloth");
+    }
+
+    void TestConjugateGradient(void){
+        constexpr double      STIFFNESS  = 1E3;
+        constexpr double      TIME_STEP  = 0.01;
+        constexpr std::size_t STEP_COUNT = 0x20;
+
+        HangingCloth<FF::BackwardEuler<double>> cloth(STIFFNESS);
+        HangingCloth<FF::BackwardEuler<double>> exact(STIFFNESS);
+        exact.m_Cloth.GetIntegrator().SetMaxIterations(0x400);
+        exact.m_Cloth.GetIntegrator().SetTolerance(1E-12);
+
+        bool   isConverged = true;
+        bool   isIterated  = true;
+        double difference  = 0.0;
+        for (std::size_t step = 0x0; step < STEP_COUNT; step++) {
+            cloth.m_Cloth.Update(TIME_STEP);
+            exact.m_Cloth.Update(TIME_STEP);
+
+            const FF::BackwardEuler<double>& integrator = cloth.m_Cloth.GetIntegrator();
+            isConverged = isConverged && integrator.GetLastIterationCount() < integrator.GetMaxIterations();
+            isConverged = isConverged && exact.m_Cloth.GetIntegrator().GetLastIterationCount() < exact.m_Cloth.GetIntegrator().GetMaxIterations();
+            isIterated  = isIterated && integrator.GetLastIterationCount() > 0x0;
+
+            const FF::Vector3<double> offset = cloth.m_Cloth.GetParticleLocation(HangingCloth<FF::BackwardEuler<double>>::SIDE - 0x1, 0x4) -
+                                               exact.m_Cloth.GetParticleLocation(HangingCloth<FF::BackwardEuler<double>>::SIDE - 0x1, 0x4);
+            difference = std::fmax(difference, offset.Magnitude());
+        }
+
+        Check(isConverged, "ConjugateGradient", "conjugate gradient reaches its iteration limit");
+        Check(isIterated, "ConjugateGradient", "conjugate gradient stops before the first iteration");
+        Check(difference < 1E-4, "ConjugateGradient", "solution of default tolerance is far from the exact one");
+        Check(exact.GetLargestDisplacement() > 0.01, "ConjugateGradient", "hanging cloth doesn't move");
+    }
+};
+
+int main(void){
+    TestPoint<FF::SymplecticEuler<double>>("SymplecticEuler", 1.0);
+    TestPoint<FF::PositionVerlet<double>>("PositionVerlet", 2.0);
+    TestPoint<FF::RungeKutta4<double>>("RungeKutta4", 4.0);
+    TestStiffCloth();
+    TestConjugateGradient();
+
+    if (g_FailureCount != 0x0) {
+        std::printf("%zu failures\n", g_FailureCount);
+        return 0x1;
+    }
+
+    std::printf("Integrators match analytic solutions and converge\n");
+    return 0x0;
+}
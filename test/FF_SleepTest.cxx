@@ -0,0 +1,196 @@
+#include <cstdio>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Physics/FF_Cloth.hxx"
+#include "../src/Physics/FF_PhysicsWorld.hxx"
+
+/**
+ * @brief [Test of sleeping islands of rigid bodies and sleeping tiles of cloth]
+ * @details [Island of two resting touching bodies must fall asleep exactly after sleep step count of steps,
+ *           and wake as a whole when an awake body reaches it, when one of its bodies is moved by
+ *           SetBodyLocation() or when the static body it rests on is destroyed. Cloth at rest must fall asleep
+ *           tile by tile, must not move while asleep, and a sleeping tile must wake when a particle joined
+ *           to it by spring is pushed in the neighbour tile]
+ */
+namespace {
+    constexpr std::size_t SLEEP_STEP_COUNT = 0xA;
+    constexpr float       SLEEP_VELOCITY   = 0.01f;
+    constexpr float       TIME_STEP        = 0.01f;
+
+    using World = FF::PhysicsWorld<float>;
+
+    std::size_t g_FailureCount = 0x0;
+
+    void Check(bool condition, const char* scenario, const char* message){
+        if (!condition) {
+            std::printf("FAIL %s: %s\n", scenario, message);
+            g_FailureCount++;
+        }
+    }
+
+    bool isSame(const FF::Vector3<float>& first, const FF::Vector3<float>& second){
+        return first.GetXComponent() == second.GetXComponent() && first.GetYComponent() == second.GetYComponent() &&
+               first.GetZComponent() == second.GetZComponent();
+    }
+
+    void Step(World& world, std::size_t stepCount){
+        for (std::size_t step = 0x0; step < stepCount; step++) {
+            world.Step(TIME_STEP);
+        }
+    }
+
+    // Two touching bodies at rest above a static floor, their spheres touch the floor too
+    struct Island {
+        World             m_World;
+        World::BodyHandle m_Floor;
+        World::BodyHandle m_First;
+        World::BodyHandle m_Second;
+
+        Island(void)
+        : m_World(0.1f),
+          m_Floor(m_World.CreateBody(1.0f, FF::Vector3<float>(0.0f, 0.0f, 0.0f), 1.0f, true)),
+          m_First(m_World.CreateBody(1.0f, FF::Vector3<float>(-0.4f, 1.4f, 0.0f), 0.5f)),
+          m_Second(m_World.CreateBody(1.0f, FF::Vector3<float>(0.4f, 1.4f, 0.0f), 0.5f)) {
+            this->m_World.SetSleepVelocity(SLEEP_VELOCITY);
+            this->m_World.SetSleepStepCount(SLEEP_STEP_COUNT);
+        }
+
+        bool isAwake(void) const {
+            return this->m_World.isBodyAwake(this->m_First) && this->m_World.isBodyAwake(this->m_Second);
+        }
+
+        bool isAsleep(void) const {
+            return !this->m_World.isBodyAwake(this->m_First) && !this->m_World.isBodyAwake(this->m_Second);
+        }
+
+        void FallAsleep(void){
+            Step(this->m_World, SLEEP_STEP_COUNT);
+        }
+    };
+
+    void TestFallAsleep(void){
+        Island island;
+
+        Step(island.m_World, SLEEP_STEP_COUNT - 0x1);
+        Check(island.isAwake(), "FallAsleep", "island sleeps before the timeout");
+
+        Step(island.m_World, 0x1);
+        Check(island.isAsleep(), "FallAsleep", "island is awake after the timeout");
+        Check(island.m_World.GetAwakeBodyCount() == 0x0, "FallAsleep", "sleeping bodies are still updated");
+
+        const FF::Vector3<float> location = island.m_World.GetBody(island.m_First).GetLocation();
+        Step(island.m_World, 0x10);
+        Check(island.isAsleep(), "FallAsleep", "island wakes up without reason");
+        Check(isSame(island.m_World.GetBody(island.m_First).GetLocation(), location), "FallAsleep", "sleeping body moves");
+
+        // Island that touches moving body can't sleep
+        Island blocked;
+        const World::BodyHandle moving = blocked.m_World.CreateBody(1.0f, FF::Vector3<float>(1.2f, 1.4f, 0.0f), 0.5f);
+        blocked.m_World.GetBody(moving).SetLinearVelocity(FF::Vector3<float>(0.0f, 0.0f, 1.0f));
+
+        Step(blocked.m_World, SLEEP_STEP_COUNT);
+        Check(blocked.isAwake(), "FallAsleep", "island that touches moving body sleeps");
+    }
+
+    void TestWakeByContact(void){
+        Island island;
+        island.FallAsleep();
+
+        // Body flies at the island from the side and reaches it in about 0.5 second
+        const World::BodyHandle ball = island.m_World.CreateBody(1.0f, FF::Vector3<float>(4.0f, 1.4f, 0.0f), 0.5f);
+        island.m_World.GetBody(ball).SetLinearVelocity(FF::Vector3<float>(-5.0f, 0.0f, 0.0f));
+
+        Step(island.m_World, 0x1E);
+        Check(island.isAsleep(), "WakeByContact", "island wakes before the contact");
+
+        Step(island.m_World, 0x28);
+        Check(island.isAwake(), "WakeByContact", "island isn't woken by awake body");
+    }
+
+    void TestWakeBySetBodyLocation(void){
+        Island island;
+        island.FallAsleep();
+
+        island.m_World.SetBodyLocation(island.m_Second, FF::Vector3<float>(0.45f, 1.4f, 0.0f));
+        Check(island.isAwake(), "WakeBySetBodyLocation", "island isn't woken by moving its body");
+
+        // Body put into sleeping island wakes it too
+        Island other;
+        other.FallAsleep();
+
+        const World::BodyHandle body = other.m_World.CreateBody(1.0f, FF::Vector3<float>(10.0f, 0.0f, 0.0f), 0.5f);
+        Step(other.m_World, 0x1);
+        Check(other.isAsleep(), "WakeBySetBodyLocation", "far body wakes the island");
+
+        other.m_World.SetBodyLocation(body, FF::Vector3<float>(0.0f, 2.2f, 0.0f));
+        Check(other.isAwake(), "WakeBySetBodyLocation", "island isn't woken by body put into it");
+    }
+
+    void TestWakeByStaticBody(void){
+        Island island;
+        island.FallAsleep();
+
+        island.m_World.DestroyBody(island.m_Floor);
+        Check(island.isAwake(), "WakeByStaticBody", "island isn't woken when its floor is destroyed");
+
+        Island moved;
+        moved.FallAsleep();
+
+        moved.m_World.SetBodyLocation(moved.m_Floor, FF::Vector3<float>(50.0f, 0.0f, 0.0f));
+        Check(moved.isAwake(), "WakeByStaticBody", "island isn't woken when its floor is moved away");
+    }
+
+    void TestCloth(void){
+        constexpr std::size_t SIDE = 0x2 * FF::CLOTH_CONSTANTS::FF_SLEEP_TILE_SIZE;
+        constexpr std::size_t EDGE = FF::CLOTH_CONSTANTS::FF_SLEEP_TILE_SIZE - 0x1;
+
+        FF::Cloth<float> cloth(SIDE, SIDE, 0.1f, 0.02f, 0.2f, 0.1f, 100.0f, 0.0f, 0.02f, FF::Vector3<float>(0.0f, 0.0f, 0.0f));
+        cloth.SetSleepVelocity(SLEEP_VELOCITY);
+        cloth.SetSleepStepCount(SLEEP_STEP_COUNT);
+
+        // Flat cloth without forces rests from the start
+        for (std::size_t step = 0x0; step + 0x1 < SLEEP_STEP_COUNT; step++) {
+            cloth.Update(0.001f);
+        }
+        Check(cloth.GetAwakeParticleCount() == SIDE * SIDE, "Cloth", "tile sleeps before the timeout");
+
+        cloth.Update(0.001f);
+        Check(cloth.GetAwakeParticleCount() == 0x0, "Cloth", "resting tile is awake after the timeout");
+
+        const FF::Vector3<float> location = cloth.GetParticleLocation(EDGE, EDGE + 0x1);
+        for (std::size_t step = 0x0; step < 0x10; step++) {
+            cloth.Update(0.001f);
+        }
+        Check(cloth.GetAwakeParticleCount() == 0x0, "Cloth", "sleeping tile wakes up without reason");
+        Check(isSame(cloth.GetParticleLocation(EDGE, EDGE + 0x1), location), "Cloth", "sleeping particle moves");
+
+        // Push the corner particle of the first tile, its spring neighbours lie in three other tiles
+        cloth.SetParticleImpulseForce(EDGE, EDGE, FF::Vector3<float>(5.0f, 5.0f, 50.0f));
+        Check(cloth.isParticleAwake(EDGE, EDGE), "Cloth", "tile isn't woken by impulse force");
+        Check(!cloth.isParticleAwake(EDGE, EDGE + 0x1), "Cloth", "neighbour tile is woken by impulse force");
+
+        for (std::size_t step = 0x0; step < 0x5; step++) {
+            cloth.Update(0.001f);
+        }
+        Check(cloth.isParticleAwake(EDGE, EDGE + 0x1), "Cloth", "right tile isn't woken by moving neighbour");
+        Check(cloth.isParticleAwake(EDGE + 0x1, EDGE), "Cloth", "bottom tile isn't woken by moving neighbour");
+        Check(cloth.isParticleAwake(EDGE + 0x1, EDGE + 0x1), "Cloth", "diagonal tile isn't woken by moving neighbour");
+        Check(!isSame(cloth.GetParticleLocation(EDGE, EDGE + 0x1), location), "Cloth", "woken particle doesn't move");
+    }
+};
+
+int main(void){
+    TestFallAsleep();
+    TestWakeByContact();
+    TestWakeBySetBodyLocation();
+    TestWakeByStaticBody();
+    TestCloth();
+
+    if (g_FailureCount != 0x0) {
+        std::printf("%zu failures\n", g_FailureCount);
+        return 0x1;
+    }
+
+    std::printf("Islands and tiles sleep and wake up\n");
+    return 0x0;
+}
@@ -0,0 +1,257 @@
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Physics/Collision/FF_SpatialHash.hxx"
+
+/**
+ * @brief [Test of spatial hash broad phase]
+ * @details [Pairs and sphere queries of FF::SpatialHash are compared with brute force on random spheres of
+ *           different radii, on a crumpled cloth sheet with grid neighbours skipped, and on sets with NaN,
+ *           infinite and huge coordinates. Objects with non-finite center must never be reported, objects
+ *           beyond the clamped cells must still pair with each other. One hash is reused by Clear()]
+ */
+namespace {
+    constexpr unsigned SEED = 0x1234u;
+
+    using PairSet = std::set<std::pair<std::size_t, std::size_t>>;
+
+    std::size_t g_FailureCount = 0x0;
+
+    template<typename T>
+    struct Spheres {
+        std::vector<FF::Vector3<T>> m_Location;
+        std::vector<T>              m_Radius;
+
+        void Add(T x, T y, T z, T radius){
+            this->m_Location.push_back(FF::Vector3<T>(x, y, z));
+            this->m_Radius.push_back(radius);
+        }
+    };
+
+    template<typename T>
+    bool isFinite(const FF::Vector3<T>& location){
+        return std::isfinite(location.GetXComponent()) && std::isfinite(location.GetYComponent()) && std::isfinite(location.GetZComponent());
+    }
+
+    template<typename T>
+    bool isOverlapped(const FF::Vector3<T>& first, T firstRadius, const FF::Vector3<T>& second, T secondRadius){
+        const T distanceSquared = FF::sqr(first.GetXComponent() - second.GetXComponent()) +
+                                  FF::sqr(first.GetYComponent() - second.GetYComponent()) +
+                                  FF::sqr(first.GetZComponent() - second.GetZComponent());
+
+        return (distanceSquared < FF::sqr(firstRadius + secondRadius));
+    }
+
+    void Check(bool condition, const char* scenario, const char* type, const char* message){
+        if (!condition) {
+            std::printf("FAIL %s<%s>: %s\n", scenario, type, message);
+            g_FailureCount++;
+        }
+    }
+
+    template<typename T, typename SkipPredicate>
+    void ComparePairs(const char* scenario, const char* type, FF::SpatialHash<T>& hash, const Spheres<T>& spheres, SkipPredicate skip){
+        const std::size_t count = spheres.m_Radius.size();
+
+        hash.Clear();
+        for (std::size_t i = 0x0; i < count; i++) {
+            hash.Insert(spheres.m_Location[i], spheres.m_Radius[i]);
+        }
+        hash.Build();
+
+        std::vector<FF::CollisionPair> pairs;
+        hash.QueryPairs(pairs, skip);
+
+        PairSet found;
+        bool isOrdered = true;
+        for (const FF::CollisionPair& pair : pairs) {
+            isOrdered = isOrdered && (pair.m_First < pair.m_Second);
+            found.insert(std::make_pair(pair.m_First, pair.m_Second));
+        }
+        Check(isOrdered, scenario, type, "pair is not ordered by index");
+        Check(found.size() == pairs.size(), scenario, type, "pair is reported twice");
+
+        PairSet expected;
+        for (std::size_t i = 0x0; i < count; i++) {
+            if (!isFinite(spheres.m_Location[i])) {
+                continue;
+            }
+
+            for (std::size_t j = i + 0x1; j < count; j++) {
+                if (isFinite(spheres.m_Location[j]) && !skip(i, j) &&
+                    isOverlapped(spheres.m_Location[i], spheres.m_Radius[i], spheres.m_Location[j], spheres.m_Radius[j])) {
+                    expected.insert(std::make_pair(i, j));
+                }
+            }
+        }
+
+        if (found != expected) {
+            std::printf("FAIL %s<%s>: %zu pairs, brute force finds %zu\n", scenario, type, found.size(), expected.size());
+            g_FailureCount++;
+        }
+    }
+
+    template<typename T>
+    void CompareSpheres(const char* scenario, const char* type, const FF::SpatialHash<T>& hash, const Spheres<T>& spheres,
+                        const Spheres<T>& queries){
+        for (std::size_t q = 0x0; q < queries.m_Radius.size(); q++) {
+            std::set<std::size_t> found;
+            bool isUnique = true;
+            hash.QuerySphere(queries.m_Location[q], queries.m_Radius[q], [&found, &isUnique](std::size_t index) {
+                isUnique = found.insert(index).second && isUnique;
+            });
+
+            std::set<std::size_t> expected;
+            for (std::size_t i = 0x0; i < spheres.m_Radius.size(); i++) {
+                if (isFinite(spheres.m_Location[i]) &&
+                    isOverlapped(queries.m_Location[q], queries.m_Radius[q], spheres.m_Location[i], spheres.m_Radius[i])) {
+                    expected.insert(i);
+                }
+            }
+
+            Check(isUnique, scenario, type, "object is reported twice by QuerySphere()");
+            if (found != expected) {
+                std::printf("FAIL %s<%s>: query %zu finds %zu objects, brute force finds %zu\n", scenario, type, q,
+                            found.size(), expected.size());
+                g_FailureCount++;
+            }
+        }
+    }
+
+    // Spheres of different radii in a box, half of them in dense clusters
+    template<typename T>
+    void TestRandom(const char* type, FF::SpatialHash<T>& hash, std::mt19937& generator){
+        std::uniform_real_distribution<T> coordinate(static_cast<T>(-5.0f), static_cast<T>(5.0f));
+        std::uniform_real_distribution<T> offset(static_cast<T>(-0.3f), static_cast<T>(0.3f));
+        std::uniform_real_distribution<T> radius(static_cast<T>(0.01f), static_cast<T>(0.25f));
+
+        for (std::size_t round = 0x0; round < 0x4; round++) {
+            Spheres<T> spheres;
+            for (std::size_t i = 0x0; i < 0x3E8; i++) {
+                spheres.Add(coordinate(generator), coordinate(generator), coordinate(generator), radius(generator));
+            }
+            for (std::size_t cluster = 0x0; cluster < 0x14; cluster++) {
+                const T x = coordinate(generator), y = coordinate(generator), z = coordinate(generator);
+                for (std::size_t i = 0x0; i < 0x19; i++) {
+                    spheres.Add(x + offset(generator), y + offset(generator), z + offset(generator), radius(generator));
+                }
+            }
+
+            ComparePairs("Random", type, hash, spheres, [](std::size_t, std::size_t) { return false; });
+            ComparePairs("RandomSkip", type, hash, spheres, [](std::size_t first, std::size_t second) {
+                return ((first + second) % 0x3 == 0x0);
+            });
+
+            Spheres<T> queries;
+            for (std::size_t q = 0x0; q < 0x40; q++) {
+                queries.Add(coordinate(generator), coordinate(generator), coordinate(generator), hash.GetCellSize() * static_cast<T>(0.5f));
+            }
+            CompareSpheres("RandomSphere", type, hash, spheres, queries);
+        }
+    }
+
+    // Crumpled sheet like in FF::Cloth, grid neighbours are connected by springs and skipped
+    template<typename T>
+    void TestSheet(const char* type, FF::SpatialHash<T>& hash, std::mt19937& generator){
+        constexpr std::size_t SIDE                    = 0x30;
+        constexpr T           SPACE_BETWEEN_PARTICLES = static_cast<T>(0.1f);
+        constexpr T           PARTICLE_RADIUS         = static_cast<T>(0.045f);
+
+        std::uniform_real_distribution<T> jitter(-SPACE_BETWEEN_PARTICLES, SPACE_BETWEEN_PARTICLES);
+
+        Spheres<T> spheres;
+        for (std::size_t i = 0x0; i < SIDE; i++) {
+            for (std::size_t j = 0x0; j < SIDE; j++) {
+                spheres.Add(static_cast<T>(j) * SPACE_BETWEEN_PARTICLES + jitter(generator),
+                            -static_cast<T>(i) * SPACE_BETWEEN_PARTICLES + jitter(generator),
+                            jitter(generator), PARTICLE_RADIUS);
+            }
+        }
+
+        ComparePairs("Sheet", type, hash, spheres, [](std::size_t first, std::size_t second) {
+            const std::size_t rowDifference    = (first / SIDE > second / SIDE) ? (first / SIDE - second / SIDE) : (second / SIDE - first / SIDE);
+            const std::size_t columnDifference = (first % SIDE > second % SIDE) ? (first % SIDE - second % SIDE) : (second % SIDE - first % SIDE);
+
+            return (rowDifference <= 0x1 && columnDifference <= 0x1);
+        });
+    }
+
+    // NaN and infinite centers are left out, huge ones are merged into the border cells
+    template<typename T>
+    void TestNonFinite(const char* type, FF::SpatialHash<T>& hash, std::mt19937& generator){
+        constexpr T NOT_A_NUMBER = std::numeric_limits<T>::quiet_NaN();
+        constexpr T INFINITE     = std::numeric_limits<T>::infinity();
+        constexpr T LARGEST      = std::numeric_limits<T>::max();
+        constexpr T RADIUS       = static_cast<T>(0.5f);
+
+        // Beyond 2^30 cells of size 1
+        const T huge = static_cast<T>(1e20f);
+
+        std::uniform_real_distribution<T> coordinate(static_cast<T>(-3.0f), static_cast<T>(3.0f));
+
+        Spheres<T> spheres;
+        for (std::size_t i = 0x0; i < 0xC8; i++) {
+            spheres.Add(coordinate(generator), coordinate(generator), coordinate(generator), RADIUS);
+        }
+
+        const T special[] = { NOT_A_NUMBER, INFINITE, -INFINITE, LARGEST, -LARGEST, huge, -huge };
+        for (T value : special) {
+            // Two objects at one location overlap if the location is finite
+            for (std::size_t copy = 0x0; copy < 0x2; copy++) {
+                spheres.Add(value, static_cast<T>(0x0), static_cast<T>(0x0), RADIUS);
+                spheres.Add(static_cast<T>(0x0), value, static_cast<T>(0x0), RADIUS);
+                spheres.Add(static_cast<T>(0x0), static_cast<T>(0x0), value, RADIUS);
+                spheres.Add(value, value, value, RADIUS);
+                spheres.Add(value, -value, coordinate(generator), RADIUS);
+            }
+        }
+
+        // Huge but distinct locations share the border cell and must not be reported as overlapping
+        spheres.Add(huge, static_cast<T>(0x0), static_cast<T>(0x0), RADIUS);
+        spheres.Add(huge * static_cast<T>(0x2), static_cast<T>(0x0), static_cast<T>(0x0), RADIUS);
+
+        ComparePairs("NonFinite", type, hash, spheres, [](std::size_t, std::size_t) { return false; });
+        Check(hash.GetCellSize() == static_cast<T>(0x1), "NonFinite", type, "cell size must be the largest diameter");
+
+        Spheres<T> queries;
+        for (T value : special) {
+            queries.Add(value, static_cast<T>(0x0), static_cast<T>(0x0), RADIUS);
+            queries.Add(value, value, value, RADIUS);
+        }
+        queries.Add(static_cast<T>(0x0), static_cast<T>(0x0), static_cast<T>(0x0), RADIUS);
+        CompareSpheres("NonFiniteSphere", type, hash, spheres, queries);
+    }
+
+    template<typename T>
+    void Test(const char* type){
+        std::mt19937 generator(SEED);
+
+        // Cell size grows to the largest diameter in Build()
+        FF::SpatialHash<T> hash(static_cast<T>(0.01f), 0x400);
+
+        TestRandom<T>(type, hash, generator);
+        TestSheet<T>(type, hash, generator);
+        TestNonFinite<T>(type, hash, generator);
+
+        std::printf("%-8s pairs and sphere queries match brute force\n", type);
+    }
+};
+
+int main(void){
+    Test<float>("float");
+    Test<double>("double");
+
+    if (g_FailureCount != 0x0) {
+        std::printf("%zu failures\n", g_FailureCount);
+        return 0x1;
+    }
+
+    std::printf("SpatialHash matches brute force\n");
+    return 0x0;
+}
@@ -0,0 +1,204 @@
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include "../src/Core/FF_Vector3.hxx"
+#include "../src/Physics/FF_Cloth.hxx"
+#include "../src/Physics/FF_ClothState.hxx"
+#include "../src/Physics/FF_XPBD.hxx"
+
+/**
+ * @brief [Test of XPBD cloth solver]
+ * @details [Stretched constraint between a pinned and a free particle must reach its rest length, and a pinned
+ *           chain of constraints must come closer to rest lengths with every added iteration. Static particles
+ *           of a cloth pulled by gravity and impulse forces must never move, and a cloth updated by 1, 2 and 4
+ *           threads must end bit to bit in the same state]
+ */
+namespace {
+    constexpr double      TIME_STEP   = 0.01;
+    constexpr double      REST_LENGTH = 0.1;
+    constexpr double      RIGID       = 1E12;           // Compliance 1 / (k * dt^2) is 1E-8, constraint is nearly rigid
+    constexpr std::size_t CHAIN_COUNT = 0x8;
+
+    std::size_t g_FailureCount = 0x0;
+
+    void Check(bool condition, const char* scenario, const char* message){
+        if (!condition) {
+            std::printf("FAIL %s: %s\n", scenario, message);
+            g_FailureCount++;
+        }
+    }
+
+    bool isSame(const FF::Vector3<double>& first, const FF::Vector3<double>& second){
+        return first.GetXComponent() == second.GetXComponent() && first.GetYComponent() == second.GetYComponent() &&
+               first.GetZComponent() == second.GetZComponent();
+    }
+
+    void SerialFor(std::size_t begin, std::size_t end, const std::function<void(std::size_t, std::size_t)>& function){
+        function(begin, end);
+    }
+
+    // Chain of particles along X axis stretched to twice rest length, first particle is pinned
+    struct Chain {
+        FF::ClothState<double>   m_State;
+        FF::ClothSprings<double> m_Springs;
+
+        explicit Chain(std::size_t particleCount){
+            this->m_State.Resize(particleCount);
+            for (std::size_t i = 0x0; i < particleCount; i++) {
+                this->m_State.SetLocation(i, FF::Vector3<double>(static_cast<double>(i) * 0x2 * REST_LENGTH, 0.0, 0.0));
+                this->m_State.m_InvertMass[i] = 1.0;
+            }
+            this->m_State.m_StaticMask[0x0] = 0x1;
+
+            for (std::size_t i = 0x0; i + 0x1 < particleCount; i++) {
+                this->m_Springs.AddSpring(i, i + 0x1, REST_LENGTH, RIGID, 0.0);
+            }
+            this->m_Springs.SortByColor(particleCount);
+        }
+
+        // Largest difference of spring length and rest length after one step
+        double Step(std::size_t iterationCount){
+            FF::XPBD<double> solver(iterationCount);
+            solver.Integrate(this->m_State, this->m_Springs, [](FF::ClothState<double>&) {}, SerialFor, TIME_STEP);
+
+            double largest = 0.0;
+            for (std::size_t s = 0x0; s < this->m_Springs.GetSpringCount(); s++) {
+                const double length = (this->m_State.GetLocation(this->m_Springs.m_First[s]) -
+                                       this->m_State.GetLocation(this->m_Springs.m_Second[s])).Magnitude();
+                largest = std::fmax(largest, std::fabs(length - REST_LENGTH));
+            }
+
+            return largest;
+        }
+    };
+
+    void TestPinnedPair(void){
+        // Constraint is linear along its direction, so one iteration projects the pair exactly
+        for (std::size_t iterationCount : { 0x1, 0x2, 0x8 }) {
+            Chain pair(0x2);
+            Check(pair.Step(iterationCount) < 1E-8, "PinnedPair", "stretched pair doesn't reach its rest length");
+            Check(isSame(pair.m_State.GetLocation(0x0), FF::Vector3<double>(0.0, 0.0, 0.0)), "PinnedPair", "pinned particle is moved");
+        }
+
+        // Second particle is pulled to the pin, it keeps its direction
+        Chain pair(0x2);
+        pair.Step(0x1);
+        const FF::Vector3<double> location = pair.m_State.GetLocation(0x1);
+        Check(std::fabs(location.GetXComponent() - REST_LENGTH) < 1E-8 && location.GetYComponent() == 0.0,
+              "PinnedPair", "free particle is moved off the constraint direction");
+    }
+
+    void TestPinnedChain(void){
+        double previous = INFINITY;
+        bool   isFalling = true;
+        for (std::size_t iterationCount = 0x1; iterationCount <= 0x400; iterationCount *= 0x2) {
+            Chain chain(CHAIN_COUNT);
+            const double error = chain.Step(iterationCount);
+
+            isFalling = isFalling && (error < previous);
+            previous  = error;
+        }
+
+        Check(isFalling, "PinnedChain", "error to rest length doesn't fall with iteration count");
+        Check(previous < 1E-6, "PinnedChain", "chain doesn't converge to rest lengths");
+    }
+
+    // Cloth hung at both top corners and at the center, pushed by impulse forces every few steps
+    struct PulledCloth {
+        static constexpr std::size_t SIDE = 0x10;
+
+        FF::Cloth<double, FF::XPBD<double>> m_Cloth;
+
+        explicit PulledCloth(std::size_t threadCount)
+        : m_Cloth(SIDE, SIDE, 0.1, 0.02, 0.2, REST_LENGTH, 1E4, 0.0, 0.01, FF::Vector3<double>(0.0, 0.0, 0.0)) {
+            this->m_Cloth.SetThreadCount(threadCount);
+            this->m_Cloth.SetParticleStaticFlag(0x0, 0x0, true);
+            this->m_Cloth.SetParticleStaticFlag(0x0, SIDE - 0x1, true);
+            this->m_Cloth.SetParticleStaticFlag(SIDE / 0x2, SIDE / 0x2, true);
+
+            for (std::size_t row = 0x0; row < SIDE; row++) {
+                for (std::size_t column = 0x0; column < SIDE; column++) {
+                    this->m_Cloth.SetParticleConstantForce(row, column, FF::Vector3<double>(0.0, -0.981, 0.0));
+                }
+            }
+        }
+
+        void Update(std::size_t stepCount){
+            for (std::size_t step = 0x0; step < stepCount; step++) {
+                if (step % 0x8 == 0x0) {
+                    // Static particles are pushed too and must ignore it
+                    this->m_Cloth.SetParticleImpulseForce(SIDE / 0x2, SIDE / 0x2, FF::Vector3<double>(5.0, 5.0, 5.0));
+                    this->m_Cloth.SetParticleImpulseForce(SIDE / 0x2 + 0x1, SIDE / 0x2, FF::Vector3<double>(0.0, 0.0, 50.0));
+                    this->m_Cloth.SetParticleImpulseForce(SIDE - 0x1, step % SIDE, FF::Vector3<double>(10.0, 0.0, -20.0));
+                }
+                this->m_Cloth.Update(TIME_STEP);
+            }
+        }
+    };
+
+    void TestStaticParticles(void){
+        constexpr std::size_t SIDE = PulledCloth::SIDE;
+
+        PulledCloth cloth(0x1);
+        const FF::Vector3<double> first  = cloth.m_Cloth.GetParticleLocation(0x0, 0x0);
+        const FF::Vector3<double> second = cloth.m_Cloth.GetParticleLocation(0x0, SIDE - 0x1);
+        const FF::Vector3<double> center = cloth.m_Cloth.GetParticleLocation(SIDE / 0x2, SIDE / 0x2);
+        const FF::Vector3<double> free   = cloth.m_Cloth.GetParticleLocation(SIDE - 0x1, 0x0);
+
+        bool isPinned = true;
+        for (std::size_t step = 0x0; step < 0x40; step++) {
+            cloth.Update(0x1);
+
+            isPinned = isPinned && isSame(cloth.m_Cloth.GetParticleLocation(0x0, 0x0), first);
+            isPinned = isPinned && isSame(cloth.m_Cloth.GetParticleLocation(0x0, SIDE - 0x1), second);
+            isPinned = isPinned && isSame(cloth.m_Cloth.GetParticleLocation(SIDE / 0x2, SIDE / 0x2), center);
+            isPinned = isPinned && isSame(cloth.m_Cloth.GetParticleVelocity(SIDE / 0x2, SIDE / 0x2), FF::Vector3<double>(0.0, 0.0, 0.0));
+        }
+
+        Check(isPinned, "StaticParticles", "static particle moves");
+        Check(!isSame(cloth.m_Cloth.GetParticleLocation(SIDE - 0x1, 0x0), free), "StaticParticles", "free particle doesn't move");
+    }
+
+    void TestThreadCount(void){
+        constexpr std::size_t SIDE       = PulledCloth::SIDE;
+        constexpr std::size_t STEP_COUNT = 0x40;
+
+        PulledCloth reference(0x1);
+        reference.Update(STEP_COUNT);
+
+        for (std::size_t threadCount : { 0x2, 0x4 }) {
+            PulledCloth cloth(threadCount);
+            cloth.Update(STEP_COUNT);
+
+            bool isEqual = true;
+            for (std::size_t row = 0x0; row < SIDE; row++) {
+                for (std::size_t column = 0x0; column < SIDE; column++) {
+                    isEqual = isEqual && isSame(cloth.m_Cloth.GetParticleLocation(row, column), reference.m_Cloth.GetParticleLocation(row, column));
+                    isEqual = isEqual && isSame(cloth.m_Cloth.GetParticleVelocity(row, column), reference.m_Cloth.GetParticleVelocity(row, column));
+                }
+            }
+
+            if (!isEqual) {
+                std::printf("FAIL ThreadCount: %zu threads differ from one thread\n", threadCount);
+                g_FailureCount++;
+            }
+        }
+    }
+};
+
+int main(void){
+    TestPinnedPair();
+    TestPinnedChain();
+    TestStaticParticles();
+    TestThreadCount();
+
+    if (g_FailureCount != 0x0) {
+        std::printf("%zu failures\n", g_FailureCount);
+        return 0x1;
+    }
+
+    std::printf("XPBD converges, keeps static particles and doesn't depend on thread count\n");
+    return 0x0;
+}